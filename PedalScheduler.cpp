@@ -0,0 +1,136 @@
+#include "PedalScheduler.h"
+
+PedalScheduler::PedalScheduler() {
+    task_count = 0;
+}
+
+int PedalScheduler::addTask(const char *name, sched_task_cb callback, uint32_t period_us,
+                            uint32_t budget_us, uint8_t priority) {
+    if (task_count >= SCHED_MAX_TASKS || callback == 0)
+        return -1;
+
+    sched_task_t *task = &tasks[task_count];
+    task->name = name;
+    task->callback = callback;
+    task->period_us = period_us;
+    task->budget_us = budget_us;
+    task->priority = priority;
+    task->next_due_us = micros();
+
+    task->runs = 0;
+    task->max_runtime_us = 0;
+    task->max_latency_us = 0;
+    task->overruns = 0;
+    task->missed = 0;
+
+    return task_count++;
+}
+
+void PedalScheduler::setPeriod(int task_id, uint32_t period_us) {
+    if (task_id < 0 || task_id >= task_count)
+        return;
+
+    tasks[task_id].period_us = period_us;
+}
+
+bool PedalScheduler::runNext() {
+    uint32_t now = micros();
+    sched_task_t *next = 0;
+    uint32_t next_latency = 0;
+
+    // pick the most urgent released task
+    for (uint8_t i = 0; i < task_count; i++) {
+        sched_task_t *task = &tasks[i];
+        uint32_t latency = now - task->next_due_us;
+
+        // not yet released (wrap-around safe comparison)
+        if ((int32_t) latency < 0)
+            continue;
+
+        if (next == 0 || task->priority < next->priority ||
+            (task->priority == next->priority && latency > next_latency)) {
+            next = task;
+            next_latency = latency;
+        }
+    }
+
+    if (next == 0)
+        return false;
+
+    // a task which is a full period late has lost at least one release,
+    // restart its period from now instead of running it back-to-back
+    if (next_latency >= next->period_us) {
+        next->missed += next_latency / next->period_us;
+        next->next_due_us = now + next->period_us;
+    } else {
+        next->next_due_us += next->period_us;
+    }
+
+    if (next_latency > next->max_latency_us)
+        next->max_latency_us = next_latency;
+
+    uint32_t start = micros();
+    next->callback();
+    uint32_t runtime = micros() - start;
+
+    next->runs++;
+    if (runtime > next->max_runtime_us)
+        next->max_runtime_us = runtime;
+    if (runtime > next->budget_us)
+        next->overruns++;
+
+    return true;
+}
+
+const sched_task_t* PedalScheduler::getTask(int task_id) {
+    if (task_id < 0 || task_id >= task_count)
+        return 0;
+
+    return &tasks[task_id];
+}
+
+uint32_t PedalScheduler::getOverruns() {
+    uint32_t overruns = 0;
+
+    for (uint8_t i = 0; i < task_count; i++)
+        overruns += tasks[i].overruns;
+
+    return overruns;
+}
+
+uint32_t PedalScheduler::getMissed() {
+    uint32_t missed = 0;
+
+    for (uint8_t i = 0; i < task_count; i++)
+        missed += tasks[i].missed;
+
+    return missed;
+}
+
+void PedalScheduler::resetStats() {
+    for (uint8_t i = 0; i < task_count; i++) {
+        tasks[i].runs = 0;
+        tasks[i].max_runtime_us = 0;
+        tasks[i].max_latency_us = 0;
+        tasks[i].overruns = 0;
+        tasks[i].missed = 0;
+    }
+}
+
+void PedalScheduler::printStats(Print &out) {
+    for (uint8_t i = 0; i < task_count; i++) {
+        sched_task_t *task = &tasks[i];
+
+        out.print(task->name);
+        out.print(": runs=");
+        out.print(task->runs);
+        out.print(" max_us=");
+        out.print(task->max_runtime_us);
+        out.print(" latency_us=");
+        out.print(task->max_latency_us);
+        out.print(" overruns=");
+        out.print(task->overruns);
+        out.print(" missed=");
+        out.println(task->missed);
+    }
+}
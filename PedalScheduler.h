@@ -0,0 +1,60 @@
+#ifndef PEDAL_SCHEDULER_H
+#define PEDAL_SCHEDULER_H
+
+#include <Arduino.h>
+
+// maximum number of tasks that can be registered
+#define SCHED_MAX_TASKS     8
+
+typedef void (*sched_task_cb)(void);
+
+typedef struct sched_task_t {
+    const char *name;
+    sched_task_cb callback;
+    uint32_t period_us;         // fixed release period
+    uint32_t budget_us;         // allowed run time per call, longer calls count as overrun
+    uint8_t priority;           // 0 is the most urgent
+    uint32_t next_due_us;       // next release time (micros() time base)
+
+    // statistics
+    uint32_t runs;
+    uint32_t max_runtime_us;
+    uint32_t max_latency_us;    // worst start delay after release
+    uint16_t overruns;          // calls which exceeded budget_us
+    uint16_t missed;            // releases dropped because the task was a full period late
+} sched_task_t;
+
+/*
+  Cooperative fixed-rate scheduler for the main loop.
+
+  Every call to runNext() executes at most one task: the most urgent
+  released task (lowest priority value, oldest release on a tie). Tasks
+  must return quickly, long work like display rendering has to be split
+  into slices which are executed on successive releases.
+*/
+class PedalScheduler {
+    public:
+        PedalScheduler();
+
+        // returns the task id or -1 if the task table is full
+        int addTask(const char *name, sched_task_cb callback, uint32_t period_us,
+                    uint32_t budget_us, uint8_t priority);
+        void setPeriod(int task_id, uint32_t period_us);
+
+        // run the next released task, returns false if nothing was due
+        bool runNext();
+
+        uint8_t getTaskCount() { return task_count; }
+        const sched_task_t* getTask(int task_id);
+        uint32_t getOverruns();
+        uint32_t getMissed();
+
+        void resetStats();
+        void printStats(Print &out);
+
+    private:
+        sched_task_t tasks[SCHED_MAX_TASKS];
+        uint8_t task_count;
+};
+
+#endif
@@ -0,0 +1,330 @@
+#include "PedalUI.h"
+
+// FNV-1a hash of the drawn content
+static uint32_t hash_add(uint32_t hash, const char *s) {
+    while (*s != '\0') {
+        hash ^= (uint8_t) *s++;
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+static uint32_t hash_add_byte(uint32_t hash, uint8_t b) {
+    hash ^= b;
+    return hash * 16777619UL;
+}
+
+// value with one decimal for real values, integer otherwise
+static void format_value(char *buf, float value, bool is_integer) {
+    long scale = is_integer ? 1 : 10;
+    long v = (long) (value * scale + (value < 0 ? -0.5f : 0.5f));
+    const char *sign = v < 0 ? "-" : "";
+
+    if (v < 0)
+        v = -v;
+    if (is_integer)
+        sprintf(buf, "%s%ld", sign, v);
+    else
+        sprintf(buf, "%s%ld.%ld", sign, v / 10, v % 10);
+}
+
+// copy text into buf and shorten it until it fits into width pixels
+static const char *fit_text(U8G2 &u8g2, char *buf, const char *text, u8g2_uint_t width) {
+    uint8_t len;
+
+    strncpy(buf, text, UI_TEXT_SIZE - 1);
+    buf[UI_TEXT_SIZE - 1] = '\0';
+    len = strlen(buf);
+    while (len > 0 && u8g2.getUTF8Width(buf) > width) {
+        // remove the last character including all bytes of its utf8 sequence
+        do {
+            len--;
+        } while (len > 0 && ((uint8_t) buf[len] & 0xc0) == 0x80);
+        buf[len] = '\0';
+    }
+    return buf;
+}
+
+static bool is_assigned(const cc_assignment_t *assignment) {
+    return assignment != 0 && assignment->id >= 0;
+}
+
+// label of the assignment or the text of the widget
+static const char *get_label(const ui_widget_t *widget) {
+#ifdef CC_STRING_SUPPORTED
+    if (is_assigned(widget->assignment) && widget->assignment->label.text[0] != '\0')
+        return widget->assignment->label.text;
+#endif
+    if (widget->text != 0)
+        return widget->text;
+    return "";
+}
+
+PedalUI::PedalUI() {
+    widget_count = 0;
+    screen = 0;
+    screen_count = 1;
+    font = 0;
+    dirty = true;
+    clear_pending = true;
+}
+
+int PedalUI::addWidget(uint8_t type, uint8_t screen, int actuator_id, const char *text,
+                       u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h) {
+    if (widget_count >= UI_MAX_WIDGETS || screen >= UI_MAX_SCREENS)
+        return -1;
+
+    ui_widget_t *widget = &widgets[widget_count];
+    widget->type = type;
+    widget->screen = screen;
+    widget->x = x;
+    widget->y = y;
+    widget->w = w;
+    widget->h = h;
+    widget->actuator_id = actuator_id;
+    widget->text = text;
+    widget->assignment = 0;
+    widget->dirty = true;
+    widget->drawn = false;
+    widget->drawn_key = 0;
+
+    if (screen >= screen_count)
+        screen_count = screen + 1;
+    if (screen == this->screen)
+        dirty = true;
+
+    return widget_count++;
+}
+
+int PedalUI::addLabel(uint8_t screen, int actuator_id, const char *text,
+                      u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h) {
+    return addWidget(UI_LABEL, screen, actuator_id, text, x, y, w, h);
+}
+
+int PedalUI::addValueBar(uint8_t screen, int actuator_id, const char *text,
+                         u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h) {
+    return addWidget(UI_VALUE_BAR, screen, actuator_id, text, x, y, w, h);
+}
+
+int PedalUI::addToggle(uint8_t screen, int actuator_id, const char *text,
+                       u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h) {
+    return addWidget(UI_TOGGLE, screen, actuator_id, text, x, y, w, h);
+}
+
+int PedalUI::addList(uint8_t screen, int actuator_id, const char *text,
+                     u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h) {
+    return addWidget(UI_LIST, screen, actuator_id, text, x, y, w, h);
+}
+
+void PedalUI::markDirty(int actuator_id) {
+    for (uint8_t i = 0; i < widget_count; i++) {
+        if (widgets[i].actuator_id != actuator_id)
+            continue;
+
+        widgets[i].dirty = true;
+        if (widgets[i].screen == screen)
+            dirty = true;
+    }
+}
+
+void PedalUI::assign(cc_assignment_t *assignment) {
+    for (uint8_t i = 0; i < widget_count; i++) {
+        if (widgets[i].actuator_id == assignment->actuator_id)
+            widgets[i].assignment = assignment;
+    }
+    markDirty(assignment->actuator_id);
+}
+
+void PedalUI::unassign(int actuator_id) {
+    for (uint8_t i = 0; i < widget_count; i++) {
+        if (widgets[i].actuator_id == actuator_id)
+            widgets[i].assignment = 0;
+    }
+    markDirty(actuator_id);
+}
+
+void PedalUI::update(cc_assignment_t *assignment) {
+    // the update also binds widgets which missed the assignment event
+    assign(assignment);
+}
+
+void PedalUI::setScreen(uint8_t screen) {
+    if (screen >= screen_count)
+        return;
+
+    this->screen = screen;
+    for (uint8_t i = 0; i < widget_count; i++) {
+        if (widgets[i].screen != screen)
+            continue;
+
+        widgets[i].dirty = true;
+        widgets[i].drawn = false;
+    }
+    clear_pending = true;
+    dirty = true;
+}
+
+void PedalUI::nextScreen() {
+    setScreen((screen + 1) % screen_count);
+}
+
+// text and level (bar width, toggle state or list index) of the widget, returns the hash of both
+uint32_t PedalUI::getContent(ui_widget_t *widget, char *value, u8g2_uint_t *level) {
+    cc_assignment_t *assignment = widget->assignment;
+    uint32_t hash = 2166136261UL;
+
+    value[0] = '\0';
+    *level = 0;
+
+    if (is_assigned(assignment)) {
+        switch (widget->type) {
+        case UI_VALUE_BAR: {
+            float range = assignment->max - assignment->min;
+            bool is_integer = (assignment->mode & (CC_MODE_INTEGER | CC_MODE_TOGGLE | CC_MODE_TRIGGER)) != 0;
+
+            format_value(value, assignment->value, is_integer);
+#ifdef CC_STRING_SUPPORTED
+            if (assignment->unit.text[0] != '\0') {
+                strcat(value, " ");
+                strncat(value, assignment->unit.text, UI_TEXT_SIZE - strlen(value) - 1);
+            }
+#endif
+            if (range > 0 && widget->w > 4) {
+                float fraction = (assignment->value - assignment->min) / range;
+                if (fraction < 0)
+                    fraction = 0;
+                if (fraction > 1)
+                    fraction = 1;
+                *level = (u8g2_uint_t) (fraction * (widget->w - 4) + 0.5f);
+            }
+            break;
+        }
+        case UI_TOGGLE:
+            *level = assignment->value > 0 ? 1 : 0;
+            break;
+        case UI_LIST:
+#ifdef CC_OPTIONS_LIST_SUPPORTED
+            if (assignment->list_items != 0 && assignment->list_index < assignment->list_count) {
+                strncpy(value, assignment->list_items[assignment->list_index]->label.text, UI_TEXT_SIZE - 1);
+                value[UI_TEXT_SIZE - 1] = '\0';
+            }
+            *level = assignment->list_index;
+#endif
+            break;
+        default:
+            break;
+        }
+    }
+
+    hash = hash_add(hash, get_label(widget));
+    hash = hash_add_byte(hash, 0);
+    hash = hash_add(hash, value);
+    hash = hash_add_byte(hash, 0);
+    hash = hash_add_byte(hash, *level & 0xff);
+    hash = hash_add_byte(hash, *level >> 8);
+    hash = hash_add_byte(hash, is_assigned(assignment) ? 1 : 0);
+    return hash;
+}
+
+void PedalUI::drawWidget(PedalDisplay &u8g2, ui_widget_t *widget, const char *value, u8g2_uint_t level) {
+    char buf[UI_TEXT_SIZE];
+    u8g2_uint_t x = widget->x;
+    u8g2_uint_t y = widget->y;
+    u8g2_uint_t w = widget->w;
+    u8g2_uint_t h = widget->h;
+    int8_t ascent = u8g2.getAscent();
+    int8_t descent = u8g2.getDescent();
+    u8g2_uint_t line_height = ascent - descent;
+    u8g2_uint_t tw;
+
+    switch (widget->type) {
+    case UI_LABEL:
+        // vertically centered
+        fit_text(u8g2, buf, get_label(widget), w - 2);
+        u8g2.drawUTF8(x + 1, y + (h + ascent + descent) / 2, buf);
+        break;
+
+    case UI_VALUE_BAR:
+        // label and value in the first line, bar at the bottom
+        fit_text(u8g2, buf, value, w);
+        tw = u8g2.getUTF8Width(buf);
+        u8g2.drawUTF8(x + w - tw, y + ascent, buf);
+        fit_text(u8g2, buf, get_label(widget), w - tw > 4 ? w - tw - 4 : 0);
+        u8g2.drawUTF8(x, y + ascent, buf);
+        u8g2.drawFrame(x, y + h - 8, w, 8);
+        if (level > 0)
+            u8g2.drawBox(x + 2, y + h - 6, level, 4);
+        break;
+
+    case UI_TOGGLE:
+        // centered label, indicator at the bottom
+        fit_text(u8g2, buf, get_label(widget), w);
+        tw = u8g2.getUTF8Width(buf);
+        u8g2.drawUTF8(x + (w - tw) / 2, y + ascent, buf);
+        u8g2.drawFrame(x + 2, y + h - 8, w - 4, 8);
+        if (level != 0)
+            u8g2.drawBox(x + 4, y + h - 6, w - 8, 4);
+        break;
+
+    case UI_LIST:
+        // label in the first line, current item inverted in the second line
+        fit_text(u8g2, buf, get_label(widget), w);
+        u8g2.drawUTF8(x, y + ascent, buf);
+        if (value[0] != '\0') {
+            u8g2.drawBox(x, y + line_height + 1, w, line_height);
+            u8g2.setDrawColor(0);
+            fit_text(u8g2, buf, value, w - 2);
+            u8g2.drawUTF8(x + 1, y + line_height + 1 + ascent, buf);
+            u8g2.setDrawColor(1);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+bool PedalUI::draw(PedalDisplay &u8g2) {
+    char value[UI_TEXT_SIZE];
+    u8g2_uint_t level;
+    bool modified = false;
+
+    if (!dirty)
+        return false;
+    dirty = false;
+
+    if (font != 0)
+        u8g2.setFont(font);
+    u8g2.setFontPosBaseline();
+    u8g2.setDrawColor(1);
+
+    if (clear_pending) {
+        u8g2.clearBuffer();
+        clear_pending = false;
+        modified = true;
+    }
+
+    for (uint8_t i = 0; i < widget_count; i++) {
+        ui_widget_t *widget = &widgets[i];
+
+        if (widget->screen != screen || !widget->dirty)
+            continue;
+        widget->dirty = false;
+
+        // an update with the same visible content does not touch the buffer
+        uint32_t key = getContent(widget, value, &level);
+        if (widget->drawn && key == widget->drawn_key)
+            continue;
+
+        u8g2.setDrawColor(0);
+        u8g2.drawBox(widget->x, widget->y, widget->w, widget->h);
+        u8g2.setDrawColor(1);
+        drawWidget(u8g2, widget, value, level);
+
+        widget->drawn = true;
+        widget->drawn_key = key;
+        modified = true;
+    }
+
+    return modified;
+}
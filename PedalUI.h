@@ -0,0 +1,97 @@
+#ifndef PEDAL_UI_H
+#define PEDAL_UI_H
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include <ControlChain.h>
+
+// maximum number of widgets on all screens
+#define UI_MAX_WIDGETS      12
+// number of screens (banks), the first screen is 0
+#define UI_MAX_SCREENS      4
+// longest text of a widget in bytes, str16_t text plus unit
+#define UI_TEXT_SIZE        28
+
+enum {UI_LABEL, UI_VALUE_BAR, UI_TOGGLE, UI_LIST};
+
+// ST7920 with U8G2_R0, rotation and buffer layout are bound at compile time;
+// draw procedures take a PedalDisplay &, through a U8G2 & the bound methods are not used
+typedef U8G2T<U8G2_ST7920_128X64_F_DIRTY_SW_SPI, U8G2T_R0, U8G2T_HORIZONTAL_RIGHT_LSB> PedalDisplay;
+// display clock at A0 and data at pin 16: USART1 with DMA transfer
+//typedef U8G2T<U8G2_ST7920_128X64_F_DIRTY_SAM_USART_SPI, U8G2T_R0, U8G2T_HORIZONTAL_RIGHT_LSB> PedalDisplay;
+
+typedef struct ui_widget_t {
+    uint8_t type;               // UI_LABEL, UI_VALUE_BAR, UI_TOGGLE or UI_LIST
+    uint8_t screen;
+    u8g2_uint_t x, y, w, h;     // bounding box, the widget draws only inside
+    int actuator_id;            // assignments of this actuator are shown
+    const char *text;           // shown if the actuator is not assigned
+    cc_assignment_t *assignment;    // 0 if not assigned
+
+    bool dirty;                 // content may have changed
+    bool drawn;                 // the buffer contains the widget with drawn_key
+    uint32_t drawn_key;         // hash of the drawn content
+} ui_widget_t;
+
+/*
+  Retained widgets for the full buffer with double buffer (setFrontBuffer()).
+
+  Widgets are bound to an actuator id and show the fields of its
+  cc_assignment_t: label, value with unit, min/max and the current item of
+  list_items. Events of ControlChain only mark the widgets of the actuator
+  as dirty. draw() redraws just the dirty widgets whose content has changed,
+  each inside its own bounding box, the rest of the back buffer is kept.
+  After swapBuffer() only the changed tile rows are sent to the display.
+
+  Each screen (bank) has its own widgets, setScreen() clears the buffer
+  and draws all widgets of the new screen.
+*/
+class PedalUI {
+    public:
+        PedalUI();
+
+        // widgets, returns the widget id or -1 if the widget table is full.
+        // text is shown while the actuator is not assigned. Value bars, toggles
+        // and lists need the height of two text lines
+        int addLabel(uint8_t screen, int actuator_id, const char *text,
+                     u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+        int addValueBar(uint8_t screen, int actuator_id, const char *text,
+                        u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+        int addToggle(uint8_t screen, int actuator_id, const char *text,
+                      u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+        int addList(uint8_t screen, int actuator_id, const char *text,
+                    u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+
+        // ControlChain events
+        void assign(cc_assignment_t *assignment);
+        void unassign(int actuator_id);
+        void update(cc_assignment_t *assignment);
+
+        void setFont(const uint8_t *font) { this->font = font; }
+        void setScreen(uint8_t screen);
+        uint8_t getScreen() { return screen; }
+        void nextScreen();
+
+        // true if draw() has something to do
+        bool isDirty() { return dirty; }
+        // redraw the changed widgets of the current screen into the buffer,
+        // returns false if the buffer was not modified
+        bool draw(PedalDisplay &u8g2);
+
+    private:
+        int addWidget(uint8_t type, uint8_t screen, int actuator_id, const char *text,
+                      u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+        void markDirty(int actuator_id);
+        uint32_t getContent(ui_widget_t *widget, char *value, u8g2_uint_t *level);
+        void drawWidget(PedalDisplay &u8g2, ui_widget_t *widget, const char *value, u8g2_uint_t level);
+
+        ui_widget_t widgets[UI_MAX_WIDGETS];
+        uint8_t widget_count;
+        uint8_t screen;
+        uint8_t screen_count;
+        const uint8_t *font;
+        bool dirty;
+        bool clear_pending;     // the buffer contains another screen
+};
+
+#endif
@@ -5,18 +5,44 @@
 #include <Encoder.h>
 #include <SPI.h>
 #include <Wire.h>
+#include "PedalScheduler.h"
+#include "PedalUI.h"
 
 #define ENC_MIN -200.0
 #define ENC_MAX 200.0
 
+// task periods and run time budgets in us
+#define INPUT_PERIOD      1000      // 1 kHz footswitch and encoder scan
+#define INPUT_BUDGET      100
+#define PROTOCOL_PERIOD   CC_FRAME_PERIOD
+#define PROTOCOL_BUDGET   200
+#define DISPLAY_PERIOD    2000      // one page slice per release
+#define DISPLAY_BUDGET    3000
+#define DISPLAY_FRAME     40000     // 25 Hz frame rate
+
+// uncomment to print scheduler statistics on the native USB port
+//#define SCHED_DEBUG
+#define SCHED_DEBUG_PERIOD 5000000
+
 ControlChain cc;
-U8G2_ST7920_128X64_1_SW_SPI u8g2(U8G2_R0, 13, 11, 10, 9);
+// display type and rotation, see PedalUI.h
+PedalDisplay u8g2(13, 11, 10, 9);
+// with the USART1 display in PedalUI.h
+//PedalDisplay u8g2(10, 9);
+PedalScheduler scheduler;
+// decoded glyphs of u8g2_font_8x13_t_symbols, see setGlyphCache()
+uint8_t glyphCache[1024];
+// glyph positions of the current font, see setGlyphIndex()
+uint16_t glyphIndex[512];
+// frame which is transferred to the display, see setFrontBuffer()
+uint8_t frontBuffer[1024];
+// status screen and assignment names, redrawn per widget
+PedalUI ui;
 
 float valFSW1, valFSW2, valFSW3;
 float valEncButton1, valEncButton2;
 float valEncA, valEncB;
 
-bool somethingChanged = true;
 // int switchFlag = 0;
 
 Bounce debounceFSW1 = Bounce();
@@ -138,10 +164,24 @@ void setup() {
 
     cc.setEventCallback(CC_EV_UPDATE, (void(*)(void* arg)) assignment_update);
     cc.setEventCallback(CC_EV_ASSIGNMENT, (void(*)(void* arg)) assignment_add);
-    //cc.setEventCallback(CC_EV_UNASSIGNMENT, (void(*)(void* arg)) assignment_remove);
+    cc.setEventCallback(CC_EV_UNASSIGNMENT, (void(*)(void* arg)) assignment_remove);
 
 	//############################# start display  #######################################
-	u8g2.begin();
+	// the init sequence is sent by task_display(), see there
+	u8g2.initDisplayStart();
+	u8g2.setGlyphCache(glyphCache, sizeof(glyphCache));
+	u8g2.setGlyphIndex(glyphIndex, sizeof(glyphIndex)/sizeof(glyphIndex[0]));
+	u8g2.setFrontBuffer(frontBuffer);
+	setup_ui();
+
+	//############################# start scheduler  #####################################
+	scheduler.addTask("input", task_input, INPUT_PERIOD, INPUT_BUDGET, 0);
+	scheduler.addTask("protocol", task_protocol, PROTOCOL_PERIOD, PROTOCOL_BUDGET, 1);
+	scheduler.addTask("display", task_display, DISPLAY_PERIOD, DISPLAY_BUDGET, 2);
+#ifdef SCHED_DEBUG
+	SerialUSB.begin(115200);
+	scheduler.addTask("stats", task_stats, SCHED_DEBUG_PERIOD, SCHED_DEBUG_PERIOD, 3);
+#endif
 }
 
 void toggleLED(int chosenLED, float assignmentVal) {
@@ -177,7 +217,7 @@ void assignment_update(cc_assignment_t *assignment) {
 		}
 	}
 
-	somethingChanged = true;
+	ui.update(assignment);
 }
 
 void assignment_add(cc_assignment_t *assignment) {
@@ -208,47 +248,100 @@ void assignment_add(cc_assignment_t *assignment) {
 		break;
 	}
 
-	somethingChanged = true;
+	ui.assign(assignment);
 }
 
-void assignment_remove(cc_assignment_t *assignment) {
+void assignment_remove(int actuator_id) {
 
-	somethingChanged = true;
+	ui.unassign(actuator_id);
 }
 
-void update_display() {
+// screen 0: encoder value and footswitch states, screen 1: full assignment names
+// actuator ids: footswitches 0..2, encoder A 3
+void setup_ui() {
 
-	u8g2.firstPage();
-	do {
-		u8g2.setFont(u8g2_font_8x13_t_symbols);
-		u8g2.drawFrame(0, 0, 128, 64);
-		u8g2.drawFrame(1, 1, 126, 62);
-		u8g2.drawFrame(2, 2, 124, 60);
-	} while (u8g2.nextPage());
+	ui.setFont(u8g2_font_8x13_t_symbols);
+	ui.addValueBar(0, 3, "EncoderA", 0, 0, 128, 20);
+	ui.addToggle(0, 0, "FSW1", 0, 44, 42, 20);
+	ui.addToggle(0, 1, "FSW2", 43, 44, 42, 20);
+	ui.addToggle(0, 2, "FSW3", 86, 44, 42, 20);
 
+	ui.addLabel(1, 0, "FootSwitch1", 0, 0, 128, 16);
+	ui.addLabel(1, 1, "FootSwitch2", 0, 16, 128, 16);
+	ui.addLabel(1, 2, "FootSwitch3", 0, 32, 128, 16);
+	ui.addLabel(1, 3, "EncoderA", 0, 48, 128, 16);
 }
 
-void loop() {
+//############################# scheduler tasks  #######################################
+
+void task_input() {
 
   debounceFSW1.update();
   debounceFSW2.update();
   debounceFSW3.update();
-  //debounceEncA.update();
+  debounceEncA.update();
   //debounceEncB.update();
 
   valFSW1 = (float) debounceFSW1.read();
   valFSW2 = (float) debounceFSW2.read();
   valFSW3 = (float) debounceFSW3.read();
   //valEncButton1 = (float) debounceEncA.read();
+  if (debounceEncA.fell())
+    ui.nextScreen();
   //valEncButton2 = (float) debounceEncB.read();
 
   valEncA = -readAndCheckEncoder(encoderA, ENC_MIN, ENC_MAX);
   //valEncB = readAndCheckEncoder(encoderB, ENC_MIN, ENC_MAX);
 
-  /*if (somethingChanged) {
-	  update_display();
-	  somethingChanged = false;
-  }*/
+}
+
+void task_protocol() {
 
   cc.run();
+}
+
+// redraws the changed widgets in the back buffer, then transfers one changed tile
+// row of the front buffer per call, so inputs are scanned between the parts of a frame.
+// the display shows either the old or the new frame, never a half drawn one.
+// before that, the display init is executed step by step: during its delays (about
+// 120 ms for the ST7920) the other tasks run and ControlChain can do the handshake
+void task_display() {
+	static uint32_t frame_start;
+	static uint32_t init_resume;
+	static bool display_on = false;
+
+	if (u8g2.isInitDisplayPending()) {
+		if ((int32_t) (micros() - init_resume) < 0)
+			return;
+		init_resume = micros() + 1000UL * u8g2.initDisplayStep();
+		return;
+	}
+
+	if (ui.isDirty() && !u8g2.isSwapPending() && (micros() - frame_start) >= DISPLAY_FRAME) {
+		frame_start = micros();
+		if (ui.draw(u8g2)) {
+			u8g2.swapBuffer();
+			return;
+		}
+	}
+
+	// the graphics RAM is not cleared by the init, so the display is switched on
+	// after the first frame has been transferred completely
+	if (!u8g2.transferStep() && !display_on && !u8g2.isSwapPending()) {
+		u8g2.setPowerSave(0);
+		display_on = true;
+	}
+}
+
+#ifdef SCHED_DEBUG
+void task_stats() {
+
+	scheduler.printStats(SerialUSB);
+	scheduler.resetStats();
+}
+#endif
+
+void loop() {
+
+  scheduler.runNext();
 }
\ No newline at end of file
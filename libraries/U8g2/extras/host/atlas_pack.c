@@ -0,0 +1,618 @@
+/*
+
+  atlas_pack.c
+
+  Packs monochrome images into one image atlas for u8g2_DrawAtlasImage()
+  (see u8g2_atlas.c for the format) and writes it as C source to stdout.
+  The bits per run length (m0, m1) are chosen for the smallest atlas.
+
+  Input files:
+    .xbm	XBM as used with u8g2_DrawXBM() (width, height and bits)
+    .pbm	PBM, P1 (text) or P4 (binary)
+  Images may have up to 255x255 pixel, an atlas up to 255 images.
+
+  Before the atlas is written, each image is drawn with u8g2_DrawAtlasImage()
+  and compared with u8g2_DrawXBM() of the original image: ST7920 full and
+  page buffer, SSD1306 page buffer with U8G2_R0 and U8G2_R2 (no blit),
+  different positions, colors and bitmap modes. The same check is done 
+  first for built-in images with 248..255 pixel width. With -t the tool also measures both procedures.
+
+  Build (from this directory):
+    cc -O2 -I../../src/clib atlas_pack.c ../../src/clib/u8[gx]*.c -o atlas_pack
+
+  Usage:
+    ./atlas_pack [-n name] [-t] file ... > name.c
+      -n name	name of the array (default "atlas"), the image numbers are
+		defined as NAME_FILE (uppercase base names of the files)
+      -t	measure u8g2_DrawAtlasImage() and u8g2_DrawXBM() (to stderr)
+
+*/
+
+#include "u8g2.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_IMAGES 255
+#define MAX_ATLAS 65535
+#define ROUNDS 20000
+
+typedef struct
+{
+  char name[64];
+  const char *file;
+  int w, h;
+  uint8_t *xbm;		/* (w+7)/8 bytes per row, lsb is the left pixel */
+} image_t;
+
+static image_t images[MAX_IMAGES];
+static int image_cnt;
+
+static uint8_t atlas[MAX_ATLAS];
+static long atlas_size;
+
+/*===========================================*/
+/* input */
+
+static int get_pixel(const image_t *img, int x, int y)
+{
+  return (img->xbm[y*((img->w+7)/8) + x/8] >> (x&7)) & 1;
+}
+
+static void set_pixel(image_t *img, int x, int y)
+{
+  img->xbm[y*((img->w+7)/8) + x/8] |= 1 << (x&7);
+}
+
+static int alloc_image(image_t *img, int w, int h)
+{
+  if ( w <= 0 || h <= 0 || w > 255 || h > 255 )
+  {
+    fprintf(stderr, "%s: size %dx%d not supported\n", img->file, w, h);
+    return 0;
+  }
+  img->w = w;
+  img->h = h;
+  img->xbm = calloc((w+7)/8*h, 1);
+  return img->xbm != NULL;
+}
+
+static char *read_file(const char *file, long *size)
+{
+  FILE *fp;
+  char *buf;
+
+  fp = fopen(file, "rb");
+  if ( fp == NULL )
+  {
+    perror(file);
+    return NULL;
+  }
+  fseek(fp, 0, SEEK_END);
+  *size = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+  buf = malloc(*size + 1);
+  if ( buf != NULL )
+  {
+    *size = fread(buf, 1, *size, fp);
+    buf[*size] = '\0';
+  }
+  fclose(fp);
+  return buf;
+}
+
+/* value of "#define ..._<key> <value>" */
+static int xbm_define(const char *s, const char *key)
+{
+  const char *p = s;
+  const char *q;
+
+  while( (p = strstr(p, "#define")) != NULL )
+  {
+    p += 7;
+    while( *p == ' ' || *p == '\t' )
+      p++;
+    q = p;
+    while( *q != '\0' && !isspace((unsigned char)*q) )
+      q++;
+    if ( q - p >= (long)strlen(key) && strncmp(q - strlen(key), key, strlen(key)) == 0 )
+      return atoi(q);
+  }
+  return -1;
+}
+
+static int read_xbm(image_t *img, const char *s)
+{
+  const char *p;
+  char *end;
+  long i, cnt;
+
+  if ( alloc_image(img, xbm_define(s, "_width"), xbm_define(s, "_height")) == 0 )
+    return 0;
+  p = strchr(s, '{');
+  if ( p == NULL )
+    return 0;
+  p++;
+  cnt = (img->w+7)/8*img->h;
+  for( i = 0; i < cnt; i++ )
+  {
+    while( *p != '\0' && !isxdigit((unsigned char)*p) )
+      p++;
+    if ( *p == '\0' )
+      break;
+    img->xbm[i] = strtol(p, &end, 0);
+    p = end;
+  }
+  if ( i != cnt )
+  {
+    fprintf(stderr, "%s: %ld of %ld bytes\n", img->file, i, cnt);
+    return 0;
+  }
+  return 1;
+}
+
+/* next number in the PBM header, skips comments */
+static int pbm_number(const char **p)
+{
+  int v = 0;
+
+  for(;;)
+  {
+    while( isspace((unsigned char)**p) )
+      (*p)++;
+    if ( **p != '#' )
+      break;
+    while( **p != '\0' && **p != '\n' )
+      (*p)++;
+  }
+  while( isdigit((unsigned char)**p) )
+  {
+    v = v*10 + **p - '0';
+    (*p)++;
+  }
+  return v;
+}
+
+static int read_pbm(image_t *img, const char *s, long size)
+{
+  const char *p = s + 2;
+  const uint8_t *bits;
+  int is_binary = s[1] == '4';
+  int x, y, w, h;
+
+  w = pbm_number(&p);
+  h = pbm_number(&p);
+  if ( alloc_image(img, w, h) == 0 )
+    return 0;
+  /* one white space after the header */
+  p++;
+  bits = (const uint8_t *)p;
+  if ( is_binary && (const char *)bits + (w+7)/8*h > s + size )
+  {
+    fprintf(stderr, "%s: file too short\n", img->file);
+    return 0;
+  }
+  for( y = 0; y < h; y++ )
+    for( x = 0; x < w; x++ )
+    {
+      if ( is_binary )
+      {
+	if ( bits[y*((w+7)/8) + x/8] & (0x80 >> (x&7)) )
+	  set_pixel(img, x, y);
+      }
+      else
+      {
+	while( *p != '\0' && *p != '0' && *p != '1' )
+	  p++;
+	if ( *p == '\0' )
+	  return 0;
+	if ( *p++ == '1' )
+	  set_pixel(img, x, y);
+      }
+    }
+  return 1;
+}
+
+static int read_image(image_t *img, const char *file)
+{
+  const char *base;
+  char *s;
+  long size;
+  int i, ok;
+
+  img->file = file;
+  base = strrchr(file, '/');
+  base = base == NULL ? file : base + 1;
+  for( i = 0; base[i] != '\0' && base[i] != '.' && i < (int)sizeof(img->name)-1; i++ )
+    img->name[i] = isalnum((unsigned char)base[i]) ? toupper((unsigned char)base[i]) : '_';
+  img->name[i] = '\0';
+
+  s = read_file(file, &size);
+  if ( s == NULL )
+    return 0;
+  if ( size > 2 && s[0] == 'P' && (s[1] == '1' || s[1] == '4') )
+    ok = read_pbm(img, s, size);
+  else
+    ok = read_xbm(img, s);
+  free(s);
+  if ( ok == 0 )
+    fprintf(stderr, "%s: not a XBM or PBM (P1, P4) file\n", file);
+  return ok;
+}
+
+/*===========================================*/
+/* encoder */
+
+static int bit_pos;
+static int is_overflow;
+
+static void put_bits(unsigned v, int cnt)
+{
+  while( cnt > 0 )
+  {
+    if ( bit_pos == 0 )
+    {
+      /* one byte is left for the end of the atlas */
+      if ( atlas_size >= MAX_ATLAS - 1 )
+      {
+	is_overflow = 1;
+	return;
+      }
+      atlas[atlas_size++] = 0;
+    }
+    atlas[atlas_size-1] |= (v & 1) << bit_pos;
+    v >>= 1;
+    bit_pos = (bit_pos + 1) & 7;
+    cnt--;
+  }
+}
+
+static void put_word(long pos, long v)
+{
+  atlas[pos] = v >> 8;
+  atlas[pos+1] = v & 255;
+}
+
+/* rows y..y+h-1 of the image, each band starts at a byte */
+static void encode_band(const image_t *img, int y0, int h, int m0, int m1)
+{
+  int max0 = (1 << m0) - 1;
+  int max1 = (1 << m1) - 1;
+  int cnt = img->w*h;
+  int i = 0;
+  int a, b, prev_a = -1, prev_b = -1;
+  long start = atlas_size;
+  int x, y;
+
+  bit_pos = 0;
+  put_bits(0, 1);
+  while( i < cnt )
+  {
+    for( a = 0; a < max0 && i < cnt && get_pixel(img, i % img->w, y0 + i / img->w) == 0; a++ )
+      i++;
+    for( b = 0; b < max1 && i < cnt && get_pixel(img, i % img->w, y0 + i / img->w) != 0; b++ )
+      i++;
+    if ( a == prev_a && b == prev_b )
+    {
+      put_bits(1, 1);
+    }
+    else
+    {
+      if ( prev_a >= 0 )
+	put_bits(0, 1);
+      put_bits(a, m0);
+      put_bits(b, m1);
+      prev_a = a;
+      prev_b = b;
+    }
+  }
+
+  /* without compression, if this is smaller */
+  if ( atlas_size - start > (1 + cnt + 7) / 8 )
+  {
+    atlas_size = start;
+    bit_pos = 0;
+    put_bits(1, 1);
+    for( y = y0; y < y0 + h; y++ )
+      for( x = 0; x < img->w; x++ )
+	put_bits(get_pixel(img, x, y), 1);
+  }
+}
+
+/* returns the size of the atlas, 0 if it is too large */
+static long encode(int m0, int m1)
+{
+  int i, band, bands;
+  long image_pos;
+
+  atlas[0] = image_cnt;
+  atlas[1] = m0;
+  atlas[2] = m1;
+  atlas_size = 3 + image_cnt*4;
+  is_overflow = 0;
+  for( i = 0; i < image_cnt; i++ )
+  {
+    bands = (images[i].h + U8G2_ATLAS_BAND_HEIGHT - 1) / U8G2_ATLAS_BAND_HEIGHT;
+    if ( atlas_size + (bands - 1)*2 > MAX_ATLAS - 1 )
+      return 0;
+    image_pos = atlas_size;
+    atlas[3 + i*4] = images[i].w;
+    atlas[3 + i*4 + 1] = images[i].h;
+    put_word(3 + i*4 + 2, image_pos);
+    atlas_size += (bands - 1)*2;
+    for( band = 0; band < bands; band++ )
+    {
+      if ( band > 0 )
+	put_word(image_pos + (band - 1)*2, atlas_size - image_pos);
+      encode_band(&images[i], band*U8G2_ATLAS_BAND_HEIGHT,
+	images[i].h - band*U8G2_ATLAS_BAND_HEIGHT < U8G2_ATLAS_BAND_HEIGHT ?
+	  images[i].h - band*U8G2_ATLAS_BAND_HEIGHT : U8G2_ATLAS_BAND_HEIGHT, m0, m1);
+    }
+  }
+  if ( is_overflow )
+    return 0;
+  /* the decoder may read one byte after the last band */
+  atlas[atlas_size++] = 0;
+  return atlas_size;
+}
+
+static long pack(void)
+{
+  int m0, m1, best_m0 = 1, best_m1 = 1;
+  long size, best = 0;
+
+  for( m0 = 1; m0 <= 8; m0++ )
+    for( m1 = 1; m1 <= 8; m1++ )
+    {
+      size = encode(m0, m1);
+      if ( size != 0 && (best == 0 || size < best) )
+      {
+	best = size;
+	best_m0 = m0;
+	best_m1 = m1;
+      }
+    }
+  if ( best == 0 )
+    return 0;
+  return encode(best_m0, best_m1);
+}
+
+/*===========================================*/
+/* check and measurement */
+
+static u8g2_t u8g2;
+
+static uint8_t byte_none(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static uint8_t gpio_and_delay_none(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static uint16_t buffer_size(void)
+{
+  return u8g2_GetBufferTileHeight(&u8g2) * u8g2_GetBufferTileWidth(&u8g2) * 8;
+}
+
+static unsigned long check_image(int idx, u8g2_uint_t x, u8g2_uint_t y)
+{
+  static uint8_t expected[1024];
+  unsigned long errors = 0;
+  uint8_t color, mode;
+
+  for( mode = 0; mode < 2; mode++ )
+    for( color = 0; color < 3; color++ )
+    {
+      u8g2_SetBitmapMode(&u8g2, mode);
+      u8g2_SetDrawColor(&u8g2, color);
+      u8g2_FirstPage(&u8g2);
+      do
+      {
+	memset(u8g2_GetBufferPtr(&u8g2), 0x5a, buffer_size());
+	u8g2_DrawXBM(&u8g2, x, y, images[idx].w, images[idx].h, images[idx].xbm);
+	memcpy(expected, u8g2_GetBufferPtr(&u8g2), buffer_size());
+	memset(u8g2_GetBufferPtr(&u8g2), 0x5a, buffer_size());
+	u8g2_DrawAtlasImage(&u8g2, x, y, atlas, idx);
+	if ( memcmp(expected, u8g2_GetBufferPtr(&u8g2), buffer_size()) != 0 )
+	  errors++;
+      } while( u8g2_NextPage(&u8g2) );
+    }
+  u8g2_SetBitmapMode(&u8g2, 0);
+  u8g2_SetDrawColor(&u8g2, 1);
+  return errors;
+}
+
+static unsigned long check_setup(void)
+{
+  unsigned long errors = 0;
+  int i;
+
+  for( i = 0; i < image_cnt; i++ )
+  {
+    if ( u8g2_GetAtlasWidth(atlas, i) != images[i].w || u8g2_GetAtlasHeight(atlas, i) != images[i].h )
+      errors++;
+    errors += check_image(i, 0, 0);
+    errors += check_image(i, 13, 5);
+    errors += check_image(i, -3, -11);
+    errors += check_image(i, 120, 60);
+  }
+  return errors;
+}
+
+static unsigned long check(void)
+{
+  unsigned long errors = 0;
+
+  if ( u8g2_GetAtlasCount(atlas) != image_cnt )
+    errors++;
+  u8g2_Setup_st7920_s_128x64_f(&u8g2, U8G2_R0, byte_none, gpio_and_delay_none);
+  errors += check_setup();
+  u8g2_Setup_st7920_s_128x64_1(&u8g2, U8G2_R0, byte_none, gpio_and_delay_none);
+  errors += check_setup();
+  u8g2_Setup_ssd1306_128x64_noname_2(&u8g2, U8G2_R0, byte_none, gpio_and_delay_none);
+  errors += check_setup();
+  /* without blit */
+  u8g2_Setup_ssd1306_128x64_noname_2(&u8g2, U8G2_R2, byte_none, gpio_and_delay_none);
+  errors += check_setup();
+  return errors;
+}
+
+/*
+  Images with 248..255 pixel width, drawn before the input files are read:
+  (w+7)/8 and the decoder position exceed u8g2_uint_t in 8 bit mode.
+*/
+static unsigned long self_check(void)
+{
+  unsigned long errors = 0;
+  int i, x, y;
+
+  srand(1);
+  for( i = 0; i < 8; i++ )
+  {
+    images[i].file = "self check";
+    if ( alloc_image(&images[i], 248 + i, 20) == 0 )
+      return 1;
+    for( y = 0; y < images[i].h; y++ )
+      for( x = 0; x < images[i].w; x++ )
+	if ( (y < 10 && ((x/5 + y/3) & 1)) || (y >= 10 && rand() % 3 == 0) || x == images[i].w-1 )
+	  set_pixel(&images[i], x, y);
+  }
+  image_cnt = 8;
+  if ( pack() == 0 )
+    errors++;
+  else
+    errors += check();
+  for( i = 0; i < 8; i++ )
+    free(images[i].xbm);
+  memset(images, 0, sizeof(images));
+  image_cnt = 0;
+  return errors;
+}
+
+/* u8g2_buffer.c, not part of u8g2.h */
+void u8g2_SetBufferCurrTileRow(u8g2_t *u8g2, uint8_t row);
+
+/* time for all pages of one frame, without the transfer to the display */
+static double measure(int idx, int is_atlas)
+{
+  clock_t start;
+  int round;
+  uint8_t row;
+
+  start = clock();
+  for( round = 0; round < ROUNDS; round++ )
+  {
+    for( row = 0; row < u8g2_GetU8x8(&u8g2)->display_info->tile_height; row += u8g2_GetBufferTileHeight(&u8g2) )
+    {
+      u8g2_SetBufferCurrTileRow(&u8g2, row);
+      if ( is_atlas )
+	u8g2_DrawAtlasImage(&u8g2, 3, 5, atlas, idx);
+      else
+	u8g2_DrawXBM(&u8g2, 3, 5, images[idx].w, images[idx].h, images[idx].xbm);
+    }
+  }
+  return (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / ROUNDS;
+}
+
+static void measure_setup(const char *name)
+{
+  int i;
+
+  for( i = 0; i < image_cnt; i++ )
+    fprintf(stderr, "%-10s %-16s %3dx%-3d  XBM %7.3f us  atlas %7.3f us\n", name,
+      images[i].name, images[i].w, images[i].h, measure(i, 0), measure(i, 1));
+}
+
+/*===========================================*/
+/* output */
+
+static void write_atlas(const char *name)
+{
+  long i, xbm_size = 0;
+  int j;
+
+  for( j = 0; j < image_cnt; j++ )
+    xbm_size += (images[j].w+7)/8*images[j].h;
+
+  printf("/*\n  %s: %d images, generated by atlas_pack\n", name, image_cnt);
+  printf("  %ld bytes (XBM: %ld bytes), %d bits per 0 run, %d bits per 1 run\n*/\n\n",
+    atlas_size, xbm_size, atlas[1], atlas[2]);
+  for( j = 0; j < image_cnt; j++ )
+  {
+    printf("#define ");
+    for( i = 0; name[i] != '\0'; i++ )
+      putchar(toupper((unsigned char)name[i]));
+    printf("_%s %d\t/* %dx%d %s */\n", images[j].name, j, images[j].w, images[j].h, images[j].file);
+  }
+  printf("\nconst uint8_t %s[%ld] U8X8_PROGMEM = {", name, atlas_size);
+  for( i = 0; i < atlas_size; i++ )
+  {
+    if ( i % 16 == 0 )
+      printf("\n ");
+    printf(" 0x%02x%s", atlas[i], i + 1 < atlas_size ? "," : "");
+  }
+  printf("\n};\n");
+
+  fprintf(stderr, "%s: %d images, %ld bytes, XBM %ld bytes\n", name, image_cnt, atlas_size, xbm_size);
+}
+
+int main(int argc, char **argv)
+{
+  const char *name = "atlas";
+  int is_measure = 0;
+  int i;
+
+  if ( self_check() != 0 )
+  {
+    fprintf(stderr, "self check failed for images with 248..255 pixel width\n");
+    return 1;
+  }
+  for( i = 1; i < argc; i++ )
+  {
+    if ( strcmp(argv[i], "-n") == 0 && i + 1 < argc )
+      name = argv[++i];
+    else if ( strcmp(argv[i], "-t") == 0 )
+      is_measure = 1;
+    else if ( argv[i][0] == '-' )
+      break;
+    else if ( image_cnt >= MAX_IMAGES )
+    {
+      fprintf(stderr, "more than %d images\n", MAX_IMAGES);
+      return 1;
+    }
+    else if ( read_image(&images[image_cnt], argv[i]) == 0 )
+      return 1;
+    else
+      image_cnt++;
+  }
+  if ( i < argc || image_cnt == 0 )
+  {
+    fprintf(stderr, "usage: %s [-n name] [-t] file ...\n", argv[0]);
+    return 1;
+  }
+
+  if ( pack() == 0 )
+  {
+    fprintf(stderr, "the atlas is larger than %d bytes\n", MAX_ATLAS);
+    return 1;
+  }
+  if ( check() != 0 )
+  {
+    fprintf(stderr, "decoded images differ from the input\n");
+    return 1;
+  }
+  if ( is_measure )
+  {
+    u8g2_Setup_st7920_s_128x64_f(&u8g2, U8G2_R0, byte_none, gpio_and_delay_none);
+    measure_setup("ST7920 f");
+    u8g2_Setup_st7920_s_128x64_1(&u8g2, U8G2_R0, byte_none, gpio_and_delay_none);
+    measure_setup("ST7920 1");
+  }
+  write_atlas(name);
+  return 0;
+}
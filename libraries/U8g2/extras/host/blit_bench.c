@@ -0,0 +1,315 @@
+/*
+
+  blit_bench.c
+
+  Bitmap procedures with u8g2_BlitBitmap() (U8G2_WITH_BITMAP_BLIT) compared
+  with the previous implementation, which draws each pixel with
+  u8g2_DrawHVLine(). Measured are three 16x16 pedal icons (bypass, tap
+  tempo, bank) with u8g2_DrawXBM(), at a byte aligned and at an unaligned
+  x position, transparent and opaque, for the ST7920 (horizontal buffer)
+  and the SSD1306 (vertical buffer).
+
+  Before the measurement the tool compares the buffer after u8g2_DrawXBM(),
+  u8g2_DrawXBMP(), u8g2_DrawHXBM(), u8g2_DrawBitmap() and
+  u8g2_DrawHorizontalBitmap() with the previous implementation for random
+  bitmaps, positions (also partly outside of the display), colors and
+  bitmap modes. This is done with full buffers, page buffers and U8G2_R2
+  (not supported by the blit, must not change anything).
+
+  Build and run (from this directory):
+    cc -O2 -I../../src/clib blit_bench.c ../../src/clib/u8[gx]*.c -o blit_bench
+    ./blit_bench
+
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ROUNDS 20000
+#define RANDOM_TESTS 3000
+
+static u8g2_t u8g2;
+
+static const char *icon_text[3][16] =
+{
+  {
+    /* bypass */
+    "................",
+    ".......##.......",
+    "...#...##...#...",
+    "..##...##...##..",
+    ".##....##....##.",
+    ".#.....##.....#.",
+    "##.....##.....##",
+    "##.....##.....##",
+    "##............##",
+    "##............##",
+    ".#............#.",
+    ".##..........##.",
+    "..###......###..",
+    "...##########...",
+    ".....######.....",
+    "................"
+  },
+  {
+    /* tap tempo */
+    "......####......",
+    "......#..#......",
+    ".....#....#.....",
+    ".....#..#.#.....",
+    "....#...#..#....",
+    "....#...#..#....",
+    "...#....#...#...",
+    "...#...#....#...",
+    "..#....#.....#..",
+    "..#...#......#..",
+    ".#....#.......#.",
+    ".#...#........#.",
+    "#....#.........#",
+    "################",
+    "#..............#",
+    "################"
+  },
+  {
+    /* bank */
+    "....##########..",
+    "....#........#..",
+    "..##########.#..",
+    "..#........#.#..",
+    "##########.#.#..",
+    "#........#.#.#..",
+    "#..####..#.#.#..",
+    "#........#.#.#..",
+    "#..####..#.#.#..",
+    "#........#.#.#..",
+    "#..####..#.#.#..",
+    "#........#.#....",
+    "#........#.#....",
+    "#........#......",
+    "##########......",
+    "................"
+  }
+};
+
+/* XBM, lsb is the left pixel */
+static uint8_t icons[3][32];
+
+static uint8_t byte_none(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static uint8_t gpio_and_delay_none(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+/* previous implementation: u8g2_DrawHXBM() and u8g2_DrawHorizontalBitmap() with one u8g2_DrawHVLine() per pixel */
+static void pixel_row(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, const uint8_t *b, uint8_t is_lsb_first)
+{
+  uint8_t mask;
+  uint8_t color = u8g2.draw_color;
+  uint8_t ncolor = (color == 0 ? 1 : 0);
+
+  if ( u8g2_IsIntersection(&u8g2, x, y, x+len, y+1) == 0 )
+    return;
+  mask = is_lsb_first ? 1 : 128;
+  while(len > 0) {
+    if ( *b & mask ) {
+      u8g2.draw_color = color;
+      u8g2_DrawHVLine(&u8g2, x, y, 1, 0);
+    } else if ( u8g2.bitmap_transparency == 0 ) {
+      u8g2.draw_color = ncolor;
+      u8g2_DrawHVLine(&u8g2, x, y, 1, 0);
+    }
+    x++;
+    mask = is_lsb_first ? mask << 1 : mask >> 1;
+    if ( mask == 0 )
+    {
+      mask = is_lsb_first ? 1 : 128;
+      b++;
+    }
+    len--;
+  }
+  u8g2.draw_color = color;
+}
+
+/* previous implementation of u8g2_DrawXBM() (is_lsb_first = 1) and u8g2_DrawBitmap() (w = cnt*8) */
+static void pixel_bitmap(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap, uint8_t is_lsb_first)
+{
+  u8g2_uint_t blen = (w+7)/8;
+
+  if ( u8g2_IsIntersection(&u8g2, x, y, x+w, y+h) == 0 )
+    return;
+  while( h > 0 )
+  {
+    pixel_row(x, y, w, bitmap, is_lsb_first);
+    bitmap += blen;
+    y++;
+    h--;
+  }
+}
+
+static uint16_t buffer_size(void)
+{
+  return u8g2_GetBufferTileHeight(&u8g2) * u8g2_GetBufferTileWidth(&u8g2) * 8;
+}
+
+/* procedure 0: XBM, 1: XBMP, 2: HXBM, 3: Bitmap, 4: HorizontalBitmap */
+static void draw(uint8_t procedure, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap)
+{
+  switch( procedure )
+  {
+    case 0: u8g2_DrawXBM(&u8g2, x, y, w, h, bitmap); break;
+    case 1: u8g2_DrawXBMP(&u8g2, x, y, w, h, bitmap); break;
+    case 2: u8g2_DrawHXBM(&u8g2, x, y, w, bitmap); break;
+    case 3: u8g2_DrawBitmap(&u8g2, x, y, (w+7)/8, h, bitmap); break;
+    case 4: u8g2_DrawHorizontalBitmap(&u8g2, x, y, (w+7)/8*8, bitmap); break;
+  }
+}
+
+static void draw_reference(uint8_t procedure, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap)
+{
+  switch( procedure )
+  {
+    case 0: case 1: pixel_bitmap(x, y, w, h, bitmap, 1); break;
+    case 2: pixel_row(x, y, w, bitmap, 1); break;
+    case 3: pixel_bitmap(x, y, (w+7)/8*8, h, bitmap, 0); break;
+    case 4: pixel_row(x, y, (w+7)/8*8, bitmap, 0); break;
+  }
+}
+
+static unsigned long check_setup(void)
+{
+  static uint8_t bitmap[8*40];
+  static uint8_t background[1024];
+  static uint8_t expected[1024];
+  unsigned long errors = 0;
+  u8g2_uint_t x, y, w, h;
+  uint8_t procedure, color, mode;
+  uint16_t test, i;
+
+  for( test = 0; test < RANDOM_TESTS; test++ )
+  {
+    for( i = 0; i < sizeof(bitmap); i++ )
+      bitmap[i] = rand();
+    for( i = 0; i < sizeof(background); i++ )
+      background[i] = rand();
+    x = rand();
+    y = rand();
+    w = rand() % 60 + 1;
+    h = rand() % 40 + 1;
+    procedure = rand() % 5;
+    color = rand() % 3;
+    mode = rand() % 2;
+    /* mostly positions near the display */
+    if ( test & 1 )
+    {
+      x = x % 150 - 20;
+      y = y % 90 - 20;
+    }
+
+    u8g2_SetDrawColor(&u8g2, color);
+    u8g2_SetBitmapMode(&u8g2, mode);
+    u8g2_FirstPage(&u8g2);
+    do
+    {
+      memcpy(u8g2_GetBufferPtr(&u8g2), background, buffer_size());
+      draw_reference(procedure, x, y, w, h, bitmap);
+      memcpy(expected, u8g2_GetBufferPtr(&u8g2), buffer_size());
+      memcpy(u8g2_GetBufferPtr(&u8g2), background, buffer_size());
+      draw(procedure, x, y, w, h, bitmap);
+      if ( memcmp(expected, u8g2_GetBufferPtr(&u8g2), buffer_size()) != 0 || u8g2.draw_color != color )
+      {
+	if ( errors < 5 )
+	  printf("procedure %u x=%d y=%d w=%d h=%d color %u mode %u page %u\n", procedure, x, y, w, h, color, mode, u8g2.tile_curr_row);
+	errors++;
+      }
+    } while( u8g2_NextPage(&u8g2) );
+  }
+  u8g2_SetDrawColor(&u8g2, 1);
+  u8g2_SetBitmapMode(&u8g2, 0);
+  return errors;
+}
+
+static unsigned long check(void)
+{
+  unsigned long errors = 0;
+
+  srand(1);
+  u8g2_Setup_st7920_s_128x64_f(&u8g2, U8G2_R0, byte_none, gpio_and_delay_none);
+  errors += check_setup();
+  u8g2_Setup_st7920_s_128x64_1(&u8g2, U8G2_R0, byte_none, gpio_and_delay_none);
+  errors += check_setup();
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, byte_none, gpio_and_delay_none);
+  errors += check_setup();
+  u8g2_Setup_ssd1306_128x64_noname_2(&u8g2, U8G2_R0, byte_none, gpio_and_delay_none);
+  errors += check_setup();
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R2, byte_none, gpio_and_delay_none);
+  errors += check_setup();
+
+  if ( errors != 0 )
+    printf("%lu errors\n", errors);
+  return errors;
+}
+
+static double bench_icons(u8g2_uint_t x, uint8_t is_reference)
+{
+  clock_t start;
+  uint16_t round;
+  uint8_t i;
+
+  start = clock();
+  for( round = 0; round < ROUNDS; round++ )
+    for( i = 0; i < 3; i++ )
+      if ( is_reference )
+	pixel_bitmap(x + i*24, 8, 16, 16, icons[i], 1);
+      else
+	u8g2_DrawXBM(&u8g2, x + i*24, 8, 16, 16, icons[i]);
+  return (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / ROUNDS / 3;
+}
+
+static void bench(const char *name)
+{
+  u8g2_uint_t x;
+  uint8_t mode;
+
+  for( mode = 0; mode < 2; mode++ )
+    for( x = 16; x <= 19; x += 3 )
+    {
+      u8g2_SetBitmapMode(&u8g2, mode);
+      u8g2_ClearBuffer(&u8g2);
+      printf("%-8s %-11s x=%-2d  per pixel %6.2f us/icon  blit %6.3f us/icon\n", name,
+	mode ? "transparent" : "opaque", x, bench_icons(x, 1), bench_icons(x, 0));
+    }
+  u8g2_SetBitmapMode(&u8g2, 0);
+}
+
+int main(void)
+{
+  unsigned long errors;
+  uint8_t i, x, y;
+
+  for( i = 0; i < 3; i++ )
+    for( y = 0; y < 16; y++ )
+      for( x = 0; x < 16; x++ )
+	if ( icon_text[i][y][x] == '#' )
+	  icons[i][y*2 + x/8] |= 1 << (x&7);
+
+  errors = check();
+
+  u8g2_Setup_st7920_s_128x64_f(&u8g2, U8G2_R0, byte_none, gpio_and_delay_none);
+  bench("ST7920");
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, byte_none, gpio_and_delay_none);
+  bench("SSD1306");
+
+  if ( errors != 0 )
+  {
+    puts("FAILED");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,55 @@
+#!/bin/sh
+#
+# build.sh
+#
+# Build the host tools of this directory into ./build (or $OUT):
+#   ./build.sh		build all tools
+#   ./build.sh check	build, then run the tools which compare pictures
+#			or data streams, the exit code is 1 on any difference
+# CC and CFLAGS are used if set, e.g. CFLAGS="-O2 -DU8G2_16BIT" ./build.sh
+#
+# The u8g2 fonts of the tools are created by font_gen.c from the u8x8
+# fonts of this tree (build/host_fonts.c).
+#
+
+set -e
+cd "$(dirname "$0")"
+
+CC=${CC:-cc}
+CFLAGS=${CFLAGS:--O2}
+OUT=${OUT:-build}
+CLIB=../../src/clib
+
+mkdir -p $OUT/lib $OUT/lib_gpio_count
+
+# library objects, gpio_count needs U8X8_WITH_GPIO_COUNT in the library
+for f in $CLIB/u8[gx]*.c
+do
+  o=$(basename $f .c).o
+  $CC $CFLAGS -I$CLIB -c $f -o $OUT/lib/$o
+  $CC $CFLAGS -DU8X8_WITH_GPIO_COUNT -I$CLIB -c $f -o $OUT/lib_gpio_count/$o
+done
+
+$CC $CFLAGS -I$CLIB font_gen.c $OUT/lib/u8x8_fonts.o -o $OUT/font_gen
+$OUT/font_gen > $OUT/host_fonts.c
+$CC $CFLAGS -I$CLIB -c $OUT/host_fonts.c -o $OUT/host_fonts.o
+$CC $CFLAGS -I$CLIB -c st7920_capture.c -o $OUT/st7920_capture.o
+
+for t in atlas_pack blit_bench glyph_cache_bench glyph_index_bench kerning_bench \
+  sam_usart_spi_check selection_list_check str_width_bench upscale_bench
+do
+  $CC $CFLAGS -I$CLIB $t.c $OUT/lib/*.o $OUT/host_fonts.o -o $OUT/$t
+done
+for t in render_bench tile_text_bench
+do
+  $CC $CFLAGS -I$CLIB $t.c $OUT/st7920_capture.o $OUT/lib/*.o $OUT/host_fonts.o -o $OUT/$t
+done
+$CC $CFLAGS -DU8X8_WITH_GPIO_COUNT -I$CLIB gpio_count.c $OUT/lib_gpio_count/*.o -o $OUT/gpio_count
+
+if [ "$1" = "check" ]
+then
+  # render_bench writes the differing pictures into the current directory
+  (cd $OUT && ./render_bench ../golden)
+  $OUT/sam_usart_spi_check
+  $OUT/selection_list_check
+fi
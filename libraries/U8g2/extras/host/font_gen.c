@@ -0,0 +1,407 @@
+/*
+
+  font_gen.c
+
+  Writes the u8g2 fonts for the host tools of this directory as C source
+  to stdout. The fonts of the U8g2 release (u8g2_fonts.c) are not part of
+  this source tree, so the tools are linked with stand-ins of the same
+  name, generated from the 8x8 fonts in u8x8_fonts.c:
+
+    u8g2_font_8x13_t_symbols	u8x8_font_amstrad_cpc_extended_f, 32..255,
+		rows 2 and 5 doubled (10 pixel), the arrows, math
+		operators, box drawing, shapes and symbols of the unicode
+		range use the glyphs 128..255 of u8x8_font_pxplusibmcga_f
+    u8g2_font_5x7_tr	u8x8_font_5x7_f, 32..127
+
+  Only the shape of the glyphs differs from the release fonts. The golden
+  images of render_bench are made with these fonts.
+
+  Build and run (from this directory, build.sh does the same):
+    cc -O2 -I../../src/clib font_gen.c ../../src/clib/u8x8_fonts.c -o font_gen
+    ./font_gen > host_fonts.c
+
+*/
+
+#include "u8x8.h"
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_GLYPHS 1280
+#define MAX_FONT (32*1024)
+#define MAX_ROWS 10
+
+struct glyph_struct
+{
+  uint16_t encoding;
+  uint8_t w, h;
+  int8_t x, y, d;
+  uint8_t pixel[8*MAX_ROWS];	/* w*h pixel of the bounding box, row by row */
+};
+
+struct range_struct
+{
+  uint16_t first, last;
+};
+
+struct font_struct
+{
+  const char *name;
+  const uint8_t *u8x8_font;	/* glyphs 0..255 */
+  uint16_t first, last;
+  const uint8_t *row_map;	/* row_cnt rows of the glyph, taken from these rows of the 8x8 tile */
+  uint8_t row_cnt;
+  uint8_t baseline;		/* last row above the baseline */
+  int8_t delta_x;
+  uint8_t max_char_width, max_char_height;
+  int8_t y_offset;
+  const uint8_t *unicode_font;	/* glyphs 128..255 are used for the unicode ranges */
+  const struct range_struct *unicode_ranges;
+};
+
+static const uint8_t row_map_10[10] = { 0, 1, 2, 2, 3, 4, 5, 5, 6, 7 };
+static const uint8_t row_map_8[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+static const struct range_struct symbol_ranges[] =
+{
+  { 0x2190, 0x21ff },
+  { 0x2200, 0x22ff },
+  { 0x2500, 0x257f },
+  { 0x25a0, 0x25ff },
+  { 0x2600, 0x26ff },
+  { 0, 0 }
+};
+
+static const struct font_struct fonts[] =
+{
+  { "u8g2_font_8x13_t_symbols", u8x8_font_amstrad_cpc_extended_f, 32, 255, row_map_10, 10, 7, 8, 8, 13, -2, u8x8_font_pxplusibmcga_f, symbol_ranges },
+  { "u8g2_font_5x7_tr", u8x8_font_5x7_f, 32, 127, row_map_8, 8, 6, 5, 5, 8, -1, NULL, NULL }
+};
+
+static struct glyph_struct glyphs[MAX_GLYPHS];
+static int glyph_cnt;
+
+static uint8_t bits_per_0, bits_per_1;
+static uint8_t bits_per_w, bits_per_h, bits_per_x, bits_per_y, bits_per_d;
+
+/*============================================*/
+/* glyphs */
+
+static int get_tile_pixel(const uint8_t *u8x8_font, uint16_t encoding, uint8_t x, uint8_t y)
+{
+  const uint8_t *tile;
+  if ( encoding < u8x8_font[0] || encoding > u8x8_font[1] )
+    return 0;
+  tile = u8x8_font + 2 + (encoding - u8x8_font[0])*8;
+  return (tile[x] >> y) & 1;
+}
+
+/* crop the 8 x row_cnt cell to the bounding box of the pixel */
+static void add_glyph(const struct font_struct *f, uint16_t encoding, const uint8_t *u8x8_font, uint16_t tile)
+{
+  struct glyph_struct *g = glyphs + glyph_cnt++;
+  int x, y, x0 = 8, x1 = -1, y0 = MAX_ROWS, y1 = -1;
+
+  for( y = 0; y < f->row_cnt; y++ )
+    for( x = 0; x < 8; x++ )
+      if ( get_tile_pixel(u8x8_font, tile, x, f->row_map[y]) )
+      {
+        if ( x < x0 ) x0 = x;
+        if ( x > x1 ) x1 = x;
+        if ( y < y0 ) y0 = y;
+        if ( y > y1 ) y1 = y;
+      }
+
+  g->encoding = encoding;
+  g->d = f->delta_x;
+  if ( x1 < 0 )
+  {
+    g->w = 0; g->h = 0; g->x = 0; g->y = 0;
+    return;
+  }
+  g->w = x1 - x0 + 1;
+  g->h = y1 - y0 + 1;
+  g->x = x0;
+  g->y = f->baseline - y1;
+  for( y = y0; y <= y1; y++ )
+    for( x = x0; x <= x1; x++ )
+      g->pixel[(y-y0)*g->w + x-x0] = get_tile_pixel(u8x8_font, tile, x, f->row_map[y]);
+}
+
+static void add_glyphs(const struct font_struct *f)
+{
+  const struct range_struct *r;
+  uint16_t e, k = 0;
+
+  glyph_cnt = 0;
+  for( e = f->first; e <= f->last; e++ )
+    add_glyph(f, e, f->u8x8_font, e);
+  if ( f->unicode_ranges == NULL )
+    return;
+  for( r = f->unicode_ranges; r->first != 0; r++ )
+    for( e = r->first; e <= r->last; e++ )
+    {
+      add_glyph(f, e, f->unicode_font, 128 + (k & 127));
+      k++;
+    }
+}
+
+static struct glyph_struct *find_glyph(uint16_t encoding)
+{
+  int i;
+  for( i = 0; i < glyph_cnt; i++ )
+    if ( glyphs[i].encoding == encoding )
+      return glyphs+i;
+  return glyphs;
+}
+
+/*============================================*/
+/* bit stream, LSB first, see u8g2_font_decode_get_unsigned_bits() */
+
+static uint8_t stream[MAX_FONT];
+static int stream_len;
+static int stream_bit_pos;
+
+static void stream_start(void)
+{
+  stream_len = 0;
+  stream_bit_pos = 0;
+}
+
+static void stream_put(unsigned v, uint8_t cnt)
+{
+  uint8_t i;
+  for( i = 0; i < cnt; i++ )
+  {
+    if ( stream_bit_pos == 0 )
+      stream[stream_len++] = 0;
+    if ( (v >> i) & 1 )
+      stream[stream_len-1] |= 1 << stream_bit_pos;
+    stream_bit_pos = (stream_bit_pos + 1) & 7;
+  }
+}
+
+static uint8_t get_unsigned_bits(unsigned v)
+{
+  uint8_t n = 1;
+  while( (1U << n) <= v )
+    n++;
+  return n;
+}
+
+static int is_signed_fit(int v, uint8_t n)
+{
+  v += 1 << (n-1);
+  return v >= 0 && v < (1 << n);
+}
+
+/*============================================*/
+/* run length encoding, see u8g2_font_decode_glyph() */
+
+/* pairs of 0 and 1 runs, the maximum length is (1<<bits)-1 */
+static int get_runs(const struct glyph_struct *g, uint8_t b0, uint8_t b1, uint8_t *r0, uint8_t *r1)
+{
+  int i = 0, n = g->w * g->h, cnt = 0;
+  int z, o;
+  int m0 = (1 << b0) - 1, m1 = (1 << b1) - 1;
+
+  while( i < n )
+  {
+    z = 0;
+    while( i < n && g->pixel[i] == 0 )
+      z++, i++;
+    o = 0;
+    while( i < n && g->pixel[i] != 0 )
+      o++, i++;
+    while( z > m0 )
+    {
+      r0[cnt] = m0; r1[cnt] = 0; cnt++;
+      z -= m0;
+    }
+    while( o > m1 )
+    {
+      r0[cnt] = z; r1[cnt] = m1; cnt++;
+      z = 0;
+      o -= m1;
+    }
+    r0[cnt] = z; r1[cnt] = o; cnt++;
+  }
+  return cnt;
+}
+
+/* write the glyph to the stream, returns the number of bytes */
+static int encode_glyph(const struct glyph_struct *g, uint8_t b0, uint8_t b1)
+{
+  uint8_t r0[8*MAX_ROWS*2], r1[8*MAX_ROWS*2];
+  int i, j, cnt;
+
+  stream_start();
+  stream_put(g->w, bits_per_w);
+  stream_put(g->h, bits_per_h);
+  stream_put(g->x + (1 << (bits_per_x-1)), bits_per_x);
+  stream_put(g->y + (1 << (bits_per_y-1)), bits_per_y);
+  stream_put(g->d + (1 << (bits_per_d-1)), bits_per_d);
+  if ( g->w == 0 )
+    return stream_len;
+  cnt = get_runs(g, b0, b1, r0, r1);
+  for( i = 0; i < cnt; i = j+1 )
+  {
+    j = i;
+    while( j+1 < cnt && r0[j+1] == r0[i] && r1[j+1] == r1[i] )
+      j++;
+    stream_put(r0[i], b0);
+    stream_put(r1[i], b1);
+    /* one bit for each repetition of the pair */
+    for( ; i < j; i++ )
+      stream_put(1, 1);
+    stream_put(0, 1);
+  }
+  return stream_len;
+}
+
+static void calc_bits(void)
+{
+  uint8_t w = 0, h = 0;
+  int i, total, best = -1;
+  uint8_t b0, b1;
+
+  for( i = 0; i < glyph_cnt; i++ )
+  {
+    if ( glyphs[i].w > w ) w = glyphs[i].w;
+    if ( glyphs[i].h > h ) h = glyphs[i].h;
+  }
+  bits_per_w = get_unsigned_bits(w);
+  bits_per_h = get_unsigned_bits(h);
+
+  for( bits_per_x = 2; ; bits_per_x++ )
+  {
+    for( i = 0; i < glyph_cnt; i++ )
+      if ( is_signed_fit(glyphs[i].x, bits_per_x) == 0 )
+        break;
+    if ( i == glyph_cnt )
+      break;
+  }
+  for( bits_per_y = 2; ; bits_per_y++ )
+  {
+    for( i = 0; i < glyph_cnt; i++ )
+      if ( is_signed_fit(glyphs[i].y, bits_per_y) == 0 )
+        break;
+    if ( i == glyph_cnt )
+      break;
+  }
+  for( bits_per_d = 2; ; bits_per_d++ )
+  {
+    for( i = 0; i < glyph_cnt; i++ )
+      if ( is_signed_fit(glyphs[i].d, bits_per_d) == 0 )
+        break;
+    if ( i == glyph_cnt )
+      break;
+  }
+
+  /* run length bits with the smallest font */
+  for( b0 = 2; b0 <= 6; b0++ )
+    for( b1 = 1; b1 <= 5; b1++ )
+    {
+      total = 0;
+      for( i = 0; i < glyph_cnt; i++ )
+        total += encode_glyph(glyphs+i, b0, b1);
+      if ( best < 0 || total < best )
+      {
+        best = total;
+        bits_per_0 = b0;
+        bits_per_1 = b1;
+      }
+    }
+}
+
+/*============================================*/
+/* font, see u8g2_read_font_info() */
+
+static uint8_t font[MAX_FONT];
+static int font_len;
+
+static void font_put(uint8_t v)
+{
+  font[font_len++] = v;
+}
+
+static void write_font(const struct font_struct *f)
+{
+  struct glyph_struct *g;
+  int i, len, body;
+  int pos_A = -1, pos_a = -1, pos_unicode;
+
+  add_glyphs(f);
+  calc_bits();
+
+  /* the header is written after the glyphs */
+  font_len = 23;
+  body = font_len;
+  for( i = 0; i < glyph_cnt && glyphs[i].encoding <= 255; i++ )
+  {
+    if ( glyphs[i].encoding >= 'A' && pos_A < 0 )
+      pos_A = font_len - body;
+    if ( glyphs[i].encoding >= 'a' && pos_a < 0 )
+      pos_a = font_len - body;
+    len = encode_glyph(glyphs+i, bits_per_0, bits_per_1);
+    font_put(glyphs[i].encoding);
+    font_put(len+2);
+    memcpy(font+font_len, stream, len);
+    font_len += len;
+  }
+  font_put(0);
+  font_put(0);
+  pos_unicode = font_len - body;
+  for( ; i < glyph_cnt; i++ )
+  {
+    len = encode_glyph(glyphs+i, bits_per_0, bits_per_1);
+    font_put(glyphs[i].encoding >> 8);
+    font_put(glyphs[i].encoding & 255);
+    font_put(len+3);
+    memcpy(font+font_len, stream, len);
+    font_len += len;
+  }
+  font_put(0);
+  font_put(0);
+
+  font[0] = glyph_cnt;
+  font[1] = 0;
+  font[2] = bits_per_0;
+  font[3] = bits_per_1;
+  font[4] = bits_per_w;
+  font[5] = bits_per_h;
+  font[6] = bits_per_x;
+  font[7] = bits_per_y;
+  font[8] = bits_per_d;
+  font[9] = f->max_char_width;
+  font[10] = f->max_char_height;
+  font[11] = 0;
+  font[12] = (uint8_t)f->y_offset;
+  g = find_glyph('A');
+  font[13] = g->h + g->y;
+  g = find_glyph('g');
+  font[14] = (uint8_t)g->y;
+  g = find_glyph('(');
+  font[15] = g->h + g->y;
+  font[16] = (uint8_t)g->y;
+  font[17] = pos_A >> 8;
+  font[18] = pos_A & 255;
+  font[19] = pos_a >> 8;
+  font[20] = pos_a & 255;
+  font[21] = pos_unicode >> 8;
+  font[22] = pos_unicode & 255;
+
+  printf("const uint8_t %s[%d] U8G2_FONT_SECTION(\"%s\") = {\n", f->name, font_len, f->name);
+  for( i = 0; i < font_len; i++ )
+    printf("%d%s", font[i], (i % 16 == 15 || i == font_len-1) ? ",\n" : ",");
+  printf("};\n");
+}
+
+int main(void)
+{
+  unsigned i;
+  printf("/* generated by font_gen.c, stand-ins for the fonts of u8g2_fonts.c */\n");
+  printf("#include \"u8g2.h\"\n");
+  for( i = 0; i < sizeof(fonts)/sizeof(*fonts); i++ )
+    write_font(fonts+i);
+  return 0;
+}
@@ -0,0 +1,167 @@
+/*
+
+  glyph_cache_bench.c
+
+  Glyphs per second for text screens with u8g2_font_8x13_t_symbols on the
+  ST7920 page buffer (st7920_s_128x64_1), without and with the glyph cache
+  (u8g2_SetGlyphCache()). The display is not connected, so only the
+  rendering into the tile buffer is measured.
+  The 512 byte cache is smaller than the glyphs of the screen: each glyph
+  is removed before it is used again on the next page.
+  Before the measurement, text in all font directions, rotations, colors
+  and font modes is drawn with and without the cache into the full 
+  buffers of the ST7920 and the SSD1306, the buffers must be equal.
+
+  The u8g2 fonts of the release are not part of this source tree,
+  u8g2_font_8x13_t_symbols is created by font_gen.c from the u8x8 fonts.
+
+  Build and run (from this directory):
+    ./build.sh
+    build/glyph_cache_bench
+
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef U8G2_WITH_GLYPH_CACHE
+#error "U8G2_WITH_GLYPH_CACHE is required"
+#endif
+
+#define FRAMES 2000
+
+extern const uint8_t u8g2_font_8x13_t_symbols[];
+
+/* 16 glyphs per line, 5 lines */
+static const char *screen[] =
+{
+  "Preset 12  \xe2\x86\x90 \xe2\x86\x92 ",
+  "Gain   [\xe2\x96\xa0\xe2\x96\xa0\xe2\x96\xa0\xe2\x96\xa1\xe2\x96\xa1]  ",
+  "Delay  350ms \xe2\x99\xaa  ",
+  "Mix    42%  18\xc2\xb0" "C",
+  "\xe2\x96\xb2 Edit   \xe2\x96\xbc Save  "
+};
+
+#define SCREEN_LINES (sizeof(screen)/sizeof(*screen))
+
+static u8g2_t u8g2;
+static uint8_t glyph_cache[2048];
+
+static uint8_t byte_none(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static uint8_t gpio_and_delay_none(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static void draw(uint16_t frame)
+{
+  uint8_t i;
+  
+  for( i = 0; i < SCREEN_LINES; i++ )
+    u8g2_DrawUTF8(&u8g2, 0, 12+i*13, screen[i]);
+  /* a changing value */
+  u8g2_DrawGlyph(&u8g2, 120, 12, '0' + frame % 10);
+}
+
+typedef void (*setup_cb)(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+
+/* draw the same random text without and with the cache, returns the number of different frames */
+static unsigned check_setup(const char *name, setup_cb setup, const u8g2_cb_t *rotation, unsigned seed)
+{
+  static uint8_t buf[2][1024];
+  unsigned frame, diff = 0;
+  uint8_t pass, i;
+  
+  for( frame = 0; frame < 300; frame++ )
+  {
+    for( pass = 0; pass < 2; pass++ )
+    {
+      setup(&u8g2, rotation, byte_none, gpio_and_delay_none);
+      u8g2_InitDisplay(&u8g2);
+      u8g2_SetGlyphCache(&u8g2, pass == 0 ? NULL : glyph_cache, 512);
+      u8g2_SetFont(&u8g2, u8g2_font_8x13_t_symbols);
+      u8g2_ClearBuffer(&u8g2);
+      srand(seed + frame);
+      for( i = 0; i < 6; i++ )
+      {
+	u8g2_SetFontDirection(&u8g2, rand() & 3);
+	u8g2_SetFontMode(&u8g2, rand() & 1);
+	u8g2_SetDrawColor(&u8g2, rand() % 3);
+	u8g2_DrawUTF8(&u8g2, rand() % 160 - 16, rand() % 96 - 16, screen[rand() % SCREEN_LINES]);
+      }
+      memcpy(buf[pass], u8g2_GetBufferPtr(&u8g2), 1024);
+    }
+    if ( memcmp(buf[0], buf[1], 1024) != 0 )
+      diff++;
+  }
+  if ( diff != 0 )
+    printf("%s: %u of 300 frames differ\n", name, diff);
+  return diff;
+}
+
+static unsigned check(void)
+{
+  static const u8g2_cb_t *rotation[] = { U8G2_R0, U8G2_R1, U8G2_R2, U8G2_R3, U8G2_MIRROR };
+  static const char *rotation_name[] = { "R0", "R1", "R2", "R3", "MIRROR" };
+  char name[32];
+  unsigned diff = 0;
+  uint8_t r;
+  
+  for( r = 0; r < 5; r++ )
+  {
+    sprintf(name, "st7920 %s", rotation_name[r]);
+    diff += check_setup(name, u8g2_Setup_st7920_s_128x64_f, rotation[r], r*1000);
+    sprintf(name, "ssd1306 %s", rotation_name[r]);
+    diff += check_setup(name, u8g2_Setup_ssd1306_128x64_noname_f, rotation[r], r*1000);
+  }
+  return diff;
+}
+
+static double bench(const char *name, uint16_t cache_size)
+{
+  clock_t start, end;
+  double glyphs_per_second;
+  uint16_t frame;
+  
+  u8g2_Setup_st7920_s_128x64_1(&u8g2, U8G2_R0, byte_none, gpio_and_delay_none);
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+  u8g2_SetGlyphCache(&u8g2, cache_size == 0 ? NULL : glyph_cache, cache_size);
+  u8g2_SetFont(&u8g2, u8g2_font_8x13_t_symbols);
+  
+  start = clock();
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    u8g2_FirstPage(&u8g2);
+    do
+    {
+      draw(frame);
+    } while( u8g2_NextPage(&u8g2) );
+  }
+  end = clock();
+  
+  glyphs_per_second = (double)FRAMES * (SCREEN_LINES*16 + 1) * CLOCKS_PER_SEC / (double)(end - start);
+  printf("%-16s %10.0f glyphs/s  hit %8lu  miss %6lu\n", name, glyphs_per_second,
+    u8g2.glyph_cache.hit_cnt, u8g2.glyph_cache.miss_cnt);
+  return glyphs_per_second;
+}
+
+int main(void)
+{
+  double none, cached;
+  
+  if ( check() != 0 )
+    return 1;
+  none = bench("no cache", 0);
+  bench("cache 512 bytes", 512);
+  cached = bench("cache 2048 bytes", sizeof(glyph_cache));
+  printf("speedup %.2f\n", cached / none);
+  return 0;
+}
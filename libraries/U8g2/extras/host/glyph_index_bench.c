@@ -0,0 +1,120 @@
+/*
+
+  glyph_index_bench.c
+
+  Glyph lookups per second for u8g2_font_8x13_t_symbols, without and with
+  the glyph position table (u8g2_SetGlyphIndex()). Before the measurement,
+  the result of the indexed lookup is compared with the linear search for
+  all 65536 encodings.
+
+  The u8g2 fonts of the release are not part of this source tree,
+  u8g2_font_8x13_t_symbols is created by font_gen.c from the u8x8 fonts.
+
+  Build and run (from this directory):
+    ./build.sh
+    build/glyph_index_bench
+
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <time.h>
+
+#ifndef U8G2_WITH_GLYPH_INDEX
+#error "U8G2_WITH_GLYPH_INDEX is required"
+#endif
+
+#define ROUNDS 20000
+
+extern const uint8_t u8g2_font_8x13_t_symbols[];
+
+/* u8g2_font.c, not declared in u8g2.h */
+const uint8_t *u8g2_font_get_glyph_data(u8g2_t *u8g2, uint16_t encoding);
+
+/* glyphs of a status screen */
+static const uint16_t encodings[] =
+{
+  'P', 'r', 'e', 's', 't', ' ', '1', '2', 'G', 'a', 'i', 'n', 'D', 'l', 'y', 
+  'M', 'x', '%', 'E', 'd', 'S', 'v', 0x0b0,
+  0x2190, 0x2192, 0x25a0, 0x25a1, 0x25b2, 0x25bc, 0x266a
+};
+
+#define ENCODING_CNT (sizeof(encodings)/sizeof(*encodings))
+
+static u8g2_t u8g2;
+static uint16_t glyph_index[2048];
+
+static uint8_t byte_none(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static uint8_t gpio_and_delay_none(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static const uint8_t *linear[65536];
+
+static uint8_t check(uint16_t cnt)
+{
+  uint32_t e;
+  uint16_t errors = 0;
+  
+  u8g2_SetGlyphIndex(&u8g2, NULL, 0);
+  for( e = 0; e < 65536; e++ )
+    linear[e] = u8g2_font_get_glyph_data(&u8g2, e);
+  
+  u8g2_SetGlyphIndex(&u8g2, glyph_index, cnt);
+  for( e = 0; e < 65536; e++ )
+    if ( u8g2_font_get_glyph_data(&u8g2, e) != linear[e] )
+      errors++;
+  
+  if ( errors != 0 )
+    printf("index %u words: %u lookup errors\n", cnt, errors);
+  return errors != 0;
+}
+
+static void bench(const char *name, uint16_t cnt)
+{
+  clock_t start, end;
+  uint16_t round;
+  uint8_t i;
+  unsigned long found = 0;
+  
+  u8g2_SetGlyphIndex(&u8g2, cnt == 0 ? NULL : glyph_index, cnt);
+  
+  start = clock();
+  for( round = 0; round < ROUNDS; round++ )
+    for( i = 0; i < ENCODING_CNT; i++ )
+      if ( u8g2_font_get_glyph_data(&u8g2, encodings[i]) != NULL )
+	found++;
+  end = clock();
+  
+  printf("%-18s step %3u  %10.0f lookups/s  found %lu\n", name, u8g2.glyph_index.unicode_step, 
+    (double)ROUNDS * ENCODING_CNT * CLOCKS_PER_SEC / (double)(end - start), found);
+}
+
+int main(void)
+{
+  uint8_t errors = 0;
+  
+  u8g2_Setup_st7920_s_128x64_1(&u8g2, U8G2_R0, byte_none, gpio_and_delay_none);
+  u8g2_SetFont(&u8g2, u8g2_font_8x13_t_symbols);
+  
+  errors += check(256);
+  errors += check(300);
+  errors += check(512);
+  errors += check(sizeof(glyph_index)/sizeof(*glyph_index));
+  
+  bench("no index", 0);
+  bench("index 512 words", 512);
+  bench("index 2048 words", sizeof(glyph_index)/sizeof(*glyph_index));
+  
+  if ( errors != 0 )
+  {
+    puts("FAILED");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,120 @@
+/*
+
+  gpio_count.c
+
+  Number of GPIO and delay requests per frame of the software SPI byte
+  procedure (u8x8_byte_4wire_sw_spi) for the ST7920 modes.
+  Rerun after changes in the byte, CAD or display layer and compare the
+  output with the previous numbers.
+  The second table compares the CPU time per frame (drawing, display and 
+  CAD layer, with a byte procedure which only counts the bytes like a 
+  hardware SPI with DMA) with the wire time at the SPI clock of the 
+  display. The CPU time is measured on the host, not on the target.
+
+  Build and run (from this directory):
+    cc -DU8X8_WITH_GPIO_COUNT -I../../src/clib gpio_count.c ../../src/clib/u8[gx]*.c -o gpio_count
+    ./gpio_count
+
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <time.h>
+
+#ifndef U8X8_WITH_GPIO_COUNT
+#error "U8X8_WITH_GPIO_COUNT is required"
+#endif
+
+#define FRAMES 16
+#define TIMED_FRAMES 2000
+
+typedef void (*setup_cb)(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+
+static u8g2_t u8g2;
+static uint8_t shadow[U8X8_ST7920_128X64_SHADOW_SIZE];
+
+static unsigned long wire_bytes;
+
+static uint8_t byte_count(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  if ( msg == U8X8_MSG_BYTE_SEND )
+    wire_bytes += arg_int;
+  return 1;
+}
+
+static uint8_t gpio_and_delay_none(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+/* a mostly static screen with a moving bar */
+static void draw(uint8_t frame)
+{
+  u8g2_DrawFrame(&u8g2, 0, 0, 128, 64);
+  u8g2_DrawFrame(&u8g2, 2, 2, 60, 28);
+  u8g2_DrawFrame(&u8g2, 66, 2, 60, 28);
+  u8g2_DrawBox(&u8g2, 4, 40, frame*7, 8);
+}
+
+static void count(const char *name, setup_cb setup)
+{
+  u8x8_t *u8x8 = u8g2_GetU8x8(&u8g2);
+  unsigned long init_cnt;
+  uint8_t frame;
+
+  setup(&u8g2, U8G2_R0, u8x8_byte_4wire_sw_spi, gpio_and_delay_none);
+  u8x8_SetDisplayShadow(u8x8, shadow);	/* only used by the dirty_f display */
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+  init_cnt = u8x8->gpio_cnt;
+  u8x8->gpio_cnt = 0;
+
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    u8g2_FirstPage(&u8g2);
+    do
+    {
+      draw(frame);
+    } while( u8g2_NextPage(&u8g2) );
+  }
+  printf("%-24s init %8lu  frame %8lu\n", name, init_cnt, u8x8->gpio_cnt / FRAMES);
+}
+
+static void cpu_and_wire(const char *name, setup_cb setup)
+{
+  clock_t start, end;
+  double cpu_us, wire_us;
+  uint16_t frame;
+
+  setup(&u8g2, U8G2_R0, byte_count, gpio_and_delay_none);
+  u8x8_SetDisplayShadow(u8g2_GetU8x8(&u8g2), shadow);
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+  wire_bytes = 0;
+
+  start = clock();
+  for( frame = 0; frame < TIMED_FRAMES; frame++ )
+  {
+    u8g2_FirstPage(&u8g2);
+    do
+    {
+      draw(frame % FRAMES);
+    } while( u8g2_NextPage(&u8g2) );
+  }
+  end = clock();
+  cpu_us = (double)(end - start) * 1e6 / CLOCKS_PER_SEC / TIMED_FRAMES;
+  wire_us = (double)wire_bytes * 8 * 1e6 / u8g2_GetU8x8(&u8g2)->display_info->sck_clock_hz / TIMED_FRAMES;
+  printf("%-24s cpu %8.1f us  wire %8.1f us\n", name, cpu_us, wire_us);
+}
+
+int main(void)
+{
+  count("st7920_s_128x64_1", u8g2_Setup_st7920_s_128x64_1);
+  count("st7920_s_128x64_2", u8g2_Setup_st7920_s_128x64_2);
+  count("st7920_s_128x64_f", u8g2_Setup_st7920_s_128x64_f);
+  count("st7920_s_128x64_dirty_f", u8g2_Setup_st7920_s_128x64_dirty_f);
+  cpu_and_wire("st7920_s_128x64_1", u8g2_Setup_st7920_s_128x64_1);
+  cpu_and_wire("st7920_s_128x64_f", u8g2_Setup_st7920_s_128x64_f);
+  cpu_and_wire("st7920_s_128x64_dirty_f", u8g2_Setup_st7920_s_128x64_dirty_f);
+  return 0;
+}
@@ -0,0 +1,225 @@
+/*
+
+  kerning_bench.c
+
+  Kerning lookups and kerned labels per second, without and with the
+  sorted pair table (u8g2_SetKerningIndex()) for the pair list of 
+  u8g2_DrawExtUTF8(). The u8g2_kerning_t tables of u8g2_DrawExtendedUTF8()
+  are not indexed, they are measured for comparison.
+
+  The kerning pairs are generated in the style of a proportional text font
+  (capitals, lower case letters and punctuation, about 450 pairs). Before
+  the measurement, the indexed lookup is compared with the linear search
+  for all pairs of the encodings 0..383, also with an index which is too
+  small for the table.
+
+  The u8g2 fonts of the release are not part of this source tree,
+  u8g2_font_8x13_t_symbols is created by font_gen.c from the u8x8 fonts.
+
+  Build and run (from this directory):
+    ./build.sh
+    build/kerning_bench
+
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef U8G2_WITH_KERNING_INDEX
+#error "U8G2_WITH_KERNING_INDEX is required"
+#endif
+
+#define ROUNDS 2000
+#define CHECK_CNT 384
+#define MAX_PAIRS 600
+
+extern const uint8_t u8g2_font_8x13_t_symbols[];
+
+/* encodings with kerning, first and second glyph of a pair */
+static const char first_glyphs[] = "AFLPTVWYKRafkrtvwy.,-'\"";
+static const char second_glyphs[] = "AJTVWYacdegmnoqsuvwy.,-";
+
+/* long labels of the pedal menus */
+static const char *labels[] =
+{
+  "Tap Tempo: Y-Axis Wave Velocity",
+  "AVA WAVY TYPO Valve, Fader \"Yaw\"",
+  "Tremolo Rate / Delay Feedback",
+  "Favorite Preset: Warm Overdrive"
+};
+
+#define LABEL_CNT (sizeof(labels)/sizeof(*labels))
+
+static u8g2_t u8g2;
+
+/* pair list: e1, e2, value, terminated by 0x0ffff */
+static uint16_t pair_table[MAX_PAIRS*3+1];
+
+/* the same pairs as u8g2_kerning_t */
+static uint16_t first_encoding_table[sizeof(first_glyphs)+1];
+static uint16_t index_to_second_table[sizeof(first_glyphs)+1];
+static uint16_t second_encoding_table[MAX_PAIRS];
+static uint8_t kerning_values[MAX_PAIRS];
+static u8g2_kerning_t kerning;
+
+static uint16_t kerning_index[MAX_PAIRS*3];
+
+static uint8_t byte_none(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static uint8_t gpio_and_delay_none(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static uint8_t pair_value(uint16_t e1, uint16_t e2)
+{
+  return (e1 * 7 + e2 * 3) % 4 + 1;
+}
+
+static void build_tables(void)
+{
+  uint16_t i, j, n;
+
+  /* the pair list is created with the second glyph in the outer loop, so it is not sorted */
+  n = 0;
+  for( j = 0; second_glyphs[j] != '\0'; j++ )
+    for( i = 0; first_glyphs[i] != '\0'; i++ )
+    {
+      pair_table[n*3] = (uint8_t)first_glyphs[i];
+      pair_table[n*3+1] = (uint8_t)second_glyphs[j];
+      pair_table[n*3+2] = pair_value(first_glyphs[i], second_glyphs[j]);
+      n++;
+    }
+  pair_table[n*3] = 0x0ffff;
+
+  n = 0;
+  for( i = 0; first_glyphs[i] != '\0'; i++ )
+  {
+    first_encoding_table[i] = (uint8_t)first_glyphs[i];
+    index_to_second_table[i] = n;
+    for( j = 0; second_glyphs[j] != '\0'; j++ )
+    {
+      second_encoding_table[n] = (uint8_t)second_glyphs[j];
+      kerning_values[n] = pair_value(first_glyphs[i], second_glyphs[j]);
+      n++;
+    }
+  }
+  first_encoding_table[i] = 0x0ffff;
+  index_to_second_table[i] = n;
+  kerning.first_table_cnt = i+1;
+  kerning.second_table_cnt = n;
+  kerning.first_encoding_table = first_encoding_table;
+  kerning.index_to_second_table = index_to_second_table;
+  kerning.second_encoding_table = second_encoding_table;
+  kerning.kerning_values = kerning_values;
+}
+
+static uint8_t linear_table[CHECK_CNT][CHECK_CNT];
+
+static uint8_t check(uint16_t cnt)
+{
+  uint16_t e1, e2;
+  unsigned long errors = 0;
+
+  u8g2_SetKerningIndex(&u8g2, NULL, 0);
+  for( e1 = 0; e1 < CHECK_CNT; e1++ )
+    for( e2 = 0; e2 < CHECK_CNT; e2++ )
+      linear_table[e1][e2] = u8g2_GetKerningByTable(&u8g2, pair_table, e1, e2);
+
+  u8g2_SetKerningIndex(&u8g2, kerning_index, cnt);
+  for( e1 = 0; e1 < CHECK_CNT; e1++ )
+    for( e2 = 0; e2 < CHECK_CNT; e2++ )
+      if ( u8g2_GetKerningByTable(&u8g2, pair_table, e1, e2) != linear_table[e1][e2] )
+	errors++;
+
+  if ( errors != 0 )
+    printf("index %u words: %lu lookup errors\n", cnt, errors);
+  return errors != 0;
+}
+
+static void bench(const char *name, uint16_t cnt)
+{
+  clock_t start, end;
+  uint16_t round;
+  uint8_t i;
+  const char *s;
+  unsigned long sum = 0;
+  unsigned long lookups = 0;
+  double table_time, kerning_time;
+
+  u8g2_SetKerningIndex(&u8g2, cnt == 0 ? NULL : kerning_index, cnt);
+
+  /* pure lookups for all neighbour pairs of the labels */
+  start = clock();
+  for( round = 0; round < ROUNDS; round++ )
+    for( i = 0; i < LABEL_CNT; i++ )
+      for( s = labels[i]; s[1] != '\0'; s++ )
+      {
+	sum += u8g2_GetKerningByTable(&u8g2, pair_table, (uint8_t)s[0], (uint8_t)s[1]);
+	lookups++;
+      }
+  end = clock();
+  table_time = (double)(end - start) / CLOCKS_PER_SEC;
+
+  start = clock();
+  for( round = 0; round < ROUNDS; round++ )
+    for( i = 0; i < LABEL_CNT; i++ )
+      for( s = labels[i]; s[1] != '\0'; s++ )
+	sum += u8g2_GetKerning(&u8g2, &kerning, (uint8_t)s[0], (uint8_t)s[1]);
+  end = clock();
+  kerning_time = (double)(end - start) / CLOCKS_PER_SEC;
+
+  printf("%-18s pair list %10.0f lookups/s  u8g2_kerning_t %10.0f lookups/s\n", name,
+    (double)lookups / table_time, (double)lookups / kerning_time);
+
+  /* complete labels, including glyph drawing */
+  start = clock();
+  for( round = 0; round < ROUNDS/10; round++ )
+    for( i = 0; i < LABEL_CNT; i++ )
+    {
+      u8g2_ClearBuffer(&u8g2);
+      sum += u8g2_DrawExtUTF8(&u8g2, 0, 20, 0, pair_table, labels[i]);
+    }
+  end = clock();
+  table_time = (double)(end - start) / CLOCKS_PER_SEC;
+
+  start = clock();
+  for( round = 0; round < ROUNDS/10; round++ )
+    for( i = 0; i < LABEL_CNT; i++ )
+    {
+      u8g2_ClearBuffer(&u8g2);
+      sum += u8g2_DrawExtendedUTF8(&u8g2, 0, 20, 0, &kerning, labels[i]);
+    }
+  end = clock();
+  kerning_time = (double)(end - start) / CLOCKS_PER_SEC;
+
+  printf("%-18s DrawExtUTF8 %8.0f labels/s  DrawExtendedUTF8 %8.0f labels/s  (sum %lu)\n", name,
+    (double)ROUNDS/10 * LABEL_CNT / table_time, (double)ROUNDS/10 * LABEL_CNT / kerning_time, sum);
+}
+
+int main(void)
+{
+  uint8_t errors = 0;
+
+  build_tables();
+  u8g2_Setup_st7920_s_128x64_f(&u8g2, U8G2_R0, byte_none, gpio_and_delay_none);
+  u8g2_SetFont(&u8g2, u8g2_font_8x13_t_symbols);
+
+  errors += check(30);
+  errors += check(sizeof(kerning_index)/sizeof(*kerning_index));
+
+  bench("no index", 0);
+  bench("index", sizeof(kerning_index)/sizeof(*kerning_index));
+
+  if ( errors != 0 )
+  {
+    puts("FAILED");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,422 @@
+/*
+
+  render_bench.c
+
+  Render benchmark for the pedal screens on the ST7920 (128x64, serial).
+  Each screen is rendered in all buffer modes. The modes 1_dl and 2_dl 
+  render the page buffer with u8g2_RenderStep() and a display list (see 
+  u8g2_SetDisplayList()), the modes d and dirty_d use the full buffer with 
+  a front buffer (see u8g2_SetFrontBuffer()). The modes with the suffix _g 
+  put the lines, bars and gauges of the screens into groups (see 
+  u8g2_BeginGroup()), which are skipped on pages outside of the group. 
+  For each combination the tool reports:
+    - CPU time per frame for drawing and transfer (byte procedure without output)
+    - bytes on the wire per frame
+    - number of pixels which differ from the golden image
+
+  The display content is reconstructed from the captured command and data
+  stream by st7920_capture.c, so the output of the display driver, the
+  CAD and the buffer handling is included in the comparison.
+
+  Golden images are PBM files, one for each screen: <golden_dir>/<screen>.pbm
+  The images in golden/ of this directory are made with the fonts of 
+  font_gen.c. Create them again with a known good version of the library:
+    build/render_bench -g [golden_dir]
+  and compare later versions:
+    build/render_bench [golden_dir]
+  The default golden_dir is "golden". If an image differs, the captured 
+  image is written to the current directory as <screen>_<mode>.pbm.
+  -g creates golden_dir if it does not exist.
+  The exit code is 1 if any image differs or is missing, if a golden 
+  image could not be written or if the captured data stream has 
+  protocol errors.
+
+  The u8g2 fonts of the release are not part of this source tree,
+  u8g2_font_8x13_t_symbols is created by font_gen.c from the u8x8 fonts.
+
+  Build and run (from this directory):
+    ./build.sh
+    build/render_bench
+
+*/
+
+#include "u8g2.h"
+#include "st7920_capture.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#define FRAMES 64
+#define TIMED_FRAMES 2000
+#define DISPLAY_LIST_SIZE 1024
+
+/* capture() results other than the number of differences */
+#define CAPTURE_MISSING -1
+#define CAPTURE_FAILED -2
+
+extern const uint8_t u8g2_font_8x13_t_symbols[];
+
+typedef void (*setup_cb)(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+typedef void (*screen_cb)(u8g2_t *u8g2, uint16_t frame);
+
+struct mode_struct
+{
+  const char *name;
+  setup_cb setup;
+  uint8_t is_display_list;
+  uint8_t is_double_buffer;
+  uint8_t is_group;
+};
+
+struct screen_struct
+{
+  const char *name;
+  screen_cb draw;
+};
+
+static u8g2_t u8g2;
+static uint8_t shadow[U8X8_ST7920_128X64_SHADOW_SIZE];
+#ifdef U8G2_WITH_DISPLAY_LIST
+static uint8_t display_list[DISPLAY_LIST_SIZE];
+#endif
+#ifdef U8G2_WITH_FRONT_BUFFER
+static uint8_t front_buffer[1024];
+#endif
+static uint8_t is_group;
+
+/*=========================================*/
+/* groups, only used by the _g modes */
+
+static uint8_t begin_group(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  if ( is_group == 0 )
+    return 1;
+  return u8g2_BeginGroup(u8g2, x, y, w, h);
+}
+
+static void end_group(u8g2_t *u8g2)
+{
+  if ( is_group )
+    u8g2_EndGroup(u8g2);
+}
+
+/* text line with baseline y: font bounding box over the width of the display */
+static uint8_t begin_text_group(u8g2_t *u8g2, u8g2_uint_t y)
+{
+  return begin_group(u8g2, 0, y - u8g2->font_info.max_char_height - u8g2->font_info.y_offset, 
+    u8g2_GetDisplayWidth(u8g2), u8g2->font_info.max_char_height);
+}
+
+/*=========================================*/
+/* screens, the frame number animates the content */
+
+/* main screen of the sketch: three frames and the assignments */
+static void screen_status(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_SetFont(u8g2, u8g2_font_8x13_t_symbols);
+  u8g2_DrawFrame(u8g2, 0, 0, 128, 64);
+  u8g2_DrawFrame(u8g2, 1, 1, 126, 62);
+  u8g2_DrawFrame(u8g2, 2, 2, 124, 60);
+  if ( begin_text_group(u8g2, 16) )
+  {
+    u8g2_DrawUTF8(u8g2, 6, 16, "FSW1 Delay \xe2\x96\xa0");
+    end_group(u8g2);
+  }
+  if ( begin_text_group(u8g2, 30) )
+  {
+    u8g2_DrawUTF8(u8g2, 6, 30, "FSW2 Chorus \xe2\x96\xa1");
+    end_group(u8g2);
+  }
+  if ( begin_text_group(u8g2, 44) )
+  {
+    u8g2_DrawUTF8(u8g2, 6, 44, "FSW3 Tap \xe2\x99\xaa");
+    end_group(u8g2);
+  }
+  if ( begin_text_group(u8g2, 58) )
+  {
+    u8g2_DrawUTF8(u8g2, 6, 58, (frame & 8) ? "\xe2\x86\x90 Bank 3 \xe2\x86\x92" : "\xe2\x86\x90 Bank 2 \xe2\x86\x92");
+    end_group(u8g2);
+  }
+}
+
+/* selection list with title, drawn by the same procedures as u8g2_UserInterfaceSelectionList() */
+static void screen_list(u8g2_t *u8g2, uint16_t frame)
+{
+  static const char *title = "Assignments";
+  static const char *list = "Delay\nChorus\nTap Tempo\nGain\nMix\nBypass";
+  u8sl_t u8sl;
+  u8g2_uint_t line_height;
+  u8g2_uint_t yy;
+  
+  u8g2_SetFont(u8g2, u8g2_font_8x13_t_symbols);
+  u8g2_SetFontPosBaseline(u8g2);
+  line_height = u8g2_GetAscent(u8g2) - u8g2_GetDescent(u8g2) + 1;
+  
+  u8sl.visible = (u8g2_GetDisplayHeight(u8g2)-3) / line_height - 1;
+  u8sl.total = u8x8_GetStringLineCnt(list);
+  u8sl.current_pos = (frame / 8) % u8sl.total;
+  u8sl.first_pos = 0;
+  if ( u8sl.current_pos >= u8sl.visible )
+    u8sl.first_pos = u8sl.current_pos - u8sl.visible + 1;
+  
+  yy = u8g2_GetAscent(u8g2);
+  yy += u8g2_DrawUTF8Lines(u8g2, 0, yy, u8g2_GetDisplayWidth(u8g2), line_height, title);
+  u8g2_DrawHLine(u8g2, 0, yy-line_height- u8g2_GetDescent(u8g2) + 1, u8g2_GetDisplayWidth(u8g2));
+  yy += 3;
+  u8g2_DrawSelectionList(u8g2, &u8sl, yy, list);
+}
+
+/* value bars of the actuators */
+static void screen_bars(u8g2_t *u8g2, uint16_t frame)
+{
+  static const char *names[] = { "EncA", "EncB", "Exp" };
+  char s[8];
+  uint8_t i, value;
+  
+  u8g2_SetFont(u8g2, u8g2_font_8x13_t_symbols);
+  for( i = 0; i < 3; i++ )
+  {
+    /* one row with name, bar and value */
+    if ( begin_group(u8g2, 0, i*21, 128, 21) == 0 )
+      continue;
+    value = (frame * (i+1) * 3) % 101;
+    u8g2_DrawStr(u8g2, 0, 14 + i*21, names[i]);
+    u8g2_DrawFrame(u8g2, 36, 3 + i*21, 64, 12);
+    u8g2_DrawBox(u8g2, 38, 5 + i*21, value * 60 / 100, 8);
+    sprintf(s, "%3u", value);
+    u8g2_DrawStr(u8g2, 104, 14 + i*21, s);
+    end_group(u8g2);
+  }
+}
+
+/* encoder gauges: half circles with a needle */
+static void screen_gauge(u8g2_t *u8g2, uint16_t frame)
+{
+  /* needle end point for 17 steps from left to right, radius 26 */
+  static const int8_t needle[17][2] =
+  {
+    { -26, 0 }, { -26, 5 }, { -24, 10 }, { -22, 14 }, { -18, 18 }, { -14, 22 },
+    { -10, 24 }, { -5, 26 }, { 0, 26 }, { 5, 26 }, { 10, 24 }, { 14, 22 },
+    { 18, 18 }, { 22, 14 }, { 24, 10 }, { 26, 5 }, { 26, 0 }
+  };
+  uint8_t i, pos;
+  u8g2_uint_t x;
+  
+  for( i = 0; i < 2; i++ )
+  {
+    x = 32 + i*64;
+    if ( begin_group(u8g2, x-31, 20, 63, 34) == 0 )
+      continue;
+    pos = (frame + i*5) % 32;
+    if ( pos > 16 )
+      pos = 32 - pos;
+    u8g2_DrawCircle(u8g2, x, 50, 30, U8G2_DRAW_UPPER_LEFT|U8G2_DRAW_UPPER_RIGHT);
+    u8g2_DrawCircle(u8g2, x, 50, 28, U8G2_DRAW_UPPER_LEFT|U8G2_DRAW_UPPER_RIGHT);
+    u8g2_DrawCircle(u8g2, x, 50, 3, U8G2_DRAW_ALL);
+    u8g2_DrawLine(u8g2, x, 50, x + needle[pos][0], 50 - needle[pos][1]);
+    u8g2_DrawLine(u8g2, x+1, 50, x + 1 + needle[pos][0], 50 - needle[pos][1]);
+    u8g2_DrawHLine(u8g2, x-31, 51, 63);
+    end_group(u8g2);
+  }
+}
+
+static const struct screen_struct screens[] =
+{
+  { "status", screen_status },
+  { "list", screen_list },
+  { "bars", screen_bars },
+  { "gauge", screen_gauge }
+};
+
+static const struct mode_struct modes[] =
+{
+  { "1", u8g2_Setup_st7920_s_128x64_1, 0, 0, 0 },
+  { "1_g", u8g2_Setup_st7920_s_128x64_1, 0, 0, 1 },
+  { "2", u8g2_Setup_st7920_s_128x64_2, 0, 0, 0 },
+  { "2_g", u8g2_Setup_st7920_s_128x64_2, 0, 0, 1 },
+#ifdef U8G2_WITH_DISPLAY_LIST
+  { "1_dl", u8g2_Setup_st7920_s_128x64_1, 1, 0, 0 },
+  { "1_dl_g", u8g2_Setup_st7920_s_128x64_1, 1, 0, 1 },
+  { "2_dl", u8g2_Setup_st7920_s_128x64_2, 1, 0, 0 },
+  { "2_dl_g", u8g2_Setup_st7920_s_128x64_2, 1, 0, 1 },
+#endif
+  { "f", u8g2_Setup_st7920_s_128x64_f, 0, 0, 0 },
+  { "dirty_f", u8g2_Setup_st7920_s_128x64_dirty_f, 0, 0, 0 },
+#ifdef U8G2_WITH_FRONT_BUFFER
+  { "d", u8g2_Setup_st7920_s_128x64_f, 0, 1, 0 },
+  { "dirty_d", u8g2_Setup_st7920_s_128x64_dirty_f, 0, 1, 0 }
+#endif
+};
+
+#define SCREEN_CNT (sizeof(screens)/sizeof(*screens))
+#define MODE_CNT (sizeof(modes)/sizeof(*modes))
+
+/*=========================================*/
+
+static uint8_t byte_none(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static const struct screen_struct *render_screen;
+static uint16_t render_frame;
+
+static void render_cb(u8g2_t *u8g2)
+{
+  render_screen->draw(u8g2, render_frame);
+}
+
+static void setup(const struct mode_struct *mode, u8x8_msg_cb byte_cb)
+{
+  mode->setup(&u8g2, U8G2_R0, byte_cb, u8x8_gpio_and_delay_st7920_capture);
+  u8x8_SetDisplayShadow(u8g2_GetU8x8(&u8g2), shadow);	/* only used by the dirty modes */
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( mode->is_display_list )
+    u8g2_SetDisplayList(&u8g2, display_list, sizeof(display_list));
+#endif
+#ifdef U8G2_WITH_FRONT_BUFFER
+  if ( mode->is_double_buffer )
+    u8g2_SetFrontBuffer(&u8g2, front_buffer);
+#endif
+  is_group = mode->is_group;
+}
+
+static void render(const struct mode_struct *mode, const struct screen_struct *screen, uint16_t frame)
+{
+  if ( mode->is_display_list )
+  {
+    render_screen = screen;
+    render_frame = frame;
+    u8g2_RenderStart(&u8g2, render_cb);
+    while( u8g2_RenderStep(&u8g2) )
+      ;
+    return;
+  }
+  
+#ifdef U8G2_WITH_FRONT_BUFFER
+  if ( mode->is_double_buffer )
+  {
+    u8g2_ClearBuffer(&u8g2);
+    screen->draw(&u8g2, frame);
+    u8g2_SwapBuffer(&u8g2);
+    while( u8g2_TransferStep(&u8g2) )
+      ;
+    return;
+  }
+#endif
+  
+  u8g2_FirstPage(&u8g2);
+  do
+  {
+    screen->draw(&u8g2, frame);
+  } while( u8g2_NextPage(&u8g2) );
+}
+
+/* CPU time per frame in microseconds */
+static double measure_time(const struct mode_struct *mode, const struct screen_struct *screen)
+{
+  clock_t start, end;
+  uint16_t frame;
+  
+  setup(mode, byte_none);
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+  start = clock();
+  for( frame = 0; frame < TIMED_FRAMES; frame++ )
+    render(mode, screen, frame);
+  end = clock();
+  return (double)(end - start) * 1000000.0 / CLOCKS_PER_SEC / TIMED_FRAMES;
+}
+
+/* returns the number of differences, CAPTURE_MISSING or CAPTURE_FAILED */
+static long capture(const struct mode_struct *mode, const struct screen_struct *screen, const char *golden_dir, uint8_t is_create, unsigned long *wire_bytes)
+{
+  char name[256];
+  uint16_t frame;
+  long diff = 0;
+  
+  setup(mode, u8x8_byte_st7920_capture);
+  st7920_capture_Reset();
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+  st7920_capture.wire_bytes = 0;
+  for( frame = 0; frame < FRAMES; frame++ )
+    render(mode, screen, frame);
+  *wire_bytes = st7920_capture.wire_bytes / FRAMES;
+  if ( st7920_capture.errors != 0 )
+  {
+    printf("%s %s: %lu protocol errors\n", screen->name, mode->name, st7920_capture.errors);
+    return CAPTURE_FAILED;
+  }
+  
+  snprintf(name, sizeof(name), "%s/%s.pbm", golden_dir, screen->name);
+  if ( is_create )
+  {
+    if ( st7920_capture_WritePBM(name) == 0 )
+    {
+      printf("%s: write error\n", name);
+      return CAPTURE_FAILED;
+    }
+    return 0;
+  }
+  
+  diff = st7920_capture_DiffPBM(name);
+  if ( diff != 0 )
+  {
+    snprintf(name, sizeof(name), "%s_%s.pbm", screen->name, mode->name);
+    st7920_capture_WritePBM(name);
+  }
+  return diff;
+}
+
+int main(int argc, char **argv)
+{
+  const char *golden_dir = "golden";
+  uint8_t is_create = 0;
+  uint8_t is_failed = 0;
+  uint8_t s, m;
+  unsigned long wire_bytes;
+  double us;
+  long diff;
+  
+  if ( argc > 1 && strcmp(argv[1], "-g") == 0 )
+  {
+    is_create = 1;
+    argc--;
+    argv++;
+  }
+  if ( argc > 1 )
+    golden_dir = argv[1];
+  if ( is_create && mkdir(golden_dir, 0777) != 0 && errno != EEXIST )
+  {
+    printf("%s: %s\n", golden_dir, strerror(errno));
+    return 1;
+  }
+  
+  printf("%-8s %-8s %10s %10s %8s\n", "screen", "mode", "us/frame", "wire/frame", "diff");
+  for( s = 0; s < SCREEN_CNT; s++ )
+  {
+    for( m = 0; m < MODE_CNT; m++ )
+    {
+      /* golden images are created from the full buffer mode */
+      if ( is_create && (modes[m].setup != u8g2_Setup_st7920_s_128x64_f || modes[m].is_double_buffer) )
+	continue;
+      
+      us = measure_time(modes+m, screens+s);
+      diff = capture(modes+m, screens+s, golden_dir, is_create, &wire_bytes);
+      if ( diff == CAPTURE_FAILED )
+	printf("%-8s %-8s %10.1f %10lu %8s\n", screens[s].name, modes[m].name, us, wire_bytes, "failed");
+      else if ( is_create )
+	printf("%-8s %-8s %10.1f %10lu %8s\n", screens[s].name, modes[m].name, us, wire_bytes, "created");
+      else if ( diff == CAPTURE_MISSING )
+	printf("%-8s %-8s %10.1f %10lu %8s\n", screens[s].name, modes[m].name, us, wire_bytes, "missing");
+      else
+	printf("%-8s %-8s %10.1f %10lu %8ld\n", screens[s].name, modes[m].name, us, wire_bytes, diff);
+      if ( diff != 0 )
+	is_failed = 1;
+    }
+  }
+  return is_failed;
+}
@@ -0,0 +1,232 @@
+/*
+
+  sam_usart_spi_check.c
+
+  Host check for u8x8_byte_dma(), the buffered byte procedure behind
+  u8x8_byte_arduino_sam_usart_spi() (Arduino Due, USART1 with PDC).
+
+  The ST7920 output of the software SPI procedure is sampled at the clock
+  edges and compared byte by byte with the output of a mocked PDC. The mock
+  reads the buffer only when the transfer completes and checks that chip
+  select stays active for the whole transfer, so a buffer which is modified
+  while "in flight" or a released chip select is detected.
+
+  Build and run (from this directory):
+    cc -I../../src/clib sam_usart_spi_check.c ../../src/clib/u8[gx]*.c -o sam_usart_spi_check
+    ./sam_usart_spi_check
+
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+
+#define WIRE_SIZE 32000
+
+/*=========================================*/
+/* wire log */
+
+static uint8_t wire[WIRE_SIZE];
+static uint16_t wire_len;
+static uint8_t wire_cs;
+static uint8_t wire_errors;
+
+static void wire_add(uint8_t b)
+{
+  if ( wire_len < WIRE_SIZE )
+    wire[wire_len++] = b;
+}
+
+/*=========================================*/
+/* software SPI: sample the data line at the takeover edge */
+
+static uint8_t sw_clock;
+static uint8_t sw_data;
+static uint8_t sw_byte;
+static uint8_t sw_bits;
+
+static uint8_t gpio_and_delay_sw(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  switch(msg)
+  {
+    case U8X8_MSG_GPIO_SPI_DATA:
+      sw_data = arg_int;
+      break;
+    case U8X8_MSG_GPIO_SPI_CLOCK:
+      if ( sw_clock != arg_int && arg_int == u8x8_GetSPIClockPhase(u8x8) && wire_cs == u8x8->display_info->chip_enable_level )
+      {
+	sw_byte = (sw_byte << 1) | sw_data;
+	sw_bits++;
+	if ( sw_bits == 8 )
+	{
+	  wire_add(sw_byte);
+	  sw_bits = 0;
+	}
+      }
+      sw_clock = arg_int;
+      break;
+    case U8X8_MSG_GPIO_CS:
+      wire_cs = arg_int;
+      break;
+  }
+  return 1;
+}
+
+/*=========================================*/
+/* PDC mock */
+
+static u8x8_t *mock_u8x8;
+static const uint8_t *mock_data;
+static uint16_t mock_cnt;
+static uint8_t mock_busy_polls;
+static uint16_t mock_buf_size;
+
+static uint8_t mock_buf[2][512];
+
+static void mock_start(const uint8_t *data, uint16_t cnt)
+{
+  if ( mock_data != NULL )
+  {
+    puts("PDC started while busy");
+    wire_errors++;
+  }
+  if ( wire_cs != mock_u8x8->display_info->chip_enable_level )
+  {
+    puts("PDC started without chip select");
+    wire_errors++;
+  }
+  mock_data = data;
+  mock_cnt = cnt;
+  mock_busy_polls = 3;
+}
+
+static uint8_t mock_is_busy(void)
+{
+  if ( mock_data == NULL )
+    return 0;
+  if ( mock_busy_polls > 0 )
+  {
+    mock_busy_polls--;
+    return 1;
+  }
+  while( mock_cnt > 0 )
+  {
+    wire_add(*mock_data++);
+    mock_cnt--;
+  }
+  mock_data = NULL;
+  return 0;
+}
+
+static u8x8_dma_t mock_dma =
+{
+  { mock_buf[0], mock_buf[1] },
+  sizeof(mock_buf[0]),
+  mock_start,
+  mock_is_busy,
+  0, 0, 0
+};
+
+static uint8_t byte_mock_dma(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  mock_u8x8 = u8x8;
+  mock_dma.size = mock_buf_size;
+  return u8x8_byte_dma(u8x8, &mock_dma, msg, arg_int, arg_ptr);
+}
+
+static uint8_t gpio_and_delay_mock(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  if ( msg == U8X8_MSG_GPIO_CS )
+  {
+    if ( mock_data != NULL && arg_int != u8x8->display_info->chip_enable_level )
+    {
+      puts("chip select released during PDC transfer");
+      wire_errors++;
+    }
+    wire_cs = arg_int;
+  }
+  return 1;
+}
+
+/*=========================================*/
+
+typedef void (*setup_cb)(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+
+static u8g2_t u8g2;
+static uint8_t sw_wire[WIRE_SIZE];
+static uint16_t sw_wire_len;
+
+static void draw(uint8_t frame)
+{
+  u8g2_DrawFrame(&u8g2, 0, 0, 128, 64);
+  u8g2_DrawBox(&u8g2, frame*7, 10, 30, 20);
+  u8g2_DrawLine(&u8g2, 0, 63, 127, frame*5);
+  u8g2_DrawCircle(&u8g2, 64, 32, 10+frame, U8G2_DRAW_ALL);
+}
+
+static void render(setup_cb setup, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
+{
+  uint8_t frame;
+
+  wire_len = 0;
+  setup(&u8g2, U8G2_R0, byte_cb, gpio_and_delay_cb);
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+  for( frame = 0; frame < 8; frame++ )
+  {
+    u8g2_FirstPage(&u8g2);
+    do
+    {
+      draw(frame);
+    } while( u8g2_NextPage(&u8g2) );
+  }
+  /* wait for the last transfer */
+  while( mock_is_busy() )
+    ;
+}
+
+static uint8_t check(const char *name, setup_cb setup, uint16_t buf_size)
+{
+  uint16_t i;
+
+  render(setup, u8x8_byte_4wire_sw_spi, gpio_and_delay_sw);
+  memcpy(sw_wire, wire, wire_len);
+  sw_wire_len = wire_len;
+
+  wire_errors = 0;
+  mock_buf_size = buf_size;
+  render(setup, byte_mock_dma, gpio_and_delay_mock);
+
+  if ( wire_len != sw_wire_len )
+  {
+    printf("%s buffer %u: %u bytes, software SPI %u bytes\n", name, buf_size, wire_len, sw_wire_len);
+    return 1;
+  }
+  for( i = 0; i < wire_len; i++ )
+  {
+    if ( wire[i] != sw_wire[i] )
+    {
+      printf("%s buffer %u: byte %u is 0x%02x, software SPI 0x%02x\n", name, buf_size, i, wire[i], sw_wire[i]);
+      return 1;
+    }
+  }
+  printf("%s buffer %u: %u bytes ok\n", name, buf_size, wire_len);
+  return wire_errors != 0;
+}
+
+int main(void)
+{
+  uint8_t errors = 0;
+
+  errors += check("st7920_s_128x64_1", u8g2_Setup_st7920_s_128x64_1, 512);
+  errors += check("st7920_s_128x64_1", u8g2_Setup_st7920_s_128x64_1, 37);
+  errors += check("st7920_s_128x64_f", u8g2_Setup_st7920_s_128x64_f, 512);
+  errors += check("st7920_s_128x64_f", u8g2_Setup_st7920_s_128x64_f, 37);
+
+  if ( errors != 0 )
+  {
+    puts("FAILED");
+    return 1;
+  }
+  return 0;
+}
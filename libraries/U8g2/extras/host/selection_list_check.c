@@ -0,0 +1,129 @@
+/*
+
+  selection_list_check.c
+
+  Host check for the group box of u8g2_DrawUTF8Line(): lines outside of
+  the current page are skipped with u8g2_BeginGroup(), so the page buffer
+  (st7920_s_128x64_1) must give the same picture as the full buffer
+  (st7920_s_128x64_f). u8g2_DrawUTF8Line(), u8g2_DrawUTF8Lines() and
+  u8g2_DrawSelectionList() are drawn for all font positions (baseline,
+  top, center, bottom), y positions, border sizes and inverted lines.
+  The exit code is 1 if any picture differs.
+
+  The u8g2 fonts of the release are not part of this source tree,
+  u8g2_font_8x13_t_symbols and u8g2_font_5x7_tr are created by
+  font_gen.c from the u8x8 fonts.
+
+  Build and run (from this directory):
+    ./build.sh
+    build/selection_list_check
+
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+
+#define PICTURE_SIZE 1024
+
+extern const uint8_t u8g2_font_8x13_t_symbols[];
+extern const uint8_t u8g2_font_5x7_tr[];
+
+typedef void (*font_pos_cb)(u8g2_t *u8g2);
+typedef void (*draw_cb)(u8g2_t *u8g2, u8g2_uint_t y, uint8_t arg);
+
+static void font_pos_baseline(u8g2_t *u8g2) { u8g2_SetFontPosBaseline(u8g2); }
+static void font_pos_top(u8g2_t *u8g2) { u8g2_SetFontPosTop(u8g2); }
+static void font_pos_center(u8g2_t *u8g2) { u8g2_SetFontPosCenter(u8g2); }
+static void font_pos_bottom(u8g2_t *u8g2) { u8g2_SetFontPosBottom(u8g2); }
+
+static const font_pos_cb font_pos_list[] = { font_pos_baseline, font_pos_top, font_pos_center, font_pos_bottom };
+static const char *font_pos_names[] = { "baseline", "top", "center", "bottom" };
+static const uint8_t *font_list[] = { u8g2_font_8x13_t_symbols, u8g2_font_5x7_tr };
+
+/* arg: border size (bit 0..1) and invert (bit 2) */
+static void draw_line(u8g2_t *u8g2, u8g2_uint_t y, uint8_t arg)
+{
+  u8g2_DrawUTF8Line(u8g2, 10, y, 100, "Delay Time", arg & 3, (arg >> 2) & 1);
+}
+
+static void draw_lines(u8g2_t *u8g2, u8g2_uint_t y, uint8_t arg)
+{
+  u8g2_DrawUTF8Lines(u8g2, 4, y, 120, 6 + (arg & 7), "Bank 1\nBank 2\nTremolo");
+}
+
+static void draw_selection_list(u8g2_t *u8g2, u8g2_uint_t y, uint8_t arg)
+{
+  static const char *sl = "Delay\nReverb\nChorus\nTremolo\nWah";
+  u8sl_t u8sl;
+  memset(&u8sl, 0, sizeof(u8sl));
+  u8sl.visible = 3;
+  u8sl.total = u8x8_GetStringLineCnt(sl);
+  u8sl.first_pos = arg & 1;
+  u8sl.current_pos = u8sl.first_pos + (arg >> 1) % 3;
+  u8g2_DrawSelectionList(u8g2, &u8sl, y, sl);
+}
+
+static const draw_cb draw_list[] = { draw_line, draw_lines, draw_selection_list };
+static const char *draw_names[] = { "u8g2_DrawUTF8Line", "u8g2_DrawUTF8Lines", "u8g2_DrawSelectionList" };
+
+static uint8_t byte_none(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static uint8_t gpio_and_delay_none(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+/* draw into all pages of u8g2, the pages are copied to picture */
+static void draw(u8g2_t *u8g2, uint8_t *picture, const uint8_t *font, font_pos_cb font_pos, draw_cb cb, u8g2_uint_t y, uint8_t arg)
+{
+  uint16_t page_size = u8g2_GetBufferTileHeight(u8g2) * u8g2_GetBufferTileWidth(u8g2) * 8;
+  uint16_t pos = 0;
+
+  u8g2_SetFont(u8g2, font);
+  font_pos(u8g2);
+  u8g2_FirstPage(u8g2);
+  do
+  {
+    cb(u8g2, y, arg);
+    memcpy(picture + pos, u8g2_GetBufferPtr(u8g2), page_size);
+    pos += page_size;
+  } while( u8g2_NextPage(u8g2) );
+}
+
+int main(void)
+{
+  static u8g2_t page, full;
+  static uint8_t page_picture[PICTURE_SIZE], full_picture[PICTURE_SIZE];
+  unsigned f, p, d, cnt = 0, errors = 0;
+  int y;
+  uint8_t arg;
+
+  u8g2_Setup_st7920_s_128x64_1(&page, U8G2_R0, byte_none, gpio_and_delay_none);
+  u8g2_Setup_st7920_s_128x64_f(&full, U8G2_R0, byte_none, gpio_and_delay_none);
+  u8g2_InitDisplay(&page);
+  u8g2_InitDisplay(&full);
+
+  for( d = 0; d < sizeof(draw_list)/sizeof(*draw_list); d++ )
+    for( f = 0; f < sizeof(font_list)/sizeof(*font_list); f++ )
+      for( p = 0; p < sizeof(font_pos_list)/sizeof(*font_pos_list); p++ )
+	for( y = -16; y < 80; y++ )
+	  for( arg = 0; arg < 8; arg++ )
+	  {
+	    draw(&page, page_picture, font_list[f], font_pos_list[p], draw_list[d], y, arg);
+	    draw(&full, full_picture, font_list[f], font_pos_list[p], draw_list[d], y, arg);
+	    cnt++;
+	    if ( memcmp(page_picture, full_picture, PICTURE_SIZE) != 0 )
+	    {
+	      if ( errors < 10 )
+		printf("%s font %u %s y=%d arg=%u: page buffer differs\n", draw_names[d], f, font_pos_names[p], y, arg);
+	      errors++;
+	    }
+	  }
+
+  printf("%u of %u pictures differ\n", errors, cnt);
+  return errors != 0;
+}
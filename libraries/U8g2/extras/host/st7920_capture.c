@@ -0,0 +1,220 @@
+/*
+
+  st7920_capture.c
+
+  Host emulation of the ST7920 serial interface, see st7920_capture.h.
+
+  Serial protocol: each transfer starts with a sync byte (0xf8 for an
+  instruction, 0xfa for data), followed by two bytes for each instruction
+  or data byte: high nibble and low nibble, both in the upper four bits.
+  Only the extended instruction set with the graphic RAM address 
+  instruction (first vertical, then horizontal address) is interpreted.
+
+*/
+
+#include "st7920_capture.h"
+#include <stdio.h>
+#include <string.h>
+
+st7920_capture_t st7920_capture;
+
+void st7920_capture_Reset(void)
+{
+  memset(&st7920_capture, 0, sizeof(st7920_capture));
+}
+
+static void st7920_capture_instruction(st7920_capture_t *c, uint8_t b)
+{
+  if ( (b & 0x0e0) == 0x020 )
+  {
+    /* function set */
+    c->is_extended = (b & 0x004) ? 1 : 0;
+    c->address_cnt = 0;
+  }
+  else if ( (b & 0x080) != 0 && c->is_extended != 0 )
+  {
+    /* set graphic RAM address */
+    if ( c->address_cnt == 0 )
+    {
+      c->y = b & 0x03f;
+      c->address_cnt = 1;
+    }
+    else
+    {
+      c->x = b & 0x00f;
+      c->byte_in_word = 0;
+      c->address_cnt = 0;
+    }
+  }
+  else
+  {
+    c->address_cnt = 0;
+  }
+}
+
+static void st7920_capture_data(st7920_capture_t *c, uint8_t b)
+{
+  c->address_cnt = 0;
+  if ( c->is_extended == 0 || c->y >= 32 )
+  {
+    /* text mode data or outside of the 128x64 area */
+    c->errors++;
+    return;
+  }
+  c->gdram[c->y][c->x*2 + c->byte_in_word] = b;
+  c->data_bytes++;
+  c->byte_in_word++;
+  if ( c->byte_in_word >= 2 )
+  {
+    c->byte_in_word = 0;
+    c->x = (c->x + 1) & 15;
+  }
+}
+
+static void st7920_capture_byte(st7920_capture_t *c, uint8_t b)
+{
+  c->wire_bytes++;
+  
+  /* sync bytes have bit 3 set, nibble bytes never */
+  if ( (b & 0x0f8) == 0x0f8 )
+  {
+    if ( c->nibble_cnt == 2 )
+      c->errors++;		/* incomplete byte */
+    c->is_data = (b & 0x002) ? 1 : 0;
+    c->nibble_cnt = 1;
+    return;
+  }
+  
+  if ( c->nibble_cnt == 0 || (b & 0x00f) != 0 )
+  {
+    c->errors++;
+    return;
+  }
+  
+  if ( c->nibble_cnt == 1 )
+  {
+    c->high_nibble = b;
+    c->nibble_cnt = 2;
+    return;
+  }
+  
+  b >>= 4;
+  b |= c->high_nibble;
+  c->nibble_cnt = 1;
+  if ( c->is_data )
+    st7920_capture_data(c, b);
+  else
+    st7920_capture_instruction(c, b);
+}
+
+uint8_t u8x8_byte_st7920_capture(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  uint8_t *data;
+  
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_SEND:
+      data = (uint8_t *)arg_ptr;
+      while( arg_int > 0 )
+      {
+	st7920_capture_byte(&st7920_capture, *data);
+	data++;
+	arg_int--;
+      }
+      break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      /* chip select resets the serial protocol */
+      st7920_capture.nibble_cnt = 0;
+      break;
+    case U8X8_MSG_BYTE_INIT:
+    case U8X8_MSG_BYTE_SET_DC:
+      break;
+    default:
+      return 0;
+  }
+  return 1;
+}
+
+uint8_t u8x8_gpio_and_delay_st7920_capture(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+uint8_t st7920_capture_GetPixel(uint8_t x, uint8_t y)
+{
+  uint8_t b;
+  
+  if ( y >= 32 )
+  {
+    y -= 32;
+    b = st7920_capture.gdram[y][16 + x/8];
+  }
+  else
+  {
+    b = st7920_capture.gdram[y][x/8];
+  }
+  return (b >> (7 - (x & 7))) & 1;
+}
+
+/* one row of the display, msb is the left most pixel (same as PBM) */
+static void st7920_capture_get_row(uint8_t y, uint8_t *row)
+{
+  if ( y >= 32 )
+    memcpy(row, st7920_capture.gdram[y-32]+16, ST7920_CAPTURE_WIDTH/8);
+  else
+    memcpy(row, st7920_capture.gdram[y], ST7920_CAPTURE_WIDTH/8);
+}
+
+uint8_t st7920_capture_WritePBM(const char *filename)
+{
+  FILE *fp;
+  uint8_t row[ST7920_CAPTURE_WIDTH/8];
+  uint8_t y;
+  
+  fp = fopen(filename, "wb");
+  if ( fp == NULL )
+    return 0;
+  fprintf(fp, "P4\n%d %d\n", ST7920_CAPTURE_WIDTH, ST7920_CAPTURE_HEIGHT);
+  for( y = 0; y < ST7920_CAPTURE_HEIGHT; y++ )
+  {
+    st7920_capture_get_row(y, row);
+    fwrite(row, 1, sizeof(row), fp);
+  }
+  return fclose(fp) == 0;
+}
+
+long st7920_capture_DiffPBM(const char *filename)
+{
+  FILE *fp;
+  uint8_t row[ST7920_CAPTURE_WIDTH/8];
+  uint8_t ref[ST7920_CAPTURE_WIDTH/8];
+  int w, h;
+  uint8_t x, y, d;
+  long diff = 0;
+  
+  fp = fopen(filename, "rb");
+  if ( fp == NULL )
+    return -1;
+  if ( fscanf(fp, "P4 %d %d", &w, &h) != 2 || w != ST7920_CAPTURE_WIDTH || h != ST7920_CAPTURE_HEIGHT || fgetc(fp) == EOF )
+  {
+    fclose(fp);
+    return -1;
+  }
+  for( y = 0; y < ST7920_CAPTURE_HEIGHT; y++ )
+  {
+    if ( fread(ref, 1, sizeof(ref), fp) != sizeof(ref) )
+    {
+      fclose(fp);
+      return -1;
+    }
+    st7920_capture_get_row(y, row);
+    for( x = 0; x < sizeof(row); x++ )
+    {
+      for( d = row[x] ^ ref[x]; d != 0; d &= d-1 )
+	diff++;
+    }
+  }
+  fclose(fp);
+  return diff;
+}
@@ -0,0 +1,62 @@
+/*
+
+  st7920_capture.h
+
+  Host emulation of the ST7920 serial interface for the extras/host tools.
+  Use u8x8_byte_st7920_capture() as byte procedure together with one of
+  the u8g2_Setup_st7920_s_128x64_xxx() procedures. The emulation decodes
+  the command and data stream which the real display would receive and
+  keeps the graphic RAM of the controller.
+
+*/
+
+#ifndef ST7920_CAPTURE_H
+#define ST7920_CAPTURE_H
+
+#include "u8x8.h"
+
+#define ST7920_CAPTURE_WIDTH 128
+#define ST7920_CAPTURE_HEIGHT 64
+
+struct _st7920_capture_t
+{
+  /* graphic RAM: 32 rows with 16 words, the lower half of the display starts at word 8 */
+  uint8_t gdram[32][32];
+  
+  /* serial protocol */
+  uint8_t is_data;		/* RS of the last sync byte */
+  uint8_t nibble_cnt;		/* 0: next byte is a sync byte, 1: high nibble, 2: low nibble */
+  uint8_t high_nibble;
+  
+  /* instruction state */
+  uint8_t is_extended;		/* RE bit of the function set instruction */
+  uint8_t address_cnt;		/* number of GDRAM address instructions in sequence */
+  uint8_t x;			/* word address */
+  uint8_t y;
+  uint8_t byte_in_word;
+  
+  /* statistics */
+  unsigned long wire_bytes;	/* all bytes while chip select is active */
+  unsigned long data_bytes;	/* bytes written to the graphic RAM */
+  unsigned long errors;		/* protocol errors */
+};
+typedef struct _st7920_capture_t st7920_capture_t;
+
+extern st7920_capture_t st7920_capture;
+
+/* clear the graphic RAM, the protocol state and the statistics */
+void st7920_capture_Reset(void);
+
+uint8_t u8x8_byte_st7920_capture(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+uint8_t u8x8_gpio_and_delay_st7920_capture(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+/* pixel of the 128x64 display, reconstructed from the graphic RAM */
+uint8_t st7920_capture_GetPixel(uint8_t x, uint8_t y);
+
+/* write the display content as binary PBM (P4), returns 0 on error */
+uint8_t st7920_capture_WritePBM(const char *filename);
+
+/* number of different pixels, compared with a PBM file, -1 if the file is not readable */
+long st7920_capture_DiffPBM(const char *filename);
+
+#endif /* ST7920_CAPTURE_H */
@@ -0,0 +1,170 @@
+/*
+
+  str_width_bench.c
+
+  Frames per second for a screen with centered labels on the ST7920 page
+  buffer (st7920_s_128x64_1), without and with the string width cache
+  (u8g2_SetStrWidthCache()). Each label is measured on every page, like
+  u8g2_DrawUTF8Line() does. The display is not connected, so only the
+  rendering into the tile buffer is measured.
+  Before the measurement, the cached widths are compared with the
+  measured widths, also for a label in RAM which is modified and after
+  a change of the font.
+
+  The u8g2 fonts of the release are not part of this source tree,
+  u8g2_font_8x13_t_symbols and u8g2_font_5x7_tr are created by
+  font_gen.c from the u8x8 fonts.
+
+  Build and run (from this directory):
+    ./build.sh
+    build/str_width_bench
+
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef U8G2_WITH_STR_WIDTH_CACHE
+#error "U8G2_WITH_STR_WIDTH_CACHE is required"
+#endif
+
+#define FRAMES 2000
+
+extern const uint8_t u8g2_font_8x13_t_symbols[];
+extern const uint8_t u8g2_font_5x7_tr[];
+
+/* actuator names and units of the pedal */
+static const char *labels[] =
+{
+  "Delay Time",
+  "Feedback",
+  "Tremolo \xe2\x99\xaa",
+  "350 ms",
+  "42 %"
+};
+
+#define LABEL_CNT (sizeof(labels)/sizeof(*labels))
+
+static u8g2_t u8g2;
+static u8g2_str_width_entry_t str_width_cache[8];
+
+static uint8_t byte_none(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static uint8_t gpio_and_delay_none(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static void draw(void)
+{
+  uint8_t i;
+  u8g2_uint_t w;
+  for( i = 0; i < LABEL_CNT; i++ )
+  {
+    w = u8g2_GetUTF8Width(&u8g2, labels[i]);
+    u8g2_DrawUTF8(&u8g2, (u8g2_GetDisplayWidth(&u8g2) - w) / 2, 12 + i*12, labels[i]);
+  }
+}
+
+static double bench(const char *name, uint8_t cnt)
+{
+  clock_t start, end;
+  uint16_t frame;
+  double t;
+
+  u8g2_SetStrWidthCache(&u8g2, cnt == 0 ? NULL : str_width_cache, cnt);
+  start = clock();
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    u8g2_FirstPage(&u8g2);
+    do
+    {
+      draw();
+    } while( u8g2_NextPage(&u8g2) );
+  }
+  end = clock();
+  t = (double)(end - start) / CLOCKS_PER_SEC;
+  printf("%-18s %8.0f frames/s  hits %lu  misses %lu\n", name, (double)FRAMES / t,
+    u8g2.str_width_cache.hit_cnt, u8g2.str_width_cache.miss_cnt);
+  return (double)FRAMES / t;
+}
+
+static uint8_t check_label(const char *s)
+{
+  u8g2_uint_t utf8, ascii;
+  uint8_t errors = 0;
+
+  u8g2_SetStrWidthCache(&u8g2, NULL, 0);
+  utf8 = u8g2_GetUTF8Width(&u8g2, s);
+  ascii = u8g2_GetStrWidth(&u8g2, s);
+  u8g2_SetStrWidthCache(&u8g2, str_width_cache, sizeof(str_width_cache)/sizeof(*str_width_cache));
+  if ( u8g2_GetUTF8Width(&u8g2, s) != utf8 || u8g2_GetUTF8Width(&u8g2, s) != utf8 )
+    errors++;
+  if ( u8g2_GetStrWidth(&u8g2, s) != ascii || u8g2_GetStrWidth(&u8g2, s) != ascii )
+    errors++;
+  return errors;
+}
+
+static uint8_t check(void)
+{
+  static char value[8];
+  uint8_t i, errors = 0;
+  u8g2_uint_t w;
+
+  for( i = 0; i < LABEL_CNT; i++ )
+    errors += check_label(labels[i]);
+
+  /* the same pointer with other characters */
+  u8g2_SetStrWidthCache(&u8g2, str_width_cache, sizeof(str_width_cache)/sizeof(*str_width_cache));
+  strcpy(value, "1 ms");
+  u8g2_GetUTF8Width(&u8g2, value);
+  strcpy(value, "1000 ms");
+  u8g2_SetStrWidthCache(&u8g2, NULL, 0);
+  w = u8g2_GetUTF8Width(&u8g2, value);
+  u8g2_SetStrWidthCache(&u8g2, str_width_cache, sizeof(str_width_cache)/sizeof(*str_width_cache));
+  if ( u8g2_GetUTF8Width(&u8g2, value) != w )
+    errors++;
+
+  /* another font: the label is measured again */
+  u8g2_SetFont(&u8g2, u8g2_font_5x7_tr);
+  u8g2_SetStrWidthCache(&u8g2, NULL, 0);
+  w = u8g2_GetUTF8Width(&u8g2, labels[0]);
+  u8g2_SetStrWidthCache(&u8g2, str_width_cache, sizeof(str_width_cache)/sizeof(*str_width_cache));
+  u8g2_SetFont(&u8g2, u8g2_font_8x13_t_symbols);
+  u8g2_GetUTF8Width(&u8g2, labels[0]);
+  u8g2_SetFont(&u8g2, u8g2_font_5x7_tr);
+  if ( u8g2_GetUTF8Width(&u8g2, labels[0]) != w || u8g2.str_width_cache.miss_cnt != 2 )
+    errors++;
+  u8g2_SetFont(&u8g2, u8g2_font_8x13_t_symbols);
+
+  if ( errors != 0 )
+    printf("%u width errors\n", errors);
+  return errors;
+}
+
+int main(void)
+{
+  double uncached, cached;
+  uint8_t errors;
+
+  u8g2_Setup_st7920_s_128x64_1(&u8g2, U8G2_R0, byte_none, gpio_and_delay_none);
+  u8g2_SetFont(&u8g2, u8g2_font_8x13_t_symbols);
+
+  errors = check();
+
+  uncached = bench("no cache", 0);
+  cached = bench("cache 8 entries", sizeof(str_width_cache)/sizeof(*str_width_cache));
+  printf("speedup %.2f\n", cached / uncached);
+
+  if ( errors != 0 )
+  {
+    puts("FAILED");
+    return 1;
+  }
+  return 0;
+}
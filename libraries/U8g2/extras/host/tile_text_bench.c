@@ -0,0 +1,183 @@
+/*
+
+  tile_text_bench.c
+
+  Update of a fast changing number on the ST7920 (128x64, serial, full
+  buffer with front buffer and dirty rows), once with the u8g2 font
+  procedures (clear box, draw string, swap and transfer) and once with the
+  tile text procedures (u8g2_Draw2x2TileString()). For both the tool
+  reports the CPU time and the bytes on the wire per update.
+
+  Before the measurement, the display content reconstructed by
+  st7920_capture.c is compared with the glyphs of the u8x8 font and with
+  the static screen, for glyphs at even and odd tiles, with 8x8 and 16x16
+  glyphs. A following swap and transfer of the u8g2 frame must not change
+  the display content.
+
+  The u8g2 fonts of the release are not part of this source tree,
+  u8g2_font_8x13_t_symbols is created by font_gen.c from the u8x8 fonts.
+
+  Build and run (from this directory):
+    ./build.sh
+    build/tile_text_bench
+
+*/
+
+#include "u8g2.h"
+#include "st7920_capture.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define UPDATES 5000
+
+extern const uint8_t u8g2_font_8x13_t_symbols[];
+
+static u8g2_t u8g2;
+static uint8_t shadow[U8X8_ST7920_128X64_SHADOW_SIZE];
+static uint8_t front_buffer[1024];
+
+/* static part of the screen */
+static void draw_static(void)
+{
+  u8g2_ClearBuffer(&u8g2);
+  u8g2_SetFont(&u8g2, u8g2_font_8x13_t_symbols);
+  u8g2_DrawFrame(&u8g2, 0, 0, 128, 64);
+  u8g2_DrawStr(&u8g2, 4, 60, "Delay Time ms");
+  u8g2_DrawBox(&u8g2, 0, 24, 128, 2);
+}
+
+static void transfer(void)
+{
+  u8g2_SwapBuffer(&u8g2);
+  while( u8g2_TransferStep(&u8g2) )
+    ;
+}
+
+/* pixel of the u8x8 glyph, x and y in tile pixels of the glyph */
+static uint8_t glyph_pixel(const uint8_t *font, uint8_t encoding, uint8_t x, uint8_t y)
+{
+  if ( encoding < font[0] || encoding > font[1] )
+    return 0;
+  return (font[2 + (encoding - font[0])*8 + x] >> y) & 1;
+}
+
+/* compare the display with the front buffer, and the text area with the font */
+static unsigned long check_text(uint8_t tx, uint8_t ty, uint8_t size, const char *s)
+{
+  const uint8_t *font = u8g2_GetU8x8(&u8g2)->font;
+  unsigned long errors = 0;
+  uint8_t x, y, expected, i;
+
+  for( y = 0; y < 64; y++ )
+    for( x = 0; x < 128; x++ )
+    {
+      expected = (front_buffer[y*16 + x/8] >> (7 - (x&7))) & 1;
+      if ( st7920_capture_GetPixel(x, y) != expected )
+	errors++;
+      i = (x/8 - tx) / size;
+      if ( x >= tx*8 && i < strlen(s) && y >= ty*8 && y < ty*8 + size*8 )
+	if ( expected != glyph_pixel(font, s[i], (x - tx*8 - i*size*8)/size, (y - ty*8)/size) )
+	  errors++;
+    }
+  return errors;
+}
+
+static unsigned long check(void)
+{
+  unsigned long errors = 0;
+  unsigned long wire_bytes;
+
+  draw_static();
+  transfer();
+  errors += check_text(0, 0, 1, "");
+
+  /* odd start, the other half of the first and last word is the frame */
+  u8g2_DrawTileString(&u8g2, 1, 1, "-12.5");
+  errors += check_text(1, 1, 1, "-12.5");
+  u8g2_Draw2x2TileString(&u8g2, 3, 4, "4:2");
+  errors += check_text(3, 4, 2, "4:2");
+  u8g2_Draw2x2TileString(&u8g2, 2, 4, "100");
+  errors += check_text(2, 4, 2, "100");
+
+  /* the glyphs are part of both buffers, the next frame does not overwrite them */
+  wire_bytes = st7920_capture.wire_bytes;
+  transfer();
+  if ( st7920_capture.wire_bytes != wire_bytes )
+    errors++;
+  errors += check_text(2, 4, 2, "100");
+
+  /* a glyph which does not fit is not drawn */
+  if ( u8g2_Draw2x2TileString(&u8g2, 14, 0, "123") != 1 )
+    errors++;
+  if ( st7920_capture.errors != 0 )
+    errors++;
+
+  if ( errors != 0 )
+    printf("%lu errors\n", errors);
+  return errors;
+}
+
+static void value_str(char *buf, uint16_t i)
+{
+  sprintf(buf, "%4d", (int)(i % 400) - 200);
+}
+
+static void bench(const char *name, uint8_t is_tile_text)
+{
+  char buf[8];
+  clock_t start, end;
+  unsigned long wire_bytes;
+  uint16_t i;
+  double t;
+
+  draw_static();
+  transfer();
+  wire_bytes = st7920_capture.wire_bytes;
+  start = clock();
+  for( i = 0; i < UPDATES; i++ )
+  {
+    value_str(buf, i);
+    if ( is_tile_text )
+    {
+      u8g2_Draw2x2TileString(&u8g2, 4, 0, buf);
+    }
+    else
+    {
+      u8g2_SetDrawColor(&u8g2, 0);
+      u8g2_DrawBox(&u8g2, 32, 1, 64, 16);
+      u8g2_SetDrawColor(&u8g2, 1);
+      u8g2_DrawStr(&u8g2, 32, 14, buf);
+      transfer();
+    }
+  }
+  end = clock();
+  t = (double)(end - start) / CLOCKS_PER_SEC;
+  printf("%-12s %8.2f us/update  %6.1f wire bytes/update\n", name,
+    t * 1e6 / UPDATES, (double)(st7920_capture.wire_bytes - wire_bytes) / UPDATES);
+}
+
+int main(void)
+{
+  unsigned long errors;
+
+  u8g2_Setup_st7920_s_128x64_dirty_f(&u8g2, U8G2_R0, u8x8_byte_st7920_capture, u8x8_gpio_and_delay_st7920_capture);
+  u8x8_SetDisplayShadow(u8g2_GetU8x8(&u8g2), shadow);
+  st7920_capture_Reset();
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+  u8g2_SetFrontBuffer(&u8g2, front_buffer);
+  u8g2_SetTileFont(&u8g2, u8x8_font_chroma48medium8_r);
+
+  errors = check();
+
+  bench("u8g2 font", 0);
+  bench("tile text", 1);
+
+  if ( errors != 0 )
+  {
+    puts("FAILED");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,348 @@
+/*
+
+  upscale_bench.c
+
+  Upscale kernels with the nibble lookup tables (u8x8_upscale_byte(),
+  u8x8_upscale_byte_n()) compared with the previous implementation: the
+  bit interleave with magic numbers for 2x and a bit loop for 3x and 4x.
+  Also measured: a "tuner style" readout with u8g2_DrawScaledXBM() (3x)
+  compared with one box per bitmap pixel.
+
+  Before the measurement the tool checks:
+    - all 256 bytes for the scales 1 to 4
+    - u8x8_Draw2x2String(), u8x8_Draw3x3String() and u8x8_Draw4x4String()
+      against the pixels of the font
+    - u8g2_DrawScaledXBM() against single pixels for both bitmap modes,
+      with the full buffer of the ST7920 and the page buffer of the SSD1306
+
+  Build and run (from this directory):
+    cc -O2 -I../../src/clib upscale_bench.c ../../src/clib/u8[gx]*.c -o upscale_bench
+    ./upscale_bench
+
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ROUNDS 2000
+
+static u8g2_t u8g2;
+static u8x8_msg_cb display_cb;
+
+/* tiles received by the display, 16x8 tiles */
+static uint8_t tiles[8][128];
+
+/* 5x7 digits as XBM, one byte per row */
+static const uint8_t digits[10][7] =
+{
+  { 0x0e, 0x11, 0x19, 0x15, 0x13, 0x11, 0x0e },
+  { 0x04, 0x06, 0x04, 0x04, 0x04, 0x04, 0x0e },
+  { 0x0e, 0x11, 0x10, 0x08, 0x04, 0x02, 0x1f },
+  { 0x1f, 0x08, 0x04, 0x08, 0x10, 0x11, 0x0e },
+  { 0x08, 0x0c, 0x0a, 0x09, 0x1f, 0x08, 0x08 },
+  { 0x1f, 0x01, 0x0f, 0x10, 0x10, 0x11, 0x0e },
+  { 0x0c, 0x02, 0x01, 0x0f, 0x11, 0x11, 0x0e },
+  { 0x1f, 0x10, 0x08, 0x04, 0x02, 0x02, 0x02 },
+  { 0x0e, 0x11, 0x11, 0x0e, 0x11, 0x11, 0x0e },
+  { 0x0e, 0x11, 0x11, 0x1e, 0x10, 0x08, 0x06 }
+};
+
+static uint8_t byte_none(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static uint8_t gpio_and_delay_none(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static uint8_t display_capture(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_tile_t *tile = (u8x8_tile_t *)arg_ptr;
+  if ( msg == U8X8_MSG_DISPLAY_DRAW_TILE )
+  {
+    if ( tile->x_pos + tile->cnt <= 16 && tile->y_pos < 8 )
+      memcpy(tiles[tile->y_pos] + tile->x_pos*8, tile->tile_ptr, tile->cnt*8);
+    return 1;
+  }
+  return display_cb(u8x8, msg, arg_int, arg_ptr);
+}
+
+/* previous implementation of u8x8_upscale_byte() */
+static uint16_t magic_upscale_byte(uint8_t x)
+{
+  uint16_t y = x;
+  y |= (y << 4);
+  y &= 0x0f0f;
+  y |= (y << 2);
+  y &= 0x3333;
+  y |= (y << 1);
+  y &= 0x5555;
+  y |= (y << 1);
+  return y;
+}
+
+static uint32_t loop_upscale_byte(uint8_t x, uint8_t scale)
+{
+  uint32_t y = 0;
+  uint8_t i;
+  for( i = 8; i > 0; i-- )
+  {
+    y <<= scale;
+    if ( x & (1 << (i-1)) )
+      y |= (1UL << scale) - 1;
+  }
+  return y;
+}
+
+static unsigned long check_kernels(void)
+{
+  unsigned long errors = 0;
+  uint16_t x;
+  uint8_t scale;
+
+  for( x = 0; x < 256; x++ )
+  {
+    if ( u8x8_upscale_byte(x) != magic_upscale_byte(x) )
+      errors++;
+    for( scale = 1; scale <= 4; scale++ )
+      if ( u8x8_upscale_byte_n(x, scale) != loop_upscale_byte(x, scale) )
+	errors++;
+  }
+  return errors;
+}
+
+static unsigned long check_glyphs(void)
+{
+  u8x8_t *u8x8 = u8g2_GetU8x8(&u8g2);
+  const uint8_t *font = u8x8_font_chroma48medium8_r;
+  const char *s = "-42.7";
+  unsigned long errors = 0;
+  uint8_t scale, x, y, i, e, expected;
+
+  u8x8_SetFont(u8x8, font);
+  for( scale = 2; scale <= 4; scale++ )
+  {
+    memset(tiles, 0, sizeof(tiles));
+    switch( scale )
+    {
+      case 2: u8x8_Draw2x2String(u8x8, 0, 0, s); break;
+      case 3: u8x8_Draw3x3String(u8x8, 0, 0, s); break;
+      case 4: u8x8_Draw4x4String(u8x8, 0, 0, s); break;
+    }
+    for( y = 0; y < 64; y++ )
+      for( x = 0; x < 128; x++ )
+      {
+	i = x / (8*scale);
+	expected = 0;
+	if ( i < strlen(s) && y < 8*scale )
+	{
+	  e = s[i] - font[0];
+	  expected = (font[2 + e*8 + (x % (8*scale))/scale] >> (y/scale)) & 1;
+	}
+	if ( ((tiles[y/8][x] >> (y&7)) & 1) != expected )
+	  errors++;
+      }
+  }
+  return errors;
+}
+
+/* reference: each pixel of the bitmap with u8g2_DrawPixel(), same colors as u8g2_DrawHXBM() */
+static void draw_pixel_xbm(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, uint8_t scale, const uint8_t *bitmap)
+{
+  uint8_t color = u8g2.draw_color;
+  uint8_t ncolor = (color == 0 ? 1 : 0);
+  u8g2_uint_t blen = (w+7)/8;
+  u8g2_uint_t i, j, dx, dy;
+
+  for( j = 0; j < h; j++ )
+    for( i = 0; i < w; i++ )
+    {
+      if ( bitmap[j*blen + i/8] & (1 << (i&7)) )
+	u8g2.draw_color = color;
+      else if ( u8g2.bitmap_transparency == 0 )
+	u8g2.draw_color = ncolor;
+      else
+	continue;
+      for( dy = 0; dy < scale; dy++ )
+	for( dx = 0; dx < scale; dx++ )
+	  u8g2_DrawPixel(&u8g2, x + i*scale + dx, y + j*scale + dy);
+    }
+  u8g2.draw_color = color;
+}
+
+/* buffer size of a page for the current setup */
+static uint16_t page_size(void)
+{
+  return u8g2_GetBufferTileHeight(&u8g2) * u8g2_GetBufferTileWidth(&u8g2) * 8;
+}
+
+static unsigned long compare_scaled_xbm(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, uint8_t scale, const uint8_t *bitmap)
+{
+  static uint8_t expected[1024];
+  unsigned long errors = 0;
+  uint8_t mode, color;
+
+  for( mode = 0; mode < 2; mode++ )
+    for( color = 0; color < 3; color++ )
+    {
+      u8g2_SetBitmapMode(&u8g2, mode);
+      u8g2_FirstPage(&u8g2);
+      do
+      {
+	/* background pattern, so that both colors are visible */
+	memset(u8g2_GetBufferPtr(&u8g2), 0x5a, page_size());
+	u8g2_SetDrawColor(&u8g2, color);
+	draw_pixel_xbm(x, y, w, h, scale, bitmap);
+	memcpy(expected, u8g2_GetBufferPtr(&u8g2), page_size());
+	memset(u8g2_GetBufferPtr(&u8g2), 0x5a, page_size());
+	u8g2_DrawScaledXBM(&u8g2, x, y, w, h, scale, bitmap);
+	if ( memcmp(expected, u8g2_GetBufferPtr(&u8g2), page_size()) != 0 )
+	  errors++;
+	u8g2_SetDrawColor(&u8g2, 1);
+      } while( u8g2_NextPage(&u8g2) );
+    }
+  u8g2_SetBitmapMode(&u8g2, 0);
+  return errors;
+}
+
+static unsigned long check_scaled_xbm(void)
+{
+  static uint8_t bitmap[10*20];
+  unsigned long errors = 0;
+  uint8_t scale;
+  uint16_t i;
+
+  srand(1);
+  for( i = 0; i < sizeof(bitmap); i++ )
+    bitmap[i] = rand();
+  for( scale = 1; scale <= 4; scale++ )
+  {
+    errors += compare_scaled_xbm(3, 5, 13, 9, scale, bitmap);
+    /* more than one chunk of 8 bytes per row, clipped at the right border (8 bit coordinates) */
+    errors += compare_scaled_xbm(1, 2, scale == 4 ? 62 : 80, 20, scale, bitmap);
+  }
+  return errors;
+}
+
+static unsigned long check(void)
+{
+  unsigned long errors = 0;
+
+  errors += check_kernels();
+
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, byte_none, gpio_and_delay_none);
+  display_cb = u8g2_GetU8x8(&u8g2)->display_cb;
+  u8g2_GetU8x8(&u8g2)->display_cb = display_capture;
+  errors += check_glyphs();
+
+  errors += check_scaled_xbm();
+  u8g2_Setup_ssd1306_128x64_noname_1(&u8g2, U8G2_R0, byte_none, gpio_and_delay_none);
+  errors += check_scaled_xbm();
+  u8g2_Setup_st7920_s_128x64_f(&u8g2, U8G2_R0, byte_none, gpio_and_delay_none);
+  errors += check_scaled_xbm();
+
+  if ( errors != 0 )
+    printf("%lu errors\n", errors);
+  return errors;
+}
+
+static double seconds(clock_t start)
+{
+  return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static void bench_kernels(void)
+{
+  volatile uint32_t sum = 0;
+  clock_t start;
+  uint16_t round, x;
+  uint8_t scale;
+  double t_old, t_new;
+
+  start = clock();
+  for( round = 0; round < ROUNDS*10; round++ )
+    for( x = 0; x < 256; x++ )
+      sum += magic_upscale_byte(x ^ round);
+  t_old = seconds(start);
+  start = clock();
+  for( round = 0; round < ROUNDS*10; round++ )
+    for( x = 0; x < 256; x++ )
+      sum += u8x8_upscale_byte(x ^ round);
+  t_new = seconds(start);
+  printf("2x kernel    magic numbers %7.1f Mbyte/s  lookup %7.1f Mbyte/s\n",
+    ROUNDS*10*256/t_old/1e6, ROUNDS*10*256/t_new/1e6);
+
+  for( scale = 3; scale <= 4; scale++ )
+  {
+    start = clock();
+    for( round = 0; round < ROUNDS*10; round++ )
+      for( x = 0; x < 256; x++ )
+	sum += loop_upscale_byte(x ^ round, scale);
+    t_old = seconds(start);
+    start = clock();
+    for( round = 0; round < ROUNDS*10; round++ )
+      for( x = 0; x < 256; x++ )
+	sum += u8x8_upscale_byte_n(x ^ round, scale);
+    t_new = seconds(start);
+    printf("%ux kernel    bit loop      %7.1f Mbyte/s  lookup %7.1f Mbyte/s\n", scale,
+      ROUNDS*10*256/t_old/1e6, ROUNDS*10*256/t_new/1e6);
+  }
+}
+
+/* readout "-12.5" style: four digits of 5x7 pixel, scaled 3x */
+static void bench_readout(void)
+{
+  clock_t start;
+  uint16_t round;
+  uint8_t i;
+  double t_box, t_xbm;
+  u8g2_uint_t x, y;
+
+  u8g2_Setup_st7920_s_128x64_f(&u8g2, U8G2_R0, byte_none, gpio_and_delay_none);
+  u8g2_SetBitmapMode(&u8g2, 1);
+
+  start = clock();
+  for( round = 0; round < ROUNDS; round++ )
+  {
+    u8g2_ClearBuffer(&u8g2);
+    for( i = 0; i < 4; i++ )
+      for( y = 0; y < 7; y++ )
+	for( x = 0; x < 5; x++ )
+	  if ( digits[(round+i)%10][y] & (1<<x) )
+	    u8g2_DrawBox(&u8g2, 10 + i*18 + x*3, 20 + y*3, 3, 3);
+  }
+  t_box = seconds(start);
+
+  start = clock();
+  for( round = 0; round < ROUNDS; round++ )
+  {
+    u8g2_ClearBuffer(&u8g2);
+    for( i = 0; i < 4; i++ )
+      u8g2_DrawScaledXBM(&u8g2, 10 + i*18, 20, 5, 7, 3, digits[(round+i)%10]);
+  }
+  t_xbm = seconds(start);
+
+  printf("readout 3x   box per pixel %7.2f us      DrawScaledXBM %7.2f us  (incl. clear buffer)\n",
+    t_box*1e6/ROUNDS, t_xbm*1e6/ROUNDS);
+}
+
+int main(void)
+{
+  unsigned long errors;
+
+  errors = check();
+  bench_kernels();
+  bench_readout();
+
+  if ( errors != 0 )
+  {
+    puts("FAILED");
+    return 1;
+  }
+  return 0;
+}
@@ -104,6 +104,15 @@ class U8G2 : public Print
 
     void initDisplay(void) {
       u8g2_InitDisplay(&u8g2); }
+
+    /* initDisplay() without blocking delays: initDisplayStart(), then call */
+    /* initDisplayStep() again after the returned milliseconds until it returns 0 */
+    void initDisplayStart(void) {
+      u8g2_InitDisplayStart(&u8g2); }
+    uint8_t initDisplayStep(void) {
+      return u8g2_InitDisplayStep(&u8g2); }
+    uint8_t isInitDisplayPending(void) {
+      return u8g2_IsInitDisplayPending(&u8g2); }
       
     void clearDisplay(void) {
       u8g2_ClearDisplay(&u8g2); }
@@ -156,6 +165,33 @@ class U8G2 : public Print
     void firstPage(void) { u8g2_FirstPage(&u8g2); }
     uint8_t nextPage(void) { return u8g2_NextPage(&u8g2); }
     
+    /* incremental rendering: renderStart(draw), then call renderStep() until it returns 0 */
+    void renderStart(u8g2_render_cb render_cb) { u8g2_RenderStart(&u8g2, render_cb); }
+    uint8_t renderStep(void) { return u8g2_RenderStep(&u8g2); }
+    uint8_t isRendering(void) { return u8g2_IsRendering(&u8g2); }
+    /* full buffer: draw into the back buffer while the front buffer is transferred, see u8g2_SetFrontBuffer() */
+#ifdef U8G2_WITH_FRONT_BUFFER
+    void setFrontBuffer(uint8_t *buf) { u8g2_SetFrontBuffer(&u8g2, buf); }
+    void swapBuffer(void) { u8g2_SwapBuffer(&u8g2); }
+    uint8_t transferStep(void) { return u8g2_TransferStep(&u8g2); }
+    uint8_t isSwapPending(void) { return u8g2_IsSwapPending(&u8g2); }
+#endif
+    /* u8x8 font glyphs at tile positions, sent directly to the display, see u8g2_DrawTileString() */
+    void setTileFont(const uint8_t *font_8x8) { u8g2_SetTileFont(&u8g2, font_8x8); }
+    uint8_t drawTileString(uint8_t tx, uint8_t ty, const char *s) { return u8g2_DrawTileString(&u8g2, tx, ty, s); }
+    uint8_t draw2x2TileString(uint8_t tx, uint8_t ty, const char *s) { return u8g2_Draw2x2TileString(&u8g2, tx, ty, s); }
+    /* page buffer: record the frame once, see u8g2_SetDisplayList() */
+#ifdef U8G2_WITH_DISPLAY_LIST
+    void setDisplayList(void *buf, uint16_t size) { u8g2_SetDisplayList(&u8g2, buf, size); }
+    void beginDisplayList(void) { u8g2_BeginDisplayList(&u8g2); }
+    uint8_t endDisplayList(void) { return u8g2_EndDisplayList(&u8g2); }
+    void drawDisplayList(void) { u8g2_DrawDisplayList(&u8g2); }
+    uint16_t getDisplayListUsed(void) { return u8g2_GetDisplayListUsed(&u8g2); }
+#endif
+    /* skip a group of draw procedures outside of the current page, see u8g2_BeginGroup() */
+    uint8_t beginGroup(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h) { return u8g2_BeginGroup(&u8g2, x, y, w, h); }
+    void endGroup(void) { u8g2_EndGroup(&u8g2); }
+    
     uint8_t *getBufferPtr(void) { return u8g2_GetBufferPtr(&u8g2); }
     uint8_t getBufferTileHeight(void) { return u8g2_GetBufferTileHeight(&u8g2); }
     uint8_t getBufferTileWidth(void) { return u8g2_GetBufferTileWidth(&u8g2); }
@@ -198,11 +234,24 @@ class U8G2 : public Print
       { u8g2_DrawXBM(&u8g2, x, y, w, h, bitmap); }
     void drawXBMP(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap)
       { u8g2_DrawXBMP(&u8g2, x, y, w, h, bitmap); }
-    
-    
+    void drawScaledXBM(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, uint8_t scale, const uint8_t *bitmap)
+      { u8g2_DrawScaledXBM(&u8g2, x, y, w, h, scale, bitmap); }
+    void drawScaledXBMP(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, uint8_t scale, const uint8_t *bitmap)
+      { u8g2_DrawScaledXBMP(&u8g2, x, y, w, h, scale, bitmap); }
+
+    /* u8g2_atlas.c */
+    void drawAtlasImage(u8g2_uint_t x, u8g2_uint_t y, const uint8_t *atlas, uint8_t idx)
+      { u8g2_DrawAtlasImage(&u8g2, x, y, atlas, idx); }
+    uint8_t getAtlasCount(const uint8_t *atlas) { return u8g2_GetAtlasCount(atlas); }
+    u8g2_uint_t getAtlasWidth(const uint8_t *atlas, uint8_t idx) { return u8g2_GetAtlasWidth(atlas, idx); }
+    u8g2_uint_t getAtlasHeight(const uint8_t *atlas, uint8_t idx) { return u8g2_GetAtlasHeight(atlas, idx); }
+
+
     /* u8g2_polygon.c */
     void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2) 
       { u8g2_DrawTriangle(&u8g2, x0, y0, x1, y1, x2, y2); }
+    /* polygon with points from u8g2_ClearPolygon() and u8g2_AddPolygonPoint() */
+    void drawPolygon(u8g2_polygon_t *pg) { u8g2_DrawStoredPolygon(&u8g2, pg); }
       
     
     /* u8g2_font.c */
@@ -210,6 +259,18 @@ class U8G2 : public Print
     void setFont(const uint8_t  *font) {u8g2_SetFont(&u8g2, font); }
     void setFontMode(uint8_t  is_transparent) {u8g2_SetFontMode(&u8g2, is_transparent); }
     void setFontDirection(uint8_t dir) {u8g2_SetFontDirection(&u8g2, dir); }
+#ifdef U8G2_WITH_GLYPH_CACHE
+    void setGlyphCache(void *buf, uint16_t size) { u8g2_SetGlyphCache(&u8g2, buf, size); }
+#endif
+#ifdef U8G2_WITH_GLYPH_INDEX
+    void setGlyphIndex(uint16_t *buf, uint16_t cnt) { u8g2_SetGlyphIndex(&u8g2, buf, cnt); }
+#endif
+#ifdef U8G2_WITH_KERNING_INDEX
+    void setKerningIndex(uint16_t *buf, uint16_t cnt) { u8g2_SetKerningIndex(&u8g2, buf, cnt); }
+#endif
+#ifdef U8G2_WITH_STR_WIDTH_CACHE
+    void setStrWidthCache(u8g2_str_width_entry_t *buf, uint8_t cnt) { u8g2_SetStrWidthCache(&u8g2, buf, cnt); }
+#endif
 
     int8_t getAscent(void) { return u8g2_GetAscent(&u8g2); }
     int8_t getDescent(void) { return u8g2_GetDescent(&u8g2); }
@@ -277,6 +338,20 @@ uint8_t u8g2_UserInterfaceInputValue(u8g2_t *u8g2, const char *title, const char
       return u8g2_UserInterfaceMessage(&u8g2, title1, title2, title3, buttons); }
     uint8_t userInterfaceInputValue(const char *title, const char *pre, uint8_t *value, uint8_t lo, uint8_t hi, uint8_t digits, const char *post) {
       return u8g2_UserInterfaceInputValue(&u8g2, title, pre, value, lo, hi, digits, post); }
+
+    /* non-blocking versions, see u8g2_UserInterfaceSelectionListStart() */
+    void userInterfaceSelectionListStart(u8g2_ui_selection_list_t *ui, const char *title, uint8_t start_pos, const char *sl) {
+      u8g2_UserInterfaceSelectionListStart(&u8g2, ui, title, start_pos, sl); }
+    uint8_t userInterfaceSelectionListEvent(u8g2_ui_selection_list_t *ui, uint8_t event) {
+      return u8g2_UserInterfaceSelectionListEvent(&u8g2, ui, event); }
+    void drawUserInterfaceSelectionList(u8g2_ui_selection_list_t *ui) { u8g2_DrawUserInterfaceSelectionList(&u8g2, ui); }
+    uint8_t updateUserInterfaceSelectionList(u8g2_ui_selection_list_t *ui) { return u8g2_UpdateUserInterfaceSelectionList(&u8g2, ui); }
+    void userInterfaceMessageStart(u8g2_ui_message_t *ui, const char *title1, const char *title2, const char *title3, const char *buttons) {
+      u8g2_UserInterfaceMessageStart(&u8g2, ui, title1, title2, title3, buttons); }
+    uint8_t userInterfaceMessageEvent(u8g2_ui_message_t *ui, uint8_t event) {
+      return u8g2_UserInterfaceMessageEvent(&u8g2, ui, event); }
+    void drawUserInterfaceMessage(u8g2_ui_message_t *ui) { u8g2_DrawUserInterfaceMessage(&u8g2, ui); }
+    uint8_t updateUserInterfaceMessage(u8g2_ui_message_t *ui) { return u8g2_UpdateUserInterfaceMessage(&u8g2, ui); }
     
 
      /* LiquidCrystal compatible functions */
@@ -6311,6 +6386,48 @@ class U8G2_MAX7219_32X8_F_2ND_4W_HW_SPI : public U8G2 {
 
 /* Arduino constructor list end */
 
+/* ST7920 full buffer with dirty row tracking: only changed pixel rows are transmitted, each object has its own shadow buffer */
+class U8G2_ST7920_128X64_F_DIRTY_SW_SPI : public U8G2 {
+  uint8_t shadow[U8X8_ST7920_128X64_SHADOW_SIZE];
+  public: U8G2_ST7920_128X64_F_DIRTY_SW_SPI(const u8g2_cb_t *rotation, uint8_t clock, uint8_t data, uint8_t cs, uint8_t reset = U8X8_PIN_NONE) : U8G2() {
+    u8g2_Setup_st7920_s_128x64_dirty_f(&u8g2, rotation, u8x8_byte_arduino_4wire_sw_spi, u8x8_gpio_and_delay_arduino);
+    u8x8_SetPin_3Wire_SW_SPI(getU8x8(), clock, data, cs, reset);
+    u8x8_SetDisplayShadow(getU8x8(), shadow);
+  }
+};
+class U8G2_ST7920_128X64_F_DIRTY_HW_SPI : public U8G2 {
+  uint8_t shadow[U8X8_ST7920_128X64_SHADOW_SIZE];
+  public: U8G2_ST7920_128X64_F_DIRTY_HW_SPI(const u8g2_cb_t *rotation, uint8_t cs, uint8_t reset = U8X8_PIN_NONE) : U8G2() {
+    u8g2_Setup_st7920_s_128x64_dirty_f(&u8g2, rotation, u8x8_byte_arduino_hw_spi, u8x8_gpio_and_delay_arduino);
+    u8x8_SetPin_ST7920_HW_SPI(getU8x8(), cs, reset);
+    u8x8_SetDisplayShadow(getU8x8(), shadow);
+  }
+};
+
+#ifdef U8X8_HAVE_SAM_USART_SPI
+/* Arduino Due only: clock at A0 (SCK1), data at pin 16 (TXD1) */
+class U8G2_ST7920_128X64_1_SAM_USART_SPI : public U8G2 {
+  public: U8G2_ST7920_128X64_1_SAM_USART_SPI(const u8g2_cb_t *rotation, uint8_t cs, uint8_t reset = U8X8_PIN_NONE) : U8G2() {
+    u8g2_Setup_st7920_s_128x64_1(&u8g2, rotation, u8x8_byte_arduino_sam_usart_spi, u8x8_gpio_and_delay_arduino);
+    u8x8_SetPin_ST7920_HW_SPI(getU8x8(), cs, reset);
+  }
+};
+class U8G2_ST7920_128X64_F_SAM_USART_SPI : public U8G2 {
+  public: U8G2_ST7920_128X64_F_SAM_USART_SPI(const u8g2_cb_t *rotation, uint8_t cs, uint8_t reset = U8X8_PIN_NONE) : U8G2() {
+    u8g2_Setup_st7920_s_128x64_f(&u8g2, rotation, u8x8_byte_arduino_sam_usart_spi, u8x8_gpio_and_delay_arduino);
+    u8x8_SetPin_ST7920_HW_SPI(getU8x8(), cs, reset);
+  }
+};
+class U8G2_ST7920_128X64_F_DIRTY_SAM_USART_SPI : public U8G2 {
+  uint8_t shadow[U8X8_ST7920_128X64_SHADOW_SIZE];
+  public: U8G2_ST7920_128X64_F_DIRTY_SAM_USART_SPI(const u8g2_cb_t *rotation, uint8_t cs, uint8_t reset = U8X8_PIN_NONE) : U8G2() {
+    u8g2_Setup_st7920_s_128x64_dirty_f(&u8g2, rotation, u8x8_byte_arduino_sam_usart_spi, u8x8_gpio_and_delay_arduino);
+    u8x8_SetPin_ST7920_HW_SPI(getU8x8(), cs, reset);
+    u8x8_SetDisplayShadow(getU8x8(), shadow);
+  }
+};
+#endif
+
 #endif // U8X8_USE_PINS
 
 class U8G2_BITMAP : public U8G2 {
@@ -6325,5 +6442,225 @@ class U8G2_BITMAP : public U8G2 {
   }
 };
 
+#if __cplusplus >= 201103L
+
+/*
+  U8G2T<Display, Rotation, BufferMode>: U8G2 with a fixed rotation and
+  buffer layout.
+
+  U8G2 selects the rotation (u8g2->cb->draw_l90) and the buffer layout 
+  (u8g2->ll_hvline) with function pointers, so each line of a box or a
+  frame makes up to two indirect calls. U8G2T binds both as template 
+  arguments and calls the procedures of the C library directly: 
+  u8g2_draw_l90_r1() ... u8g2_draw_l90_mirrorr_r0() for the rotation and 
+  u8g2_ll_hvline_vertical_top_lsb() or u8g2_ll_hvline_horizontal_right_lsb()
+  for the buffer. Only pixel, lines, box and frame are bound, text and 
+  all other procedures are the usual u8g2 procedures.
+  
+    Display	one of the U8G2 classes above, rotation is the first argument
+		of its constructor and is omitted for U8G2T
+    Rotation	U8G2T_R0, U8G2T_R1, U8G2T_R2, U8G2T_R3 or U8G2T_MIRROR
+    BufferMode	buffer layout of the display, same as u8g2->ll_hvline of the
+		u8g2_Setup_xxx() procedure of the display:
+		U8G2T_VERTICAL_TOP_LSB (most displays, e.g. SSD1306, UC1701)
+		U8G2T_HORIZONTAL_RIGHT_LSB (e.g. ST7920, LS013B7DH03)
+  
+  Example:
+    U8G2T<U8G2_ST7920_128X64_F_SW_SPI, U8G2T_R0, U8G2T_HORIZONTAL_RIGHT_LSB> u8g2(13, 11, 10, 8);
+  
+  The methods of U8G2 are not virtual. The methods below hide them only
+  if they are called for the U8G2T type itself: a call through a U8G2 
+  reference or pointer, e.g. a "void draw(U8G2 &u8g2)" procedure, takes 
+  the usual u8g2 procedures without any warning. Pass the U8G2T type 
+  (a typedef helps) to such procedures.
+  
+  setDisplayRotation() is not available. A wrong BufferMode gives a 
+  wrong picture, but writes only into the buffer of the display.
+*/
+
+/* U8G2T rotation */
+struct U8G2T_R0 {
+  static const uint8_t is_r0 = 1;
+  static const u8g2_cb_t *cb(void) { return U8G2_R0; }
+  static void drawL90(u8g2_t *, u8g2_uint_t, u8g2_uint_t, u8g2_uint_t, uint8_t) { }
+};
+
+struct U8G2T_R1 {
+  static const uint8_t is_r0 = 0;
+  static const u8g2_cb_t *cb(void) { return U8G2_R1; }
+  static void drawL90(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir) {
+    u8g2_draw_l90_r1(u8g2, x, y, len, dir); }
+};
+
+struct U8G2T_R2 {
+  static const uint8_t is_r0 = 0;
+  static const u8g2_cb_t *cb(void) { return U8G2_R2; }
+  static void drawL90(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir) {
+    u8g2_draw_l90_r2(u8g2, x, y, len, dir); }
+};
+
+struct U8G2T_R3 {
+  static const uint8_t is_r0 = 0;
+  static const u8g2_cb_t *cb(void) { return U8G2_R3; }
+  static void drawL90(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir) {
+    u8g2_draw_l90_r3(u8g2, x, y, len, dir); }
+};
+
+struct U8G2T_MIRROR {
+  static const uint8_t is_r0 = 0;
+  static const u8g2_cb_t *cb(void) { return U8G2_MIRROR; }
+  static void drawL90(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir) {
+    u8g2_draw_l90_mirrorr_r0(u8g2, x, y, len, dir); }
+};
+
+/* U8G2T buffer layouts */
+struct U8G2T_VERTICAL_TOP_LSB {
+  static void hvline(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir) {
+    u8g2_ll_hvline_vertical_top_lsb(u8g2, x, y, len, dir); }
+};
+
+struct U8G2T_HORIZONTAL_RIGHT_LSB {
+  static void hvline(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir) {
+    u8g2_ll_hvline_horizontal_right_lsb(u8g2, x, y, len, dir); }
+};
+
+template <class Display, class Rotation = U8G2T_R0, class BufferMode = U8G2T_VERTICAL_TOP_LSB>
+class U8G2T : public Display
+{
+  private:
+    void setDisplayRotation(const u8g2_cb_t *u8g2_cb);
+    
+    /* u8g2_draw_hv_line_4dir() and u8g2_draw_hv_line_2dir() for U8G2_R0 */
+    static void drawBufferHVLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir) {
+#ifdef U8G2_WITH_HVLINE_COUNT
+      u8g2->hv_cnt++;
+#endif /* U8G2_WITH_HVLINE_COUNT */   
+      if ( dir == 2 ) {
+        x -= len;
+        x++; }
+      else if ( dir == 3 ) {
+        y -= len;
+        y++; }
+      dir &= 1;
+#ifdef U8G2_WITH_CLIPPING
+      u8g2_uint_t a;
+      y -= u8g2->tile_curr_row*8;
+      if ( dir == 0 ) {
+        if ( y >= u8g2->pixel_buf_height )
+          return;
+        a = x;
+        a += len;
+        if ( u8g2_clip_intersection(&x, &a, u8g2->pixel_buf_width) == 0 )
+          return;
+        len = a;
+        len -= x; }
+      else {
+        if ( x >= u8g2->pixel_buf_width )
+          return;
+        a = y;
+        a += len;
+        if ( u8g2_clip_intersection(&y, &a, u8g2->pixel_buf_height) == 0 )
+          return;
+        len = a;
+        len -= y; }
+#endif /* U8G2_WITH_CLIPPING */
+      BufferMode::hvline(u8g2, x, y, len, dir); }
+    
+    /* u8g2_DrawHVLine() without the display list */
+    static void drawRotatedHVLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir) {
+      if ( len == 0 )
+        return;
+      if ( Rotation::is_r0 )
+        drawBufferHVLine(u8g2, x, y, len, dir);
+      else
+        Rotation::drawL90(u8g2, x, y, len, dir); }
+    
+  public:
+    template <typename... Args> U8G2T(Args... args) : Display(Rotation::cb(), args...) { }
+    
+    void drawHVLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir) {
+#ifdef U8G2_WITH_DISPLAY_LIST
+      if ( u8g2_IsRecording(&this->u8g2) ) {
+        u8g2_DrawHVLine(&this->u8g2, x, y, len, dir);
+        return; }
+#endif
+      drawRotatedHVLine(&this->u8g2, x, y, len, dir); }
+    
+    void drawHLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w) {
+#ifdef U8G2_WITH_DISPLAY_LIST
+      if ( u8g2_IsRecording(&this->u8g2) ) {
+        u8g2_DrawHLine(&this->u8g2, x, y, w);
+        return; }
+#endif
+#ifdef U8G2_WITH_INTERSECTION
+      if ( u8g2_IsIntersection(&this->u8g2, x, y, x+w, y+1) == 0 ) 
+        return;
+#endif
+      drawRotatedHVLine(&this->u8g2, x, y, w, 0); }
+    
+    void drawVLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t h) {
+#ifdef U8G2_WITH_DISPLAY_LIST
+      if ( u8g2_IsRecording(&this->u8g2) ) {
+        u8g2_DrawVLine(&this->u8g2, x, y, h);
+        return; }
+#endif
+#ifdef U8G2_WITH_INTERSECTION
+      if ( u8g2_IsIntersection(&this->u8g2, x, y, x+1, y+h) == 0 ) 
+        return;
+#endif
+      drawRotatedHVLine(&this->u8g2, x, y, h, 1); }
+    
+    void drawPixel(u8g2_uint_t x, u8g2_uint_t y) {
+#ifdef U8G2_WITH_DISPLAY_LIST
+      if ( u8g2_IsRecording(&this->u8g2) ) {
+        u8g2_DrawPixel(&this->u8g2, x, y);
+        return; }
+#endif
+#ifdef U8G2_WITH_INTERSECTION
+      if ( y < this->u8g2.user_y0 || y >= this->u8g2.user_y1 || x < this->u8g2.user_x0 || x >= this->u8g2.user_x1 )
+        return;
+#endif
+      drawRotatedHVLine(&this->u8g2, x, y, 1, 0); }
+    
+    void drawBox(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h) {
+      u8g2_t *u8g2 = &this->u8g2;
+      /* u8g2_DrawBox() has no callback for U8G2_R0 */
+      if ( Rotation::is_r0 ) {
+        u8g2_DrawBox(u8g2, x, y, w, h);
+        return; }
+#ifdef U8G2_WITH_DISPLAY_LIST
+      if ( u8g2_IsRecording(u8g2) ) {
+        u8g2_DrawBox(u8g2, x, y, w, h);
+        return; }
+#endif
+#ifdef U8G2_WITH_INTERSECTION
+      if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
+        return;
+#endif
+      while( h != 0 ) {
+        drawRotatedHVLine(u8g2, x, y, w, 0);
+        y++;
+        h--; } }
+    
+    void drawFrame(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h) {
+      u8g2_t *u8g2 = &this->u8g2;
+#ifdef U8G2_WITH_DISPLAY_LIST
+      if ( u8g2_IsRecording(u8g2) ) {
+        u8g2_DrawFrame(u8g2, x, y, w, h);
+        return; }
+#endif
+#ifdef U8G2_WITH_INTERSECTION
+      if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
+        return;
+#endif
+      drawRotatedHVLine(u8g2, x, y, w, 0);
+      drawRotatedHVLine(u8g2, x, y, h, 1);
+      drawRotatedHVLine(u8g2, x+w-1, y, h, 1);
+      drawRotatedHVLine(u8g2, x, y+h-1, w, 0); }
+};
+
+#endif /* __cplusplus >= 201103L */
+
+
 #endif /* _U8G2LIB_HH */
 
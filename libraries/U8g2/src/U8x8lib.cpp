@@ -327,6 +327,156 @@ extern "C" uint8_t u8x8_byte_arduino_4wire_sw_spi(u8x8_t *u8x8, uint8_t msg, uin
   return 1;
 }
 
+#elif defined(__SAM3X8E__)
+
+/* 
+  Arduino Due: this function completly replaces u8x8_byte_4wire_sw_spi
+  Data and clock are written to the PIO set/clear registers. The delay 
+  procedure is not called, instead the half clock period is derived from 
+  sck_pulse_width_ns and sck_clock_hz.
+*/
+
+/* lower bound for the number of cycles of the register writes between two clock edges */
+#define U8X8_SAM_SW_SPI_EDGE_CYCLES 4
+/* lower bound for the number of cycles of one delay loop */
+#define U8X8_SAM_SW_SPI_LOOP_CYCLES 3
+
+static void u8x8_sam_sw_spi_delay(uint32_t cnt) U8X8_NOINLINE;
+static void u8x8_sam_sw_spi_delay(uint32_t cnt)
+{
+  while( cnt > 0 )
+  {
+    __asm__ __volatile__ ("nop");
+    cnt--;
+  }
+}
+
+#define U8X8_SAM_SW_SPI_BIT(bit, delay) \
+  if ( b & (bit) ) \
+    *arduino_data_set = arduino_data_mask; \
+  else \
+    *arduino_data_clr = arduino_data_mask; \
+  *arduino_clock_leading = arduino_clock_mask; \
+  delay; \
+  *arduino_clock_takeover = arduino_clock_mask; \
+  delay
+
+#define U8X8_SAM_SW_SPI_BYTE(delay) \
+  U8X8_SAM_SW_SPI_BIT(128, delay); \
+  U8X8_SAM_SW_SPI_BIT(64, delay); \
+  U8X8_SAM_SW_SPI_BIT(32, delay); \
+  U8X8_SAM_SW_SPI_BIT(16, delay); \
+  U8X8_SAM_SW_SPI_BIT(8, delay); \
+  U8X8_SAM_SW_SPI_BIT(4, delay); \
+  U8X8_SAM_SW_SPI_BIT(2, delay); \
+  U8X8_SAM_SW_SPI_BIT(1, delay)
+
+extern "C" uint8_t u8x8_byte_arduino_4wire_sw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  uint8_t b;
+  uint8_t *data;
+  uint32_t ns;
+  uint32_t cycles;
+  Pio *pio;
+
+  /* the following static vars are recalculated in U8X8_MSG_BYTE_START_TRANSFER */
+  /* so, it should be possible to used multiple displays with different pins */
+  
+  static volatile uint32_t *arduino_clock_leading;
+  static volatile uint32_t *arduino_clock_takeover;
+  static uint32_t arduino_clock_mask;
+  
+  static volatile uint32_t *arduino_data_set;
+  static volatile uint32_t *arduino_data_clr;
+  static uint32_t arduino_data_mask;
+  
+  static uint32_t arduino_delay_cnt;
+
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_SEND:
+#ifdef U8X8_WITH_GPIO_COUNT
+      /* three register writes per bit */
+      u8x8->gpio_cnt += (unsigned long)arg_int*24;
+#endif /* U8X8_WITH_GPIO_COUNT */
+      data = (uint8_t *)arg_ptr;
+      if ( arduino_delay_cnt == 0 )
+      {
+	while( arg_int > 0 )
+	{
+	  b = *data;
+	  data++;
+	  arg_int--;
+	  U8X8_SAM_SW_SPI_BYTE((void)0);
+	}
+      }
+      else
+      {
+	while( arg_int > 0 )
+	{
+	  b = *data;
+	  data++;
+	  arg_int--;
+	  U8X8_SAM_SW_SPI_BYTE(u8x8_sam_sw_spi_delay(arduino_delay_cnt));
+	}
+      }
+      break;
+      
+    case U8X8_MSG_BYTE_INIT:
+      /* disable chipselect */
+      u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_disable_level);
+      /* no wait required here */
+      
+      /* for SPI: setup correct level of the clock signal */
+      u8x8_gpio_SetSPIClock(u8x8, u8x8_GetSPIClockPhase(u8x8));
+      break;
+    case U8X8_MSG_BYTE_SET_DC:
+      u8x8_gpio_SetDC(u8x8, arg_int);
+      break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_enable_level);  
+      u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_NANO, u8x8->display_info->post_chip_enable_wait_ns, NULL);
+
+      /* there is no consistency checking for u8x8->pins[U8X8_PIN_SPI_CLOCK] */
+      pio = digitalPinToPort(u8x8->pins[U8X8_PIN_SPI_CLOCK]);
+      arduino_clock_mask = digitalPinToBitMask(u8x8->pins[U8X8_PIN_SPI_CLOCK]);
+      if ( u8x8_GetSPIClockPhase(u8x8) == 0 )
+      {
+	/* data is taken over with the falling edge */
+	arduino_clock_leading = &(pio->PIO_SODR);
+	arduino_clock_takeover = &(pio->PIO_CODR);
+      }
+      else
+      {
+	arduino_clock_leading = &(pio->PIO_CODR);
+	arduino_clock_takeover = &(pio->PIO_SODR);
+      }
+
+      /* there is no consistency checking for u8x8->pins[U8X8_PIN_SPI_DATA] */
+      pio = digitalPinToPort(u8x8->pins[U8X8_PIN_SPI_DATA]);
+      arduino_data_mask = digitalPinToBitMask(u8x8->pins[U8X8_PIN_SPI_DATA]);
+      arduino_data_set = &(pio->PIO_SODR);
+      arduino_data_clr = &(pio->PIO_CODR);
+      
+      /* half clock period: the sck pulse width, but not faster than sck_clock_hz */
+      ns = 500000000UL / u8x8->display_info->sck_clock_hz;
+      if ( ns < u8x8->display_info->sck_pulse_width_ns )
+	ns = u8x8->display_info->sck_pulse_width_ns;
+      cycles = (ns * (F_CPU / 1000000UL) + 999UL) / 1000UL;
+      arduino_delay_cnt = 0;
+      if ( cycles > U8X8_SAM_SW_SPI_EDGE_CYCLES )
+	arduino_delay_cnt = (cycles - U8X8_SAM_SW_SPI_EDGE_CYCLES + U8X8_SAM_SW_SPI_LOOP_CYCLES - 1) / U8X8_SAM_SW_SPI_LOOP_CYCLES;
+      break;
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_NANO, u8x8->display_info->pre_chip_disable_wait_ns, NULL);
+      u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_disable_level);
+      break;
+    default:
+      return 0;
+  }
+  return 1;
+}
+
 #else
   /* fallback */
   uint8_t u8x8_byte_arduino_4wire_sw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
@@ -529,6 +679,86 @@ extern "C" uint8_t u8x8_byte_arduino_2nd_hw_spi(U8X8_UNUSED u8x8_t *u8x8, U8X8_U
   return 1;
 }
 
+/*=============================================*/
+/*
+  SAM3X (Arduino Due): USART1 in SPI master mode, fed by the PDC
+  SCK1 = PA16 (A0), TXD1 = PA13 (TX2, pin 16), chip select is a GPIO.
+  The data is buffered by u8x8_byte_dma(), so the CPU continues while 
+  the previous tile row is transmitted.
+*/
+
+#ifdef U8X8_HAVE_SAM_USART_SPI
+
+#define U8X8_SAM_USART_SPI_BUF_SIZE 512
+
+static uint8_t u8x8_sam_usart_spi_buf[2][U8X8_SAM_USART_SPI_BUF_SIZE];
+
+static void u8x8_sam_usart_spi_start(const uint8_t *data, uint16_t cnt)
+{
+  USART1->US_TPR = (uint32_t)data;
+  USART1->US_TCR = cnt;
+  USART1->US_PTCR = US_PTCR_TXTEN;
+}
+
+static uint8_t u8x8_sam_usart_spi_is_busy(void)
+{
+  /* TXEMPTY is still set for a short moment after the PDC has been started */
+  if ( USART1->US_TCR != 0 )
+    return 1;
+  if ( (USART1->US_CSR & US_CSR_TXEMPTY) == 0 )
+    return 1;
+  return 0;
+}
+
+static u8x8_dma_t u8x8_sam_usart_spi_dma = 
+{
+  { u8x8_sam_usart_spi_buf[0], u8x8_sam_usart_spi_buf[1] }, 
+  U8X8_SAM_USART_SPI_BUF_SIZE,
+  u8x8_sam_usart_spi_start, 
+  u8x8_sam_usart_spi_is_busy,
+  0, 0, 0
+};
+
+static void u8x8_sam_usart_spi_init(u8x8_t *u8x8)
+{
+  uint32_t mode;
+  uint32_t cd;
+  
+  pmc_enable_periph_clk(ID_USART1);
+  PIO_Configure(PIOA, PIO_PERIPH_A, PIO_PA13A_TXD1 | PIO_PA16A_SCK1, PIO_DEFAULT);
+  
+  USART1->US_PTCR = US_PTCR_TXTDIS | US_PTCR_RXTDIS;
+  USART1->US_CR = US_CR_RSTRX | US_CR_RSTTX | US_CR_RXDIS | US_CR_TXDIS;
+  
+  /* USART CPHA is inverted compared to the usual SPI mode numbering */
+  mode = US_MR_USART_MODE_SPI_MASTER | US_MR_USCLKS_MCK | US_MR_CHRL_8_BIT | US_MR_CHMODE_NORMAL | US_MR_CLKO;
+  switch(u8x8->display_info->spi_mode)
+  {
+    case 0: mode |= US_MR_CPHA; break;
+    case 1: break;
+    case 2: mode |= US_MR_CPOL | US_MR_CPHA; break;
+    case 3: mode |= US_MR_CPOL; break;
+  }
+  USART1->US_MR = mode;
+  
+  /* SPI master: CD must be at least 6 */
+  cd = (SystemCoreClock + u8x8->display_info->sck_clock_hz - 1) / u8x8->display_info->sck_clock_hz;
+  if ( cd < 6 )
+    cd = 6;
+  USART1->US_BRGR = cd;
+  
+  USART1->US_CR = US_CR_TXEN;
+}
+
+extern "C" uint8_t u8x8_byte_arduino_sam_usart_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  if ( msg == U8X8_MSG_BYTE_INIT )
+    u8x8_sam_usart_spi_init(u8x8);
+  return u8x8_byte_dma(u8x8, &u8x8_sam_usart_spi_dma, msg, arg_int, arg_ptr);
+}
+
+#endif /* U8X8_HAVE_SAM_USART_SPI */
+
 
 /*=============================================*/
 
@@ -91,6 +91,11 @@
 #endif
 #endif
 
+/* define U8X8_HAVE_SAM_USART_SPI for the Arduino Due: USART1 as SPI master with PDC transfer */
+#ifdef __SAM3X8E__
+#define U8X8_HAVE_SAM_USART_SPI
+#endif
+
 
 extern "C" uint8_t u8x8_gpio_and_delay_arduino(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 extern "C" uint8_t u8x8_byte_arduino_8bit_8080mode(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
@@ -100,6 +105,9 @@ extern "C" uint8_t u8x8_byte_arduino_2nd_hw_spi(u8x8_t *u8x8, uint8_t msg, uint8
 extern "C" uint8_t u8x8_byte_arduino_hw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 extern "C" uint8_t u8x8_byte_arduino_2nd_hw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 extern "C" uint8_t u8x8_byte_arduino_ks0108(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+#ifdef U8X8_HAVE_SAM_USART_SPI
+extern "C" uint8_t u8x8_byte_arduino_sam_usart_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+#endif
 
 #ifdef U8X8_USE_PINS
 void u8x8_SetPin_4Wire_SW_SPI(u8x8_t *u8x8, uint8_t clock, uint8_t data, uint8_t cs, uint8_t dc, uint8_t reset);
@@ -163,6 +171,15 @@ class U8X8 : public Print
       
     void initDisplay(void) {
       u8x8_InitDisplay(&u8x8); }
+
+    /* initDisplay() without blocking delays: initDisplayStart(), then call */
+    /* initDisplayStep() again after the returned milliseconds until it returns 0 */
+    void initDisplayStart(void) {
+      u8x8_InitDisplayStart(&u8x8); }
+    uint8_t initDisplayStep(void) {
+      return u8x8_InitDisplayStep(&u8x8); }
+    uint8_t isInitDisplayPending(void) {
+      return u8x8_IsInitDisplayPending(&u8x8); }
       
     void clearDisplay(void) {
       u8x8_ClearDisplay(&u8x8); }
@@ -212,6 +229,12 @@ class U8X8 : public Print
     void draw2x2Glyph(uint8_t x, uint8_t y, uint8_t encoding) {
       u8x8_Draw2x2Glyph(&u8x8, x, y, encoding); }
 
+    void draw3x3Glyph(uint8_t x, uint8_t y, uint8_t encoding) {
+      u8x8_Draw3x3Glyph(&u8x8, x, y, encoding); }
+
+    void draw4x4Glyph(uint8_t x, uint8_t y, uint8_t encoding) {
+      u8x8_Draw4x4Glyph(&u8x8, x, y, encoding); }
+
     void drawString(uint8_t x, uint8_t y, const char *s) {
       u8x8_DrawString(&u8x8, x, y, s); }
       
@@ -223,6 +246,12 @@ class U8X8 : public Print
       
     void draw2x2UTF8(uint8_t x, uint8_t y, const char *s) {
       u8x8_Draw2x2UTF8(&u8x8, x, y, s); }
+
+    void draw3x3String(uint8_t x, uint8_t y, const char *s) {
+      u8x8_Draw3x3String(&u8x8, x, y, s); }
+
+    void draw4x4String(uint8_t x, uint8_t y, const char *s) {
+      u8x8_Draw4x4String(&u8x8, x, y, s); }
       
     uint8_t getUTF8Len(const char *s) {
       return u8x8_GetUTF8Len(&u8x8, s); }
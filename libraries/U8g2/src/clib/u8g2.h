@@ -88,6 +88,15 @@
 */
 #define U8G2_HVLINE_SPEED_OPTIMIZATION
 
+/*
+  The following macro enables 32 bit memory access for horizontal lines and boxes 
+  in u8g2_ll_span_vertical_top_lsb(). Requires gcc and is not useful for 8 bit
+  controllers.
+*/
+#if defined(__GNUC__) && !defined(__AVR__)
+#define U8G2_WITH_WORD_SPAN
+#endif
+
 /*
   The following macro enables all four drawing directions for glyphs and strings.
   If this macro is not defined, than a string can be drawn only in horizontal direction.
@@ -136,6 +145,88 @@
 */
 //#define U8G2_WITH_HVLINE_COUNT
 
+/*
+  The following features up to U8G2_WITH_BITMAP_BLIT are not enabled for 
+  AVR: they add flash memory, and most of them work with tables in RAM 
+  which is rarely available on AVR boards.
+*/
+
+/*
+  Defining the following variable adds u8g2_SetGlyphCache(): Decoded glyphs
+  are kept as bitmaps in a memory area which is provided by the application.
+  The cache is only used after u8g2_SetGlyphCache() has been called.
+  Without the cache, each glyph is decoded again on every page and frame.
+*/
+#ifndef __AVR__
+#define U8G2_WITH_GLYPH_CACHE
+#endif
+
+/*
+  Defining the following variable adds u8g2_SetGlyphIndex(): u8g2_SetFont()
+  builds a table of glyph positions in a memory area which is provided by
+  the application. Glyphs 0..255 are found with one table access, unicode
+  glyphs with a binary search. Without index, the glyph data is searched
+  linearly. The table for the glyphs 0..255 alone requires 512 bytes.
+*/
+#ifndef __AVR__
+#define U8G2_WITH_GLYPH_INDEX
+#endif
+
+/*
+  Defining the following variable adds u8g2_SetKerningIndex(): the pairs 
+  of a kerning pair list (u8g2_DrawExtUTF8()) are copied once into a sorted
+  table in a memory area which is provided by the application. Kerning 
+  pairs are then found with a binary search instead of a linear search.
+  Each pair requires three words of the table.
+*/
+#ifndef __AVR__
+#define U8G2_WITH_KERNING_INDEX
+#endif
+
+/*
+  Defining the following variable adds u8g2_SetStrWidthCache(): The width
+  of measured strings is kept in a table which is provided by the 
+  application, so that centered labels are not measured again on each 
+  page and frame. The table is cleared by u8g2_SetFont() if the font 
+  changes. Only useful if the same labels are measured repeatedly.
+*/
+#ifndef __AVR__
+#define U8G2_WITH_STR_WIDTH_CACHE
+#endif
+
+/*
+  Defining the following variable adds u8g2_SetDisplayList(): With a page 
+  buffer, u8g2_RenderStep() records the draw procedures of a frame once into 
+  a memory area which is provided by the application and replays only the 
+  part which is visible on the current page. Only useful with a page 
+  buffer: a full buffer is drawn once per frame anyway.
+*/
+#ifndef __AVR__
+#define U8G2_WITH_DISPLAY_LIST
+#endif
+
+/*
+  Defining the following variable adds u8g2_SetFrontBuffer(): A full buffer
+  is drawn while the previous frame is transferred from a second buffer, 
+  which is provided by the application. Only changed tile rows are sent.
+  This adds the front buffer pointer and the transfer state to u8g2_t, 
+  also if u8g2_SetFrontBuffer() is not called.
+*/
+#ifndef __AVR__
+#define U8G2_WITH_FRONT_BUFFER
+#endif
+
+/*
+  Defining the following variable lets the bitmap procedures (u8g2_DrawXBM(),
+  u8g2_DrawBitmap(), ...) write whole bytes into the buffer with 
+  u8g2_BlitBitmap() instead of one u8g2_DrawHVLine() per pixel. Used with
+  U8G2_R0 for the ST7920 and the vertical_top_lsb buffer. Active without 
+  further setup, other rotations and buffers use u8g2_DrawHVLine().
+*/
+#ifndef __AVR__
+#define U8G2_WITH_BITMAP_BLIT
+#endif
+
 /*
   Defining the following variable adds the clipping and check procedures agains the display boundaries.
   Clipping procedures are mandatory for the picture loop (u8g2_FirstPage/NextPage).
@@ -197,6 +288,9 @@ typedef void (*u8g2_draw_ll_hvline_cb)(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t
 
 typedef uint8_t (*u8g2_get_kerning_cb)(u8g2_t *u8g2, uint16_t e1, uint16_t e2);
 
+/* draw procedure for u8g2_RenderStart/u8g2_RenderStep */
+typedef void (*u8g2_render_cb)(u8g2_t *u8g2);
+
 
 /* from ucglib... */
 struct _u8g2_font_info_t
@@ -272,6 +366,126 @@ struct _u8g2_kerning_t
 typedef struct _u8g2_kerning_t u8g2_kerning_t;
 
 
+#ifdef U8G2_WITH_GLYPH_CACHE
+/* LRU cache for decoded glyphs, see u8g2_SetGlyphCache() */
+struct _u8g2_glyph_cache_t
+{
+  uint8_t *buf;				/* NULL if the cache is disabled */
+  uint16_t size;			/* size of buf in bytes */
+  uint16_t used;			/* number of bytes occupied by the entries */
+  uint16_t tick;			/* incremented with each lookup */
+  unsigned long hit_cnt;
+  unsigned long miss_cnt;
+};
+typedef struct _u8g2_glyph_cache_t u8g2_glyph_cache_t;
+#endif /* U8G2_WITH_GLYPH_CACHE */
+
+#ifdef U8G2_WITH_GLYPH_INDEX
+/* glyph position table, see u8g2_SetGlyphIndex() */
+struct _u8g2_glyph_index_t
+{
+  uint16_t *buf;			/* NULL if the index is disabled */
+  uint16_t cnt;				/* number of words in buf */
+  const uint8_t *font;			/* font of the table, NULL if the table is not valid */
+  uint16_t unicode_cnt;			/* number of unicode table entries */
+  uint8_t unicode_step;			/* number of unicode glyphs per table entry */
+};
+typedef struct _u8g2_glyph_index_t u8g2_glyph_index_t;
+#endif /* U8G2_WITH_GLYPH_INDEX */
+
+#ifdef U8G2_WITH_KERNING_INDEX
+/* sorted kerning pairs, see u8g2_SetKerningIndex() */
+struct _u8g2_kerning_index_t
+{
+  uint16_t *buf;			/* NULL if the index is disabled */
+  uint16_t cnt;				/* number of words in buf */
+  const uint16_t *table;		/* pair list of the index, NULL if no list was indexed */
+  uint16_t pair_cnt;			/* number of pairs, three words each */
+  uint8_t is_valid;			/* 0: table does not fit into buf */
+};
+typedef struct _u8g2_kerning_index_t u8g2_kerning_index_t;
+#endif /* U8G2_WITH_KERNING_INDEX */
+
+#ifdef U8G2_WITH_STR_WIDTH_CACHE
+/* width of a measured string, see u8g2_SetStrWidthCache() */
+struct _u8g2_str_width_entry_t
+{
+  const char *str;
+  uint16_t hash;			/* hash of the characters, detects modified strings in RAM */
+  u8g2_uint_t width;
+  uint8_t kind;				/* measure procedure, U8G2_STR_WIDTH_ASCII, _UTF8 or _EXACT */
+};
+typedef struct _u8g2_str_width_entry_t u8g2_str_width_entry_t;
+
+struct _u8g2_str_width_cache_t
+{
+  u8g2_str_width_entry_t *buf;		/* NULL if the cache is disabled */
+  uint8_t cnt;				/* number of entries in buf */
+  uint8_t used;				/* number of valid entries */
+  uint8_t next;				/* entry which is replaced next */
+  unsigned long hit_cnt;
+  unsigned long miss_cnt;
+};
+typedef struct _u8g2_str_width_cache_t u8g2_str_width_cache_t;
+#endif /* U8G2_WITH_STR_WIDTH_CACHE */
+
+#ifdef U8G2_WITH_DISPLAY_LIST
+/* recorded draw procedures, see u8g2_SetDisplayList() */
+struct _u8g2_display_list_t
+{
+  uint8_t *buf;				/* NULL if the display list is disabled */
+  uint16_t size;			/* size of buf in bytes */
+  uint16_t used;			/* number of bytes occupied by the items */
+  uint16_t state_pos;			/* position of the last state item */
+  uint16_t group_pos;			/* position of the innermost open group item */
+  uint16_t bucket_pos;			/* start of the bucket table at the end of buf */
+  uint8_t is_recording;
+  uint8_t is_valid;			/* 0: the items do not describe the complete frame */
+};
+typedef struct _u8g2_display_list_t u8g2_display_list_t;
+#endif /* U8G2_WITH_DISPLAY_LIST */
+
+/* maximum number of points of a polygon, highest possible value is 254 */
+#ifndef U8G2_POLYGON_MAX_POINTS
+#define U8G2_POLYGON_MAX_POINTS 6
+#endif
+
+/* edge of the left or right side of a polygon, from y1 (upper end) to y2 */
+struct _u8g2_polygon_edge_t
+{
+  int16_t x1;
+  int16_t y1;
+  int16_t y2;
+  int16_t height;			/* y2 - y1, never 0 */
+  int16_t x_offset;			/* x step per scan line */
+  int16_t error_offset;
+  int16_t error_start;
+  int8_t x_direction;
+};
+typedef struct _u8g2_polygon_edge_t u8g2_polygon_edge_t;
+
+/* convex polygon with a prepared edge table, see u8g2_DrawStoredPolygon() */
+struct _u8g2_polygon_t
+{
+  int16_t x[U8G2_POLYGON_MAX_POINTS];
+  int16_t y[U8G2_POLYGON_MAX_POINTS];
+  uint8_t cnt;
+  uint8_t is_prepared;			/* 0: the edge table must be calculated again */
+  
+  /* edge table: left side edges 0..edge_end[0]-1, right side edges edge_end[0]..edge_end[1]-1, sorted by y */
+  u8g2_polygon_edge_t edge[U8G2_POLYGON_MAX_POINTS];
+  uint8_t edge_end[2];
+  int16_t y_first;			/* first and last scan line */
+  int16_t y_last;
+  
+  /* scan line position after the last draw, continued by the next page */
+  int16_t next_y;
+  uint8_t curr_edge[2];
+  int16_t curr_x[2];
+  int16_t curr_error[2];
+};
+typedef struct _u8g2_polygon_t u8g2_polygon_t;
+
 struct u8g2_cb_struct
 {
   u8g2_update_dimension_cb update;
@@ -324,6 +538,18 @@ struct u8g2_struct
   u8g2_font_calc_vref_fnptr font_calc_vref;
   u8g2_font_decode_t font_decode;		/* new font decode structure */
   u8g2_font_info_t font_info;			/* new font info structure */
+#ifdef U8G2_WITH_GLYPH_CACHE
+  u8g2_glyph_cache_t glyph_cache;
+#endif /* U8G2_WITH_GLYPH_CACHE */
+#ifdef U8G2_WITH_GLYPH_INDEX
+  u8g2_glyph_index_t glyph_index;
+#endif /* U8G2_WITH_GLYPH_INDEX */
+#ifdef U8G2_WITH_KERNING_INDEX
+  u8g2_kerning_index_t kerning_index;
+#endif /* U8G2_WITH_KERNING_INDEX */
+#ifdef U8G2_WITH_STR_WIDTH_CACHE
+  u8g2_str_width_cache_t str_width_cache;
+#endif /* U8G2_WITH_STR_WIDTH_CACHE */
 
   uint8_t font_height_mode;
   int8_t font_ref_ascent;
@@ -338,6 +564,21 @@ struct u8g2_struct
 					
   uint8_t is_auto_page_clear; 		/* set to 0 to disable automatic page clear in firstPage() and nextPage() */
   
+  /* incremental rendering, see u8g2_RenderStep() */
+  u8g2_render_cb render_cb;		/* NULL if no frame is pending */
+  uint8_t render_tile_row;		/* full buffer: next tile row to transfer, 255: buffer not yet drawn */
+#ifdef U8G2_WITH_DISPLAY_LIST
+  u8g2_display_list_t display_list;
+#endif /* U8G2_WITH_DISPLAY_LIST */
+  
+#ifdef U8G2_WITH_FRONT_BUFFER
+  /* double buffer, see u8g2_SetFrontBuffer() */
+  uint8_t *front_buf_ptr;		/* NULL if not used */
+  uint32_t front_dirty;			/* one bit per tile row which differs from the display */
+  uint8_t front_tile_row;		/* next tile row to transfer, tile_height: transfer complete */
+  uint8_t is_swap_pending;		/* the tile buffer contains a complete frame which is not yet in the front buffer */
+#endif /* U8G2_WITH_FRONT_BUFFER */
+  
 #ifdef U8G2_WITH_HVLINE_COUNT
   unsigned long hv_cnt;
 #endif /* U8G2_WITH_HVLINE_COUNT */   
@@ -365,6 +606,9 @@ struct u8g2_struct
   u8x8_Setup(u8g2_GetU8x8(u8g2), (display_cb), (cad_cb), (byte_cb), (gpio_and_delay_cb))
 
 #define u8g2_InitDisplay(u8g2) u8x8_InitDisplay(u8g2_GetU8x8(u8g2))
+#define u8g2_InitDisplayStart(u8g2) u8x8_InitDisplayStart(u8g2_GetU8x8(u8g2))
+#define u8g2_InitDisplayStep(u8g2) u8x8_InitDisplayStep(u8g2_GetU8x8(u8g2))
+#define u8g2_IsInitDisplayPending(u8g2) u8x8_IsInitDisplayPending(u8g2_GetU8x8(u8g2))
 #define u8g2_SetPowerSave(u8g2, is_enable) u8x8_SetPowerSave(u8g2_GetU8x8(u8g2), (is_enable))
 #define u8g2_SetFlipMode(u8g2, mode) u8x8_SetFlipMode(u8g2_GetU8x8(u8g2), (mode))
 #define u8g2_SetContrast(u8g2, value) u8x8_SetContrast(u8g2_GetU8x8(u8g2), (value))
@@ -401,6 +645,13 @@ extern const u8g2_cb_t u8g2_cb_mirror;
 #define U8G2_R2	(&u8g2_cb_r2)
 #define U8G2_R3	(&u8g2_cb_r3)
 #define U8G2_MIRROR	(&u8g2_cb_mirror)
+
+/* draw_l90 procedures of the rotations above, called directly by U8G2T in U8g2lib.h */
+void u8g2_draw_l90_r1(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
+void u8g2_draw_l90_r2(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
+void u8g2_draw_l90_r3(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
+void u8g2_draw_l90_mirrorr_r0(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
+
 /*
   u8g2:			A new, not yet initialized u8g2 memory areay
   buf:			Memory are of size tile_buf_height*<width of the display in pixel>
@@ -824,6 +1075,10 @@ void u8g2_Setup_a2printer_384x240_f(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x
 
 /* u8g2_d_setup.c generated code end */
 
+/* u8g2_d_setup.c, not generated: ST7920 with dirty row tracking, see u8x8_d_st7920_128x64_dirty(), */
+/* the shadow buffer is set with u8x8_SetDisplayShadow(u8g2_GetU8x8(u8g2), buf) */
+void u8g2_Setup_st7920_s_128x64_dirty_f(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+
 /*==========================================*/
 /* u8g2_buffer.c */
 
@@ -834,6 +1089,54 @@ void u8g2_SetPageCurrTileRow(u8g2_t *u8g2, uint8_t row) U8G2_NOINLINE;
 void u8g2_FirstPage(u8g2_t *u8g2);
 uint8_t u8g2_NextPage(u8g2_t *u8g2);
 
+/*
+  Resumable replacement for the picture loop. u8g2_RenderStart() prepares a new
+  frame, each call to u8g2_RenderStep() does a small part of the work and returns:
+    page buffer: draw one page with render_cb and transfer it to the display,
+      with u8g2_SetDisplayList() render_cb is called only for the first page
+    full buffer: first call draws the complete frame, each following call 
+      transfers one tile row
+  u8g2_RenderStep() returns 0 if the frame is complete.
+*/
+void u8g2_RenderStart(u8g2_t *u8g2, u8g2_render_cb render_cb);
+uint8_t u8g2_RenderStep(u8g2_t *u8g2);
+#define u8g2_IsRendering(u8g2) ((u8g2)->render_cb != NULL)
+
+#ifdef U8G2_WITH_FRONT_BUFFER
+/*
+  Double buffer for the full buffer mode. buf must have the size of the tile 
+  buffer, it becomes the front buffer with the last complete frame, the tile 
+  buffer is the back buffer for drawing. u8g2_SwapBuffer() marks the back buffer 
+  as complete: It is copied into the front buffer as soon as the previous frame 
+  has been transferred. Drawing must wait while u8g2_IsSwapPending() is true.
+  Each call to u8g2_TransferStep() sends one tile row of the front buffer which 
+  has been changed by the swap, it returns 0 if nothing is left to send. 
+  After the swap, the back buffer still contains the frame, so only the 
+  changed parts need to be redrawn.
+  Tile rows from 32 on (displays with more than 256 lines) are always sent.
+*/
+void u8g2_SetFrontBuffer(u8g2_t *u8g2, uint8_t *buf);
+void u8g2_SwapBuffer(u8g2_t *u8g2);
+uint8_t u8g2_TransferStep(u8g2_t *u8g2);
+#define u8g2_IsSwapPending(u8g2) ((u8g2)->is_swap_pending)
+#endif /* U8G2_WITH_FRONT_BUFFER */
+
+/*==========================================*/
+/* u8g2_tile_text.c */
+
+/*
+  Glyphs of the u8x8 font (u8g2_SetTileFont()) at tile position tx/ty (8x8 
+  pixel per tile), written into the buffer and sent to the display at once,
+  without font decoding and without u8g2_SendBuffer(). u8g2_Draw2x2TileString()
+  draws each glyph with 2x2 tiles. The tile rows must be inside the buffer 
+  (full buffer), the display must use U8G2_R0. Supported are the ST7920 
+  (horizontal buffer) and displays with the vertical_top_lsb buffer.
+  Returns the number of drawn glyphs, 0 if the mode is not supported.
+*/
+#define u8g2_SetTileFont(u8g2, font_8x8) u8x8_SetFont(u8g2_GetU8x8(u8g2), (font_8x8))
+uint8_t u8g2_DrawTileString(u8g2_t *u8g2, uint8_t tx, uint8_t ty, const char *s);
+uint8_t u8g2_Draw2x2TileString(u8g2_t *u8g2, uint8_t tx, uint8_t ty, const char *s);
+
 #define u8g2_GetBufferPtr(u8g2) ((u8g2)->tile_buf_ptr)
 #define u8g2_GetBufferTileHeight(u8g2)	((u8g2)->tile_buf_height)
 #define u8g2_GetBufferTileWidth(u8g2)	(u8g2_GetU8x8(u8g2)->display_info->tile_width)
@@ -856,10 +1159,22 @@ void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
 /* ST7920 */
 void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
 
+/*
+  u8g2_ll_span_vertical_top_lsb: apply the draw color to the bits of mask 
+  in len bytes of the tile row which contains y, starting at x.
+  This draws a box of up to 8 lines. len must not be 0, all clipping done.
+*/
+void u8g2_ll_span_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t mask);
+
 
 /*==========================================*/
 /* u8g2_hvline.c */
 
+#ifdef U8G2_WITH_CLIPPING
+/* clip range from a (included) to b (excluded) against 0 (included) to d (excluded) */
+uint8_t u8g2_clip_intersection(u8g2_uint_t *ap, u8g2_uint_t *bp, u8g2_uint_t d);
+#endif
+
 /* u8g2_DrawHVLine does not use u8g2_IsIntersection */
 void u8g2_DrawHVLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
 
@@ -867,6 +1182,8 @@ void u8g2_DrawHVLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len
 void u8g2_DrawHLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len);
 void u8g2_DrawVLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len);
 void u8g2_DrawPixel(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y);
+/* len pixels starting at x/y, clipped like u8g2_DrawPixel() */
+void u8g2_draw_pixel_span(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
 void u8g2_SetDrawColor(u8g2_t *u8g2, uint8_t color) U8G2_NOINLINE;  /* u8g: u8g_SetColorIndex(u8g_t *u8g, uint8_t idx); */
 
 
@@ -875,8 +1192,45 @@ void u8g2_SetDrawColor(u8g2_t *u8g2, uint8_t color) U8G2_NOINLINE;  /* u8g: u8g_
 void u8g2_SetBitmapMode(u8g2_t *u8g2, uint8_t is_transparent);
 void u8g2_DrawHorizontalBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, const uint8_t *b);
 void u8g2_DrawBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t cnt, u8g2_uint_t h, const uint8_t *bitmap);
+void u8g2_DrawHXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, const uint8_t *b);
 void u8g2_DrawXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap);
 void u8g2_DrawXBMP(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap);	/* assumes bitmap in PROGMEM */
+/* 
+  XBM with w x h pixel, each pixel drawn as scale x scale block (scale 1..4), 
+  the rows are scaled with the lookup tables of u8x8_upscale_byte_n() 
+*/
+void u8g2_DrawScaledXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, uint8_t scale, const uint8_t *bitmap);
+void u8g2_DrawScaledXBMP(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, uint8_t scale, const uint8_t *bitmap);	/* assumes bitmap in PROGMEM */
+
+/*==========================================*/
+/* u8g2_blit.c */
+#ifdef U8G2_WITH_BITMAP_BLIT
+#define U8G2_BLIT_LSB_FIRST 1	/* XBM: bit 0 is the left pixel, otherwise bit 7 (u8g2_DrawBitmap()) */
+#define U8G2_BLIT_PROGMEM 2	/* bitmap in PROGMEM */
+/* 
+  Bitmap with w x h pixel and (w+7)/8 bytes per row, draw color and bitmap 
+  mode as u8g2_DrawXBM(). Returns 0 if the rotation or the buffer layout is 
+  not supported, nothing is drawn then.
+*/
+uint8_t u8g2_BlitBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap, uint8_t flags);
+#endif /* U8G2_WITH_BITMAP_BLIT */
+
+
+/*==========================================*/
+/* u8g2_atlas.c */
+
+/*
+  Run length compressed images in one array, created with 
+  extras/host/atlas_pack.c. u8g2_DrawAtlasImage() draws image idx with the
+  upper left corner at x/y, draw color and bitmap mode as u8g2_DrawXBM().
+  Only the bands of U8G2_ATLAS_BAND_HEIGHT rows which intersect the current
+  page are decoded.
+*/
+#define U8G2_ATLAS_BAND_HEIGHT 8
+uint8_t u8g2_GetAtlasCount(const uint8_t *atlas);
+u8g2_uint_t u8g2_GetAtlasWidth(const uint8_t *atlas, uint8_t idx);
+u8g2_uint_t u8g2_GetAtlasHeight(const uint8_t *atlas, uint8_t idx);
+void u8g2_DrawAtlasImage(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const uint8_t *atlas, uint8_t idx);
 
 
 /*==========================================*/
@@ -885,6 +1239,25 @@ void u8g2_DrawXBMP(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8
 uint8_t u8g2_IsIntersection(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t x1, u8g2_uint_t y1);
 #endif /* U8G2_WITH_INTERSECTION */
 
+/*
+  All draw procedures between u8g2_BeginGroup() and u8g2_EndGroup() must 
+  be inside of the box x, y, w, h. u8g2_BeginGroup() returns 0 if the box 
+  is outside of the current page. The caller then skips the complete group 
+  with one check:
+    if ( u8g2_BeginGroup(u8g2, x, y, w, h) )
+    {
+      ... draw procedures ...
+      u8g2_EndGroup(u8g2);
+    }
+  Changes of color, font or mode inside of the group must be reverted 
+  before u8g2_EndGroup(), because they are skipped together with the group.
+  In a display list the items of the group are only added to the buckets
+  of the pages of the box.
+  Groups can be nested.
+*/
+uint8_t u8g2_BeginGroup(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+void u8g2_EndGroup(u8g2_t *u8g2);
+
 
 
 /*==========================================*/
@@ -914,6 +1287,20 @@ void u8g2_DrawRFrame(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w,
 
 /*==========================================*/
 /* u8g2_polygon.c */
+
+/*
+  Stored polygons: The points are added once, the edge table is calculated
+  with the first draw and reused for all pages and frames until the points 
+  change. Each draw only visits the scan lines of the current page and 
+  continues with the scan line position of the previous page. Several
+  polygons (needles, icons) can be kept at the same time.
+  The polygon must be convex.
+*/
+void u8g2_ClearPolygon(u8g2_polygon_t *pg);
+void u8g2_AddPolygonPoint(u8g2_polygon_t *pg, int16_t x, int16_t y);
+void u8g2_DrawStoredPolygon(u8g2_t *u8g2, u8g2_polygon_t *pg);
+
+/* single polygon, drawn with the stored polygon procedures */
 void u8g2_ClearPolygonXY(void);
 void u8g2_AddPolygonXY(u8g2_t *u8g2, int16_t x, int16_t y);
 void u8g2_DrawPolygon(u8g2_t *u8g2);
@@ -927,6 +1314,20 @@ void u8g2_DrawTriangle(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1, int16_t
 uint8_t u8g2_GetKerning(u8g2_t *u8g2, u8g2_kerning_t *kerning, uint16_t e1, uint16_t e2);
 uint8_t u8g2_GetKerningByTable(u8g2_t *u8g2, const uint16_t *kt, uint16_t e1, uint16_t e2);
 
+#ifdef U8G2_WITH_KERNING_INDEX
+/*
+  Use buf (cnt words, three words for each kerning pair) for a sorted copy 
+  of a kerning pair list. The copy is made by the first 
+  u8g2_GetKerningByTable() with a pair list which is not yet indexed, 
+  usually once after the font is changed. Lists with more pairs than buf 
+  can hold are searched linearly. Call u8g2_SetKerningIndex() again if a
+  pair list in RAM is modified. buf = NULL disables the index.
+  The u8g2_kerning_t tables of u8g2_GetKerning() are not indexed: the two
+  level search is already faster than the binary search.
+*/
+void u8g2_SetKerningIndex(u8g2_t *u8g2, uint16_t *buf, uint16_t cnt);
+#endif /* U8G2_WITH_KERNING_INDEX */
+
 
 /*==========================================*/
 /* u8g2_font.c */
@@ -940,6 +1341,32 @@ size_t u8g2_GetFontSize(const uint8_t *font_arg);
 void u8g2_SetFont(u8g2_t *u8g2, const uint8_t  *font);
 void u8g2_SetFontMode(u8g2_t *u8g2, uint8_t is_transparent);
 
+#ifdef U8G2_WITH_GLYPH_CACHE
+/*
+  Keep decoded glyphs as bitmaps in buf (size bytes), the least recently
+  used glyph is removed if the cache is full. Entries are keyed by font
+  and encoding, so the cache is not affected by u8g2_SetFont().
+  buf = NULL disables the cache. The cache should hold all glyphs of a
+  screen (about 32 bytes for a 8x13 glyph on a 32 bit controller),
+  otherwise glyphs are removed before they are used on the next page.
+*/
+void u8g2_SetGlyphCache(u8g2_t *u8g2, void *buf, uint16_t size);
+#endif /* U8G2_WITH_GLYPH_CACHE */
+
+#ifdef U8G2_WITH_GLYPH_INDEX
+/*
+  Use buf (cnt words) for the glyph position table of the current font.
+  The first 256 words are used for the glyphs 0..255, each pair of the
+  remaining words holds the encoding and position of every n-th unicode 
+  glyph. n is selected so that all unicode glyphs are covered, larger 
+  buffers reduce the linear search after the binary search.
+  The table is rebuilt by u8g2_SetFont() if the font changes. Fonts 
+  larger than 64 KB are not indexed. buf = NULL disables the index.
+*/
+#define U8G2_GLYPH_INDEX_8BIT_CNT 256
+void u8g2_SetGlyphIndex(u8g2_t *u8g2, uint16_t *buf, uint16_t cnt);
+#endif /* U8G2_WITH_GLYPH_INDEX */
+
 uint8_t u8g2_IsGlyph(u8g2_t *u8g2, uint16_t requested_encoding);
 int8_t u8g2_GetGlyphWidth(u8g2_t *u8g2, uint16_t requested_encoding);
 u8g2_uint_t u8g2_DrawGlyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding);
@@ -961,6 +1388,20 @@ u8g2_uint_t u8g2_DrawExtUTF8(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint8_t
 u8g2_uint_t u8g2_GetStrWidth(u8g2_t *u8g2, const char *s);
 u8g2_uint_t u8g2_GetUTF8Width(u8g2_t *u8g2, const char *str);
 
+#ifdef U8G2_WITH_STR_WIDTH_CACHE
+/*
+  Keep the width of up to cnt strings in buf. Entries are keyed by the 
+  string pointer and a hash of the characters, so modified strings in RAM 
+  are measured again. If the cache is full, the oldest entry is replaced.
+  The cache is cleared by u8g2_SetFont() if the font changes: Use one 
+  font for the measured labels of a frame. buf = NULL disables the cache.
+*/
+#define U8G2_STR_WIDTH_ASCII 0
+#define U8G2_STR_WIDTH_UTF8 1
+#define U8G2_STR_WIDTH_EXACT 2
+void u8g2_SetStrWidthCache(u8g2_t *u8g2, u8g2_str_width_entry_t *buf, uint8_t cnt);
+#endif /* U8G2_WITH_STR_WIDTH_CACHE */
+
 void u8g2_SetFontPosBaseline(u8g2_t *u8g2);
 void u8g2_SetFontPosBottom(u8g2_t *u8g2);
 void u8g2_SetFontPosTop(u8g2_t *u8g2);
@@ -971,17 +1412,125 @@ void u8g2_SetFontRefHeightExtendedText(u8g2_t *u8g2);
 void u8g2_SetFontRefHeightAll(u8g2_t *u8g2);
 
 
+/*==========================================*/
+/* u8g2_display_list.c */
+#ifdef U8G2_WITH_DISPLAY_LIST
+/*
+  Use buf (size bytes) for the display list. Between u8g2_BeginDisplayList()
+  and u8g2_EndDisplayList() the procedures DrawBox, DrawFrame, DrawLine, 
+  DrawHLine, DrawVLine, DrawXBM, DrawXBMP and all glyph and string procedures
+  are stored in buf together with the pages on which they are visible 
+  instead of being drawn. u8g2_EndDisplayList() sorts the items into one 
+  bucket per page, u8g2_DrawDisplayList() draws the bucket of the current 
+  page. If buf is too small or another draw procedure is called, the
+  recording stops: the items so far and all following draw procedures are 
+  drawn into the current page, u8g2_EndDisplayList() returns 0 and the 
+  other pages must be drawn directly.
+  On a 32 bit controller in 8 bit mode, a box, line or glyph requires 10 
+  bytes, a bitmap 14 bytes, a group (see u8g2_BeginGroup()) 6 bytes and 
+  each change of font, color or mode 18 bytes. The buckets require 2 bytes
+  for each page of each item and 2 bytes for each page plus 2 bytes.
+  buf = NULL disables the display list.
+*/
+void u8g2_SetDisplayList(u8g2_t *u8g2, void *buf, uint16_t size);
+void u8g2_BeginDisplayList(u8g2_t *u8g2);
+uint8_t u8g2_EndDisplayList(u8g2_t *u8g2);
+void u8g2_DrawDisplayList(u8g2_t *u8g2);
+#define u8g2_IsRecording(u8g2) ((u8g2)->display_list.is_recording)
+#define u8g2_GetDisplayListUsed(u8g2) ((u8g2)->display_list.used)
+
+/* item types, used by the draw procedures while recording */
+#define U8G2_DL_STATE 0
+#define U8G2_DL_BOX 1
+#define U8G2_DL_FRAME 2
+#define U8G2_DL_LINE 3
+#define U8G2_DL_HLINE 4
+#define U8G2_DL_VLINE 5
+#define U8G2_DL_XBM 6
+#define U8G2_DL_XBMP 7
+#define U8G2_DL_GLYPH 8
+#define U8G2_DL_GROUP 9
+/* the add procedures return 0 if the recording has stopped, the item must be drawn directly */
+uint8_t u8g2_display_list_add(u8g2_t *u8g2, uint8_t type, u8g2_uint_t a, u8g2_uint_t b, u8g2_uint_t c, u8g2_uint_t d);
+uint8_t u8g2_display_list_add_bitmap(u8g2_t *u8g2, uint8_t type, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap);
+uint8_t u8g2_display_list_add_glyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding);
+uint8_t u8g2_display_list_begin_group(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+void u8g2_display_list_end_group(u8g2_t *u8g2);
+/* draw procedures without item: stop the recording and draw directly */
+void u8g2_display_list_abort(u8g2_t *u8g2);
+#endif /* U8G2_WITH_DISPLAY_LIST */
+
+
 
 /*==========================================*/
 /* u8g2_selection_list.c */
 void u8g2_DrawUTF8Line(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, const char *s, uint8_t border_size, uint8_t is_invert);
 u8g2_uint_t u8g2_DrawUTF8Lines(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t line_height, const char *s);
+void u8g2_DrawSelectionList(u8g2_t *u8g2, u8sl_t *u8sl, u8g2_uint_t y, const char *s);
 uint8_t u8g2_UserInterfaceSelectionList(u8g2_t *u8g2, const char *title, uint8_t start_pos, const char *sl);
 
+/* 
+  Non-blocking selection list, driven by the application:
+    u8g2_UserInterfaceSelectionListStart(): same arguments as u8g2_UserInterfaceSelectionList()
+    u8g2_UserInterfaceSelectionListEvent(): pass one U8X8_MSG_GPIO_MENU_xxx event (0 is ignored), 
+      returns 1 if the event moved the cursor or closed the list
+    u8g2_DrawUserInterfaceSelectionList(): draw the complete list (picture loop or full buffer)
+    u8g2_UpdateUserInterfaceSelectionList(): full buffer only, the buffer must contain the 
+      output of the previous draw or update: redraw only the lines which have changed, 
+      returns 0 if nothing was drawn
+  u8g2_IsUserInterfaceDone() becomes 1 with the select or home event, u8g2_GetUserInterfaceResult()
+  then is the return value of u8g2_UserInterfaceSelectionList(). The font must not be changed 
+  while the list is open.
+*/
+struct _u8g2_ui_selection_list_t
+{
+  const char *title;
+  const char *sl;
+  u8sl_t u8sl;
+  u8g2_uint_t list_y;			/* baseline of the first visible line */
+  uint8_t title_lines;
+  uint8_t drawn_pos;			/* u8sl.current_pos of the last draw, 255: not yet drawn */
+  uint8_t drawn_first;			/* u8sl.first_pos of the last draw */
+  uint8_t is_done;
+  uint8_t result;
+};
+typedef struct _u8g2_ui_selection_list_t u8g2_ui_selection_list_t;
+
+#define u8g2_IsUserInterfaceDone(ui) ((ui)->is_done)
+#define u8g2_GetUserInterfaceResult(ui) ((ui)->result)
+
+void u8g2_UserInterfaceSelectionListStart(u8g2_t *u8g2, u8g2_ui_selection_list_t *ui, const char *title, uint8_t start_pos, const char *sl);
+uint8_t u8g2_UserInterfaceSelectionListEvent(u8g2_t *u8g2, u8g2_ui_selection_list_t *ui, uint8_t event);
+void u8g2_DrawUserInterfaceSelectionList(u8g2_t *u8g2, u8g2_ui_selection_list_t *ui);
+uint8_t u8g2_UpdateUserInterfaceSelectionList(u8g2_t *u8g2, u8g2_ui_selection_list_t *ui);
+
 /*==========================================*/
 /* u8g2_message.c */
 uint8_t u8g2_UserInterfaceMessage(u8g2_t *u8g2, const char *title1, const char *title2, const char *title3, const char *buttons);
 
+/* non-blocking message box, same procedures as for the selection list above */
+struct _u8g2_ui_message_t
+{
+  const char *title1;
+  const char *title2;
+  const char *title3;
+  const char *buttons;
+  u8g2_uint_t y;			/* baseline of the first line */
+  u8g2_uint_t button_y;			/* baseline of the button line */
+  uint8_t line_height;
+  uint8_t button_cnt;
+  uint8_t cursor;
+  uint8_t drawn_cursor;			/* cursor of the last draw, 255: not yet drawn */
+  uint8_t is_done;
+  uint8_t result;
+};
+typedef struct _u8g2_ui_message_t u8g2_ui_message_t;
+
+void u8g2_UserInterfaceMessageStart(u8g2_t *u8g2, u8g2_ui_message_t *ui, const char *title1, const char *title2, const char *title3, const char *buttons);
+uint8_t u8g2_UserInterfaceMessageEvent(u8g2_t *u8g2, u8g2_ui_message_t *ui, uint8_t event);
+void u8g2_DrawUserInterfaceMessage(u8g2_t *u8g2, u8g2_ui_message_t *ui);
+uint8_t u8g2_UpdateUserInterfaceMessage(u8g2_t *u8g2, u8g2_ui_message_t *ui);
+
 /*==========================================*/
 /* u8g2_input_value.c */
 uint8_t u8g2_UserInterfaceInputValue(u8g2_t *u8g2, const char *title, const char *pre, uint8_t *value, uint8_t lo, uint8_t hi, uint8_t digits, const char *post);
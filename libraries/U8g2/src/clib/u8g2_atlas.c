@@ -0,0 +1,291 @@
+/*
+
+  u8g2_atlas.c
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2026, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+  Image atlas: many small monochrome images (icons) in one array, each
+  image compressed with run length codes like the glyphs of u8g2 fonts.
+  The packer is extras/host/atlas_pack.c.
+
+  Atlas format, 16 bit values are big endian like the font header:
+    0		number of images n
+    1		m0: bits per run length of 0 pixel
+    2		m1: bits per run length of 1 pixel
+    3		n entries with 4 bytes: width, height, offset of the image data
+		(from the start of the atlas)
+    ...		image data, at the end one unused byte (the bit reader may 
+		read one byte ahead)
+    
+  Image data: the rows are grouped into bands of 8 rows 
+  (U8G2_ATLAS_BAND_HEIGHT), the last band may have less rows. The data 
+  starts with the offsets of bands 1, 2, ... (16 bit, from the start of 
+  the image data), followed by the bands. Each band starts at a byte.
+  
+  Band: the first bit selects the encoding of the pixel of the rows (left 
+  to right, top to bottom).
+    0	pairs of run lengths: a (m0 bits) pixel with 0, then b (m1 bits) 
+	pixel with 1. After each pair follows one bit: 1 repeats the pair, 
+	0 reads the next pair.
+    1	one bit per pixel, for bands which are smaller without compression
+  Bits are read lsb first, like u8g2_font_decode_get_unsigned_bits().
+  
+  Only bands which intersect the current page are decoded. The rows of a
+  band are decoded into a small XBM block which is drawn with 
+  u8g2_BlitBitmap(), or with u8g2_DrawHXBM() if the blit is not available.
+  Draw color and bitmap mode are used as in u8g2_DrawXBM().
+
+*/
+
+#include "u8g2.h"
+#include <string.h>
+
+/* XBM rows per u8g2_BlitBitmap(): a complete band for images up to 64 pixel width */
+#define U8G2_ATLAS_BLOCK 64
+
+typedef struct _u8g2_atlas_decode_struct u8g2_atlas_decode_t;
+struct _u8g2_atlas_decode_struct
+{
+  const uint8_t *decode_ptr;
+  uint8_t decode_bit_pos;
+  uint8_t m0, m1;
+  uint8_t is_raw;		/* one bit per pixel */
+  uint8_t pair_a, pair_b;	/* current pair */
+  uint8_t a, b;			/* pixel left of the current pair */
+};
+
+static const uint8_t *u8g2_atlas_get_entry(const uint8_t *atlas, uint8_t idx)
+{
+  if ( idx >= u8x8_pgm_read(atlas) )
+    return NULL;
+  return atlas + 3 + idx*4;
+}
+
+uint8_t u8g2_GetAtlasCount(const uint8_t *atlas)
+{
+  return u8x8_pgm_read(atlas);
+}
+
+u8g2_uint_t u8g2_GetAtlasWidth(const uint8_t *atlas, uint8_t idx)
+{
+  const uint8_t *entry = u8g2_atlas_get_entry(atlas, idx);
+  if ( entry == NULL )
+    return 0;
+  return u8x8_pgm_read(entry);
+}
+
+u8g2_uint_t u8g2_GetAtlasHeight(const uint8_t *atlas, uint8_t idx)
+{
+  const uint8_t *entry = u8g2_atlas_get_entry(atlas, idx);
+  if ( entry == NULL )
+    return 0;
+  return u8x8_pgm_read(entry+1);
+}
+
+static uint16_t u8g2_atlas_get_word(const uint8_t *ptr)
+{
+  uint16_t v;
+  v = u8x8_pgm_read(ptr);
+  v <<= 8;
+  v |= u8x8_pgm_read(ptr+1);
+  return v;
+}
+
+/* same as u8g2_font_decode_get_unsigned_bits(), cnt is 1..8 */
+static uint8_t u8g2_atlas_get_unsigned_bits(u8g2_atlas_decode_t *d, uint8_t cnt)
+{
+  uint8_t val;
+  uint8_t bit_pos = d->decode_bit_pos;
+  uint8_t bit_pos_plus_cnt;
+  
+  val = u8x8_pgm_read( d->decode_ptr );  
+  val >>= bit_pos;
+  bit_pos_plus_cnt = bit_pos;
+  bit_pos_plus_cnt += cnt;
+  if ( bit_pos_plus_cnt >= 8 )
+  {
+    uint8_t s = 8;
+    s -= bit_pos;
+    d->decode_ptr++;
+    val |= u8x8_pgm_read( d->decode_ptr ) << (s);
+    bit_pos_plus_cnt -= 8;
+  }
+  val &= (1U<<cnt)-1;
+  d->decode_bit_pos = bit_pos_plus_cnt;
+  return val;
+}
+
+static void u8g2_atlas_read_pair(u8g2_atlas_decode_t *d)
+{
+  d->pair_a = u8g2_atlas_get_unsigned_bits(d, d->m0);
+  d->pair_b = u8g2_atlas_get_unsigned_bits(d, d->m1);
+  d->a = d->pair_a;
+  d->b = d->pair_b;
+}
+
+/* decode w pixel into an XBM row, the row must be cleared */
+static void u8g2_atlas_decode_row(u8g2_atlas_decode_t *d, uint8_t *row, u8g2_uint_t w)
+{
+  uint16_t x = 0;		/* up to w+7 in the raw loop */
+  u8g2_uint_t cnt;
+  uint8_t n, bit_pos;
+  
+  if ( d->is_raw )
+  {
+    for( x = 0; x < w; x += 8 )
+    {
+      n = 8;
+      if ( n > w - x )
+	n = w - x;
+      row[x >> 3] = u8g2_atlas_get_unsigned_bits(d, n);
+    }
+    return;
+  }
+  
+  while( x < w )
+  {
+    if ( d->a == 0 && d->b == 0 )
+    {
+      if ( u8g2_atlas_get_unsigned_bits(d, 1) != 0 )
+      {
+	d->a = d->pair_a;
+	d->b = d->pair_b;
+      }
+      else
+      {
+	u8g2_atlas_read_pair(d);
+      }
+    }
+    
+    /* 0 pixel */
+    cnt = w - x;
+    if ( cnt > d->a )
+      cnt = d->a;
+    x += cnt;
+    d->a -= cnt;
+    
+    /* 1 pixel, all pixel within a byte at once */
+    cnt = w - x;
+    if ( cnt > d->b )
+      cnt = d->b;
+    d->b -= cnt;
+    while( cnt > 0 )
+    {
+      bit_pos = x & 7;
+      n = 8 - bit_pos;
+      if ( n > cnt )
+	n = cnt;
+      row[x >> 3] |= (uint8_t)(((1U << n) - 1) << bit_pos);
+      x += n;
+      cnt -= n;
+    }
+  }
+}
+
+void u8g2_DrawAtlasImage(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, const uint8_t *atlas, uint8_t idx)
+{
+  uint8_t block[U8G2_ATLAS_BLOCK];
+  u8g2_atlas_decode_t d;
+  const uint8_t *entry;
+  const uint8_t *image;
+  u8g2_uint_t w, h, band_h, r, cnt;
+  uint16_t stride, rows;	/* w+7 exceeds u8g2_uint_t in 8 bit mode */
+  uint8_t band, i;
+  
+  entry = u8g2_atlas_get_entry(atlas, idx);
+  if ( entry == NULL )
+    return;
+  w = u8x8_pgm_read(entry);
+  h = u8x8_pgm_read(entry+1);
+  image = atlas + u8g2_atlas_get_word(entry+2);
+  
+#ifdef U8G2_WITH_DISPLAY_LIST
+  /* no display list item: stop the recording and draw directly */
+  if ( u8g2_IsRecording(u8g2) )
+    u8g2_display_list_abort(u8g2);
+#endif /* U8G2_WITH_DISPLAY_LIST */
+#ifdef U8G2_WITH_INTERSECTION
+  if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
+    return;
+#endif /* U8G2_WITH_INTERSECTION */
+  
+  stride = w;
+  stride += 7;
+  stride >>= 3;
+  rows = sizeof(block) / stride;
+  memset(&d, 0, sizeof(d));
+  d.m0 = u8x8_pgm_read(atlas+1);
+  d.m1 = u8x8_pgm_read(atlas+2);
+  
+  for( band = 0; h > 0; band++ )
+  {
+    band_h = h;
+    if ( band_h > U8G2_ATLAS_BAND_HEIGHT )
+      band_h = U8G2_ATLAS_BAND_HEIGHT;
+#ifdef U8G2_WITH_INTERSECTION
+    /* bands outside of the current page are not decoded */
+    if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+band_h) != 0 ) 
+#endif /* U8G2_WITH_INTERSECTION */
+    {
+      d.decode_ptr = image;
+      if ( band > 0 )
+	d.decode_ptr += u8g2_atlas_get_word(image + (band-1)*2);
+      else if ( h > U8G2_ATLAS_BAND_HEIGHT )
+	d.decode_ptr += ((h + U8G2_ATLAS_BAND_HEIGHT - 1) / U8G2_ATLAS_BAND_HEIGHT - 1) * 2;
+      d.decode_bit_pos = 0;
+      d.is_raw = u8g2_atlas_get_unsigned_bits(&d, 1);
+      if ( d.is_raw == 0 )
+	u8g2_atlas_read_pair(&d);
+      
+      for( r = 0; r < band_h; r += cnt )
+      {
+#ifdef U8G2_WITH_INTERSECTION
+	/* the rest of the band is below the current page */
+	if ( u8g2_IsIntersection(u8g2, x, y + r, x+w, y+band_h) == 0 ) 
+	  break;
+#endif /* U8G2_WITH_INTERSECTION */
+	cnt = band_h - r;
+	if ( cnt > rows )
+	  cnt = rows;
+	memset(block, 0, cnt*stride);
+	for( i = 0; i < cnt; i++ )
+	  u8g2_atlas_decode_row(&d, block + i*stride, w);
+#ifdef U8G2_WITH_BITMAP_BLIT
+	if ( u8g2_BlitBitmap(u8g2, x, y + r, w, cnt, block, U8G2_BLIT_LSB_FIRST) )
+	  continue;
+#endif /* U8G2_WITH_BITMAP_BLIT */
+	for( i = 0; i < cnt; i++ )
+	  u8g2_DrawHXBM(u8g2, x, y + r + i, w, block + i*stride);
+      }
+    }
+    y += band_h;
+    h -= band_h;
+  }
+}
@@ -34,6 +34,7 @@
 */
 
 #include "u8g2.h"
+#include <string.h>
 
 
 void u8g2_SetBitmapMode(u8g2_t *u8g2, uint8_t is_transparent) {
@@ -57,6 +58,10 @@ void u8g2_DrawHorizontalBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_
   if ( u8g2_IsIntersection(u8g2, x, y, x+len, y+1) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+#ifdef U8G2_WITH_BITMAP_BLIT
+  if ( u8g2_BlitBitmap(u8g2, x, y, len, 1, b, 0) )
+    return;
+#endif /* U8G2_WITH_BITMAP_BLIT */
   
   mask = 128;
   while(len > 0)
@@ -78,6 +83,7 @@ void u8g2_DrawHorizontalBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_
     }
     len--;
   }
+  u8g2->draw_color = color;
 }
 
 
@@ -91,6 +97,10 @@ void u8g2_DrawBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t cnt
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+#ifdef U8G2_WITH_BITMAP_BLIT
+  if ( u8g2_BlitBitmap(u8g2, x, y, w, h, bitmap, 0) )
+    return;
+#endif /* U8G2_WITH_BITMAP_BLIT */
   
   while( h > 0 )
   {
@@ -112,6 +122,10 @@ void u8g2_DrawHXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len,
   if ( u8g2_IsIntersection(u8g2, x, y, x+len, y+1) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+#ifdef U8G2_WITH_BITMAP_BLIT
+  if ( u8g2_BlitBitmap(u8g2, x, y, len, 1, b, U8G2_BLIT_LSB_FIRST) )
+    return;
+#endif /* U8G2_WITH_BITMAP_BLIT */
   
   mask = 1;
   while(len > 0) {
@@ -137,14 +151,22 @@ void u8g2_DrawHXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len,
 
 void u8g2_DrawXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap)
 {
-  u8g2_uint_t blen;
+  uint16_t blen;
   blen = w;
   blen += 7;
   blen >>= 3;
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2_IsRecording(u8g2) && u8g2_display_list_add_bitmap(u8g2, U8G2_DL_XBM, x, y, w, h, bitmap) )
+    return;
+#endif /* U8G2_WITH_DISPLAY_LIST */
 #ifdef U8G2_WITH_INTERSECTION
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+#ifdef U8G2_WITH_BITMAP_BLIT
+  if ( u8g2_BlitBitmap(u8g2, x, y, w, h, bitmap, U8G2_BLIT_LSB_FIRST) )
+    return;
+#endif /* U8G2_WITH_BITMAP_BLIT */
   
   while( h > 0 )
   {
@@ -169,6 +191,10 @@ void u8g2_DrawHXBMP(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len,
   if ( u8g2_IsIntersection(u8g2, x, y, x+len, y+1) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+#ifdef U8G2_WITH_BITMAP_BLIT
+  if ( u8g2_BlitBitmap(u8g2, x, y, len, 1, b, U8G2_BLIT_LSB_FIRST|U8G2_BLIT_PROGMEM) )
+    return;
+#endif /* U8G2_WITH_BITMAP_BLIT */
   
   mask = 1;
   while(len > 0)
@@ -196,14 +222,22 @@ void u8g2_DrawHXBMP(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len,
 
 void u8g2_DrawXBMP(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap)
 {
-  u8g2_uint_t blen;
+  uint16_t blen;
   blen = w;
   blen += 7;
   blen >>= 3;
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2_IsRecording(u8g2) && u8g2_display_list_add_bitmap(u8g2, U8G2_DL_XBMP, x, y, w, h, bitmap) )
+    return;
+#endif /* U8G2_WITH_DISPLAY_LIST */
 #ifdef U8G2_WITH_INTERSECTION
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+#ifdef U8G2_WITH_BITMAP_BLIT
+  if ( u8g2_BlitBitmap(u8g2, x, y, w, h, bitmap, U8G2_BLIT_LSB_FIRST|U8G2_BLIT_PROGMEM) )
+    return;
+#endif /* U8G2_WITH_BITMAP_BLIT */
   
   while( h > 0 )
   {
@@ -215,3 +249,106 @@ void u8g2_DrawXBMP(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8
 }
 
 
+
+
+/* source bytes of a bitmap row per chunk, 4 bytes are 128 pixel with scale 4 */
+#define U8G2_SCALED_XBM_CHUNK 4
+/* scaled rows of a chunk, at least one source row with scale 4 */
+#define U8G2_SCALED_XBM_BLOCK (U8G2_SCALED_XBM_CHUNK*4*4)
+
+/*
+  The scaled rows of a chunk are collected in a block and drawn with one
+  u8g2_BlitBitmap(), or with u8g2_DrawHXBM() for each scaled row if the blit
+  is not available.
+*/
+static void u8g2_draw_scaled_xbm(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, uint8_t scale, const uint8_t *bitmap, uint8_t is_progmem)
+{
+  uint8_t block[U8G2_SCALED_XBM_BLOCK];
+  const uint8_t *src;
+  uint8_t *dest;
+  uint16_t blen;
+  u8g2_uint_t i, j, len, cnt;
+  uint32_t v;
+  uint8_t b, k, m, n, r, out, rows;
+  
+  if ( scale == 0 || scale > 4 )
+    return;
+  blen = w;
+  blen += 7;
+  blen >>= 3;
+#ifdef U8G2_WITH_DISPLAY_LIST
+  /* no display list item: stop the recording and draw directly */
+  if ( u8g2_IsRecording(u8g2) )
+    u8g2_display_list_abort(u8g2);
+#endif /* U8G2_WITH_DISPLAY_LIST */
+#ifdef U8G2_WITH_INTERSECTION
+  if ( u8g2_IsIntersection(u8g2, x, y, x+w*scale, y+h*scale) == 0 ) 
+    return;
+#endif /* U8G2_WITH_INTERSECTION */
+  
+  for( i = 0; i < blen; i += n )
+  {
+    n = U8G2_SCALED_XBM_CHUNK;
+    if ( n > blen - i )
+      n = blen - i;
+    len = w - i*8;
+    if ( len > n*8 )
+      len = n*8;
+    len *= scale;
+    out = (len + 7) >> 3;		/* bytes per scaled row */
+    rows = sizeof(block) / out / scale;	/* source rows per block */
+    
+    for( j = 0; j < h; j += cnt )
+    {
+      cnt = h - j;
+      if ( cnt > rows )
+	cnt = rows;
+#ifdef U8G2_WITH_INTERSECTION
+      /* skip the upscaling for rows outside of the current page */
+      if ( u8g2_IsIntersection(u8g2, x, y+j*scale, x+w*scale, y+(j+cnt)*scale) == 0 ) 
+	continue;
+#endif /* U8G2_WITH_INTERSECTION */
+      
+      /* scale the pixels of n bytes into n*scale bytes, repeat the row scale times */
+      src = bitmap + j*blen + i;
+      dest = block;
+      for( r = 0; r < cnt; r++ )
+      {
+	for( k = 0; k < out; k += scale )
+	{
+	  if ( is_progmem )
+	    b = u8x8_pgm_read(src + k/scale);
+	  else
+	    b = src[k/scale];
+	  v = u8x8_upscale_byte_n(b, scale);
+	  for( m = k; m < k + scale && m < out; m++ )
+	  {
+	    dest[m] = v;
+	    v >>= 8;
+	  }
+	}
+	for( k = 1; k < scale; k++ )
+	  memcpy(dest + k*out, dest, out);
+	dest += scale*out;
+	src += blen;
+      }
+      
+#ifdef U8G2_WITH_BITMAP_BLIT
+      if ( u8g2_BlitBitmap(u8g2, x + i*8*scale, y + j*scale, len, cnt*scale, block, U8G2_BLIT_LSB_FIRST) )
+	continue;
+#endif /* U8G2_WITH_BITMAP_BLIT */
+      for( r = 0; r < cnt*scale; r++ )
+	u8g2_DrawHXBM(u8g2, x + i*8*scale, y + j*scale + r, len, block + r*out);
+    }
+  }
+}
+
+void u8g2_DrawScaledXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, uint8_t scale, const uint8_t *bitmap)
+{
+  u8g2_draw_scaled_xbm(u8g2, x, y, w, h, scale, bitmap, 0);
+}
+
+void u8g2_DrawScaledXBMP(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, uint8_t scale, const uint8_t *bitmap)
+{
+  u8g2_draw_scaled_xbm(u8g2, x, y, w, h, scale, bitmap, 1);
+}
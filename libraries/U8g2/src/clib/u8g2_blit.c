@@ -0,0 +1,370 @@
+/*
+
+  u8g2_blit.c
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2026, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+  Bitmap blit: bitmaps with one bit per pixel (XBM and u8g2_DrawBitmap())
+  are combined with the buffer one byte at a time instead of one 
+  u8g2_DrawHVLine() per pixel. The bitmap is clipped once against the
+  current buffer (page), only the visible rows and columns are read.
+  
+  ST7920 (horizontal_right_lsb): a buffer byte has 8 pixel of a row. If the
+  bitmap and the buffer bytes start at the same column, each source byte
+  becomes one buffer byte (aligned kernel), otherwise each buffer byte is 
+  shifted together from two source bytes (shifted kernel).
+  
+  SSD13xx, UC1701 (vertical_top_lsb): a buffer byte has 8 pixel of a column.
+  8x8 pixel of the bitmap (8 rows of a tile row, 8 columns) are read with 
+  the same two kernels and transposed into 8 buffer bytes. Rows above and 
+  below the bitmap are excluded by the row mask.
+  
+  A buffer byte d with the bitmap byte v and the mask m of the pixels 
+  inside the bitmap:
+    set = v & m, unset = ~v & m
+    d = (d | (set & s_or) | (unset & u_or)) ^ ((set & s_xor) | (unset & u_xor))
+  The four masks are 0 or 0xff, derived once from the draw color and the 
+  bitmap mode, same rules as u8g2_DrawHXBM(): set pixel with the draw color,
+  unset pixel with the inverted color (0 for XOR) unless transparent.
+
+  Other buffer layouts and rotations are not supported, u8g2_BlitBitmap()
+  returns 0 and the caller draws the pixels with u8g2_DrawHVLine().
+
+*/
+
+#include "u8g2.h"
+#include <string.h>
+
+#ifdef U8G2_WITH_BITMAP_BLIT
+
+typedef struct _u8g2_blit_struct u8g2_blit_t;
+struct _u8g2_blit_struct
+{
+  const uint8_t *bitmap;	/* first visible row */
+  uint16_t stride;		/* bytes per bitmap row, w+7 exceeds u8g2_uint_t in 8 bit mode */
+  u8g2_uint_t i0;		/* first visible column of the bitmap */
+  uint8_t flags;
+  uint8_t is_reverse;		/* bit order of the bitmap differs from the buffer */
+  uint8_t is_transparent;
+  uint8_t s_or, s_xor;		/* masks for the set pixel */
+  uint8_t u_or, u_xor;		/* masks for the unset pixel */
+};
+
+static const uint8_t u8g2_blit_reverse_nibble[16] U8X8_PROGMEM = 
+{
+  0x00, 0x08, 0x04, 0x0c, 0x02, 0x0a, 0x06, 0x0e, 
+  0x01, 0x09, 0x05, 0x0d, 0x03, 0x0b, 0x07, 0x0f
+};
+
+/* source byte in the bit order of the buffer */
+static uint8_t u8g2_blit_read(const u8g2_blit_t *b, const uint8_t *src)
+{
+  uint8_t v;
+  
+  if ( b->flags & U8G2_BLIT_PROGMEM )
+    v = u8x8_pgm_read(src);
+  else
+    v = *src;
+  if ( b->is_reverse )
+    v = (u8x8_pgm_read(u8g2_blit_reverse_nibble + (v & 15)) << 4) | u8x8_pgm_read(u8g2_blit_reverse_nibble + (v >> 4));
+  return v;
+}
+
+/* 
+  8 pixel of a bitmap row, starting at column i, i must be inside the bitmap
+  is_msb_left: 1 for the horizontal buffer (msb is the left pixel), 0 for the vertical buffer (lsb is the left pixel)
+*/
+static uint8_t u8g2_blit_fetch(const u8g2_blit_t *b, const uint8_t *row, u8g2_uint_t i, uint8_t is_msb_left)
+{
+  u8g2_uint_t q = i >> 3;
+  uint8_t r = i & 7;
+  uint8_t v, next;
+  
+  v = u8g2_blit_read(b, row + q);
+  if ( r == 0 )
+    return v;
+  next = 0;
+  if ( q + 1 < b->stride )
+    next = u8g2_blit_read(b, row + q + 1);
+  if ( is_msb_left )
+    return (uint8_t)(v << r) | (uint8_t)(next >> (8 - r));
+  return (uint8_t)(v >> r) | (uint8_t)(next << (8 - r));
+}
+
+static void u8g2_blit_put(const u8g2_blit_t *b, uint8_t *ptr, uint8_t v, uint8_t mask)
+{
+  uint8_t set = v & mask;
+  uint8_t unset = ~v & mask;
+  
+  *ptr = (*ptr | (set & b->s_or) | (unset & b->u_or)) ^ ((set & b->s_xor) | (unset & b->u_xor));
+}
+
+/*
+  one bitmap row into the horizontal buffer
+  ptr	first byte of the buffer row
+  x	first column within the buffer
+  n	number of pixel, n must not be 0
+  row	bitmap row
+*/
+static void u8g2_blit_row_horizontal(const u8g2_blit_t *b, uint8_t *ptr, u8g2_uint_t x, u8g2_uint_t n, const uint8_t *row)
+{
+  u8g2_uint_t i = b->i0;
+  uint8_t s = x & 7;
+  uint8_t mask;
+  
+  ptr += x >> 3;
+  
+  /* first buffer byte, the first pixel is at bit 7-s */
+  mask = 0xff >> s;
+  if ( n < 8 - s )
+    mask &= (uint8_t)(0xff << (8 - s - n));
+  u8g2_blit_put(b, ptr, u8g2_blit_fetch(b, row, i, 1) >> s, mask);
+  if ( n <= 8 - s )
+    return;
+  n -= 8 - s;
+  i += 8 - s;
+  ptr++;
+  
+  if ( (i & 7) == 0 )
+  {
+    /* aligned kernel: one source byte per buffer byte */
+    row += i >> 3;
+    while( n >= 8 )
+    {
+      u8g2_blit_put(b, ptr, u8g2_blit_read(b, row), 0xff);
+      row++;
+      ptr++;
+      n -= 8;
+    }
+    if ( n > 0 )
+      u8g2_blit_put(b, ptr, u8g2_blit_read(b, row), (uint8_t)(0xff << (8 - n)));
+  }
+  else
+  {
+    /* shifted kernel: two source bytes per buffer byte */
+    while( n >= 8 )
+    {
+      u8g2_blit_put(b, ptr, u8g2_blit_fetch(b, row, i, 1), 0xff);
+      i += 8;
+      ptr++;
+      n -= 8;
+    }
+    if ( n > 0 )
+      u8g2_blit_put(b, ptr, u8g2_blit_fetch(b, row, i, 1), (uint8_t)(0xff << (8 - n)));
+  }
+}
+
+/*
+  8x8 bit matrix transpose (Hacker's Delight, transpose8): 8 rows with the
+  left pixel in the lsb (rows[0] on top) to 8 columns with the top pixel in
+  the lsb
+*/
+static void u8g2_blit_transpose(const uint8_t *rows, uint8_t *cols)
+{
+  uint32_t x, y, t;
+  
+  x = ((uint32_t)rows[7] << 24) | ((uint32_t)rows[6] << 16) | ((uint32_t)rows[5] << 8) | rows[4];
+  y = ((uint32_t)rows[3] << 24) | ((uint32_t)rows[2] << 16) | ((uint32_t)rows[1] << 8) | rows[0];
+  
+  t = (x ^ (x >> 7)) & 0x00AA00AAUL;  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00AA00AAUL;  y = y ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCCUL;  x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000CCCCUL;  y = y ^ t ^ (t << 14);
+  t = (x & 0xF0F0F0F0UL) | ((y >> 4) & 0x0F0F0F0FUL);
+  y = ((x << 4) & 0xF0F0F0F0UL) | (y & 0x0F0F0F0FUL);
+  x = t;
+  
+  cols[0] = y; cols[1] = y >> 8; cols[2] = y >> 16; cols[3] = y >> 24;
+  cols[4] = x; cols[5] = x >> 8; cols[6] = x >> 16; cols[7] = x >> 24;
+}
+
+/*
+  rows r0..r1-1 (0..8) of one tile row of the vertical buffer
+  ptr	first byte of the tile row plus the first column
+  n	number of columns, n must not be 0
+  row	bitmap row for r0
+*/
+static void u8g2_blit_tile_row_vertical(const u8g2_blit_t *b, uint8_t *ptr, u8g2_uint_t n, uint8_t r0, uint8_t r1, const uint8_t *row)
+{
+  uint8_t rows[8];
+  uint8_t cols[8];
+  u8g2_uint_t i = b->i0;
+  uint8_t mask, r, k, cnt, is_empty;
+  const uint8_t *src;
+  
+  mask = (uint8_t)(0xff << r0) & (uint8_t)(0xff >> (8 - r1));
+  memset(rows, 0, 8);
+  for(;;)
+  {
+    is_empty = 1;
+    src = row;
+    for( r = r0; r < r1; r++ )
+    {
+      if ( (i & 7) == 0 )
+	rows[r] = u8g2_blit_read(b, src + (i >> 3));	/* aligned kernel */
+      else
+	rows[r] = u8g2_blit_fetch(b, src, i, 0);	/* shifted kernel */
+      if ( rows[r] != 0 )
+	is_empty = 0;
+      src += b->stride;
+    }
+    
+    cnt = 8;
+    if ( n < 8 )
+      cnt = n;
+    /* nothing to do for transparent bitmaps without set pixel */
+    if ( is_empty == 0 || b->is_transparent == 0 )
+    {
+      u8g2_blit_transpose(rows, cols);
+      for( k = 0; k < cnt; k++ )
+	u8g2_blit_put(b, ptr + k, cols[k], mask);
+    }
+    if ( n <= 8 )
+      break;
+    n -= 8;
+    i += 8;
+    ptr += 8;
+  }
+}
+
+/*
+  visible part of a..a+len-1 within 0..limit-1, positions wrap around like
+  u8g2_DrawHVLine() does (negative positions)
+  returns the number of visible pixel, *first is the first visible index
+*/
+static u8g2_uint_t u8g2_blit_clip(u8g2_uint_t a, u8g2_uint_t len, u8g2_uint_t limit, u8g2_uint_t *first)
+{
+  u8g2_uint_t i = 0;
+  
+  if ( a >= limit )
+  {
+    /* left of the buffer (negative position) or right of it */
+    i -= a;
+    if ( i >= len )
+      return 0;
+    a = 0;
+  }
+  *first = i;
+  len -= i;
+  if ( len > limit - a )
+    len = limit - a;
+  return len;
+}
+
+uint8_t u8g2_BlitBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap, uint8_t flags)
+{
+  u8g2_blit_t b;
+  u8g2_uint_t j0, n, nh;
+  uint8_t is_horizontal;
+  uint8_t color = u8g2->draw_color;
+  uint8_t tile_width = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  uint8_t *ptr;
+  uint8_t r0, r1;
+  
+  if ( u8g2->cb != U8G2_R0 )
+    return 0;
+  if ( u8g2->ll_hvline == u8g2_ll_hvline_horizontal_right_lsb )
+    is_horizontal = 1;
+  else if ( u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb )
+    is_horizontal = 0;
+  else
+    return 0;
+  
+#ifdef U8G2_WITH_DISPLAY_LIST
+  /* no display list item: stop the recording and draw directly */
+  if ( u8g2_IsRecording(u8g2) )
+    u8g2_display_list_abort(u8g2);
+#endif /* U8G2_WITH_DISPLAY_LIST */
+  
+  /* clipping against the buffer, once for the whole bitmap */
+  n = u8g2_blit_clip(x, w, u8g2->pixel_buf_width, &b.i0);
+  if ( n == 0 )
+    return 1;
+  x += b.i0;
+  y -= u8g2->tile_curr_row*8;
+  nh = u8g2_blit_clip(y, h, u8g2->pixel_buf_height, &j0);
+  if ( nh == 0 )
+    return 1;
+  y += j0;
+  
+  b.stride = w;
+  b.stride += 7;
+  b.stride >>= 3;
+  b.bitmap = bitmap + (uint16_t)j0 * b.stride;
+  b.flags = flags;
+  /* the horizontal buffer has the left pixel in the msb, the vertical buffer in the lsb */
+  b.is_reverse = ((flags & U8G2_BLIT_LSB_FIRST) != 0) == (is_horizontal != 0);
+  b.is_transparent = u8g2->bitmap_transparency;
+  b.s_or = color <= 1 ? 0xff : 0;
+  b.s_xor = color != 1 ? 0xff : 0;
+  b.u_or = 0;
+  b.u_xor = 0;
+  if ( b.is_transparent == 0 )
+  {
+    /* the inverted color is 1 for color 0, otherwise 0 */
+    b.u_or = 0xff;
+    b.u_xor = color != 0 ? 0xff : 0;
+  }
+  
+  if ( is_horizontal )
+  {
+    ptr = u8g2->tile_buf_ptr + (uint16_t)y * tile_width;
+    bitmap = b.bitmap;
+    do
+    {
+      u8g2_blit_row_horizontal(&b, ptr, x, n, bitmap);
+      bitmap += b.stride;
+      ptr += tile_width;
+      nh--;
+    } while( nh != 0 );
+  }
+  else
+  {
+    ptr = u8g2->tile_buf_ptr + (uint16_t)(y >> 3) * tile_width * 8 + x;
+    bitmap = b.bitmap;
+    r0 = y & 7;
+    for(;;)
+    {
+      r1 = 8;
+      if ( nh < (u8g2_uint_t)(8 - r0) )
+	r1 = r0 + nh;
+      u8g2_blit_tile_row_vertical(&b, ptr, n, r0, r1, bitmap);
+      nh -= r1 - r0;
+      if ( nh == 0 )
+	break;
+      bitmap += (uint16_t)(r1 - r0) * b.stride;
+      ptr += tile_width * 8;
+      r0 = 0;
+    }
+  }
+  return 1;
+}
+
+#endif /* U8G2_WITH_BITMAP_BLIT */
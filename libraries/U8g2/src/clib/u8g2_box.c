@@ -39,12 +39,63 @@
   draw a filled box
   restriction: does not work for w = 0 or h = 0
 */
+#ifdef U8G2_WITH_CLIPPING
+/* 
+  u8g2_ll_hvline_vertical_top_lsb without rotation: modify all lines of 
+  the box within a tile row with one access per byte
+*/
+static void u8g2_draw_box_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  u8g2_uint_t a;
+  uint8_t bit_pos, cnt;
+  
+  y -= u8g2->tile_curr_row*8;
+  
+  a = x;
+  a += w;
+  if ( u8g2_clip_intersection(&x, &a, u8g2->pixel_buf_width) == 0 )
+    return;
+  w = a;
+  w -= x;
+  
+  a = y;
+  a += h;
+  if ( u8g2_clip_intersection(&y, &a, u8g2->pixel_buf_height) == 0 )
+    return;
+  h = a;
+  h -= y;
+  
+  while( h != 0 )
+  {
+    bit_pos = y & 7;
+    cnt = 8 - bit_pos;
+    if ( cnt > h )
+      cnt = h;
+    u8g2_ll_span_vertical_top_lsb(u8g2, x, y, w, (uint8_t)(((1 << cnt) - 1) << bit_pos));
+    y += cnt;
+    h -= cnt;
+  }
+}
+#endif /* U8G2_WITH_CLIPPING */
+
 void u8g2_DrawBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
 {
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2_IsRecording(u8g2) && u8g2_display_list_add(u8g2, U8G2_DL_BOX, x, y, w, h) )
+    return;
+#endif /* U8G2_WITH_DISPLAY_LIST */
 #ifdef U8G2_WITH_INTERSECTION
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
 #endif /* U8G2_WITH_INTERSECTION */
+#ifdef U8G2_WITH_CLIPPING
+  if ( u8g2->cb == U8G2_R0 && u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb )
+  {
+    if ( w != 0 )
+      u8g2_draw_box_vertical_top_lsb(u8g2, x, y, w, h);
+    return;
+  }
+#endif /* U8G2_WITH_CLIPPING */
   while( h != 0 )
   { 
     u8g2_DrawHVLine(u8g2, x, y, w, 0);
@@ -64,6 +115,10 @@ void u8g2_DrawFrame(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u
 {
   u8g2_uint_t xtmp = x;
   
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2_IsRecording(u8g2) && u8g2_display_list_add(u8g2, U8G2_DL_FRAME, x, y, w, h) )
+    return;
+#endif /* U8G2_WITH_DISPLAY_LIST */
 #ifdef U8G2_WITH_INTERSECTION
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
@@ -48,7 +48,7 @@ void u8g2_ClearBuffer(u8g2_t *u8g2)
 
 /*============================================*/
 
-static void u8g2_send_tile_row(u8g2_t *u8g2, uint8_t src_tile_row, uint8_t dest_tile_row)
+static void u8g2_send_buffer_tile_row(u8g2_t *u8g2, uint8_t *buf, uint8_t src_tile_row, uint8_t dest_tile_row)
 {
   uint8_t *ptr;
   uint16_t offset;
@@ -56,13 +56,18 @@ static void u8g2_send_tile_row(u8g2_t *u8g2, uint8_t src_tile_row, uint8_t dest_
   
   w = u8g2_GetU8x8(u8g2)->display_info->tile_width;
   offset = src_tile_row;
-  ptr = u8g2->tile_buf_ptr;
+  ptr = buf;
   offset *= w;
   offset *= 8;
   ptr += offset;
   u8x8_DrawTile(u8g2_GetU8x8(u8g2), 0, dest_tile_row, w, ptr);
 }
 
+static void u8g2_send_tile_row(u8g2_t *u8g2, uint8_t src_tile_row, uint8_t dest_tile_row)
+{
+  u8g2_send_buffer_tile_row(u8g2, u8g2->tile_buf_ptr, src_tile_row, dest_tile_row);
+}
+
 /* 
   write the buffer to the display RAM. 
   For most displays, this will make the content visible to the user.
@@ -130,3 +135,157 @@ uint8_t u8g2_NextPage(u8g2_t *u8g2)
   u8g2_SetBufferCurrTileRow(u8g2, row);
   return 1;
 }
+
+/*============================================*/
+/* incremental rendering */
+
+#define U8G2_RENDER_NOT_DRAWN 255
+
+void u8g2_RenderStart(u8g2_t *u8g2, u8g2_render_cb render_cb)
+{
+  u8g2->render_cb = render_cb;
+  u8g2->render_tile_row = U8G2_RENDER_NOT_DRAWN;
+  u8g2_FirstPage(u8g2);
+}
+
+uint8_t u8g2_RenderStep(u8g2_t *u8g2)
+{
+  uint8_t tile_height;
+  
+  if ( u8g2->render_cb == NULL )
+    return 0;
+  
+  tile_height = u8g2_GetU8x8(u8g2)->display_info->tile_height;
+  
+  if ( u8g2->tile_buf_height < tile_height )
+  {
+    /* page buffer: draw and send one page */
+#ifdef U8G2_WITH_DISPLAY_LIST
+    if ( u8g2->display_list.buf != NULL && u8g2->tile_curr_row == 0 )
+    {
+      /* first page: record the frame, the other pages only replay it */
+      /* if the recording stops, the first page is already drawn */
+      u8g2_BeginDisplayList(u8g2);
+      u8g2->render_cb(u8g2);
+      if ( u8g2_EndDisplayList(u8g2) )
+	u8g2_DrawDisplayList(u8g2);
+    }
+    else if ( u8g2->display_list.buf != NULL && u8g2->display_list.is_valid != 0 )
+      u8g2_DrawDisplayList(u8g2);
+    else
+#endif /* U8G2_WITH_DISPLAY_LIST */
+      u8g2->render_cb(u8g2);
+    if ( u8g2_NextPage(u8g2) != 0 )
+      return 1;
+  }
+  else
+  {
+    /* full buffer: draw everything once, then send one tile row per step */
+    if ( u8g2->render_tile_row == U8G2_RENDER_NOT_DRAWN )
+    {
+      u8g2->render_cb(u8g2);
+      u8g2->render_tile_row = 0;
+      return 1;
+    }
+    u8g2_send_tile_row(u8g2, u8g2->render_tile_row, u8g2->render_tile_row);
+    u8g2->render_tile_row++;
+    if ( u8g2->render_tile_row < tile_height )
+      return 1;
+    u8x8_RefreshDisplay( u8g2_GetU8x8(u8g2) );
+  }
+  
+  u8g2->render_cb = NULL;
+  return 0;
+}
+
+#ifdef U8G2_WITH_FRONT_BUFFER
+
+/*============================================*/
+/* double buffer */
+
+#define U8G2_FRONT_DIRTY_ROWS 32
+
+void u8g2_SetFrontBuffer(u8g2_t *u8g2, uint8_t *buf)
+{
+  u8g2->front_buf_ptr = buf;
+  /* the display content is unknown: send all tile rows with the next frame */
+  u8g2->front_dirty = 0xffffffffUL;
+  u8g2->front_tile_row = u8g2_GetU8x8(u8g2)->display_info->tile_height;
+  u8g2->is_swap_pending = 0;
+}
+
+/* returns the first changed tile row from row on or tile_height */
+static uint8_t u8g2_next_front_tile_row(u8g2_t *u8g2, uint8_t row)
+{
+  uint8_t tile_height = u8g2_GetU8x8(u8g2)->display_info->tile_height;
+  while( row < tile_height && row < U8G2_FRONT_DIRTY_ROWS && (u8g2->front_dirty & (1UL << row)) == 0 )
+    row++;
+  return row;
+}
+
+/* copy the back buffer into the front buffer and remember the changed tile rows */
+static void u8g2_swap_buffer(u8g2_t *u8g2)
+{
+  uint16_t row_size;
+  uint8_t *src;
+  uint8_t *dest;
+  uint8_t row;
+  uint8_t tile_height;
+  
+  tile_height = u8g2_GetU8x8(u8g2)->display_info->tile_height;
+  row_size = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  row_size *= 8;
+  src = u8g2->tile_buf_ptr;
+  dest = u8g2->front_buf_ptr;
+  for( row = 0; row < tile_height; row++ )
+  {
+    if ( memcmp(dest, src, row_size) != 0 )
+    {
+      memcpy(dest, src, row_size);
+      if ( row < U8G2_FRONT_DIRTY_ROWS )
+	u8g2->front_dirty |= 1UL << row;
+    }
+    src += row_size;
+    dest += row_size;
+  }
+  u8g2->front_tile_row = u8g2_next_front_tile_row(u8g2, 0);
+  u8g2->is_swap_pending = 0;
+}
+
+void u8g2_SwapBuffer(u8g2_t *u8g2)
+{
+  u8g2->is_swap_pending = 1;
+  if ( u8g2->front_tile_row >= u8g2_GetU8x8(u8g2)->display_info->tile_height )
+    u8g2_swap_buffer(u8g2);
+}
+
+uint8_t u8g2_TransferStep(u8g2_t *u8g2)
+{
+  uint8_t row;
+  
+  if ( u8g2->front_buf_ptr == NULL )
+    return 0;
+  
+  row = u8g2->front_tile_row;
+  if ( row < u8g2_GetU8x8(u8g2)->display_info->tile_height )
+  {
+    u8g2_send_buffer_tile_row(u8g2, u8g2->front_buf_ptr, row, row);
+    if ( row < U8G2_FRONT_DIRTY_ROWS )
+      u8g2->front_dirty &= ~(1UL << row);
+    row = u8g2_next_front_tile_row(u8g2, row+1);
+    u8g2->front_tile_row = row;
+    if ( row >= u8g2_GetU8x8(u8g2)->display_info->tile_height )
+      u8x8_RefreshDisplay( u8g2_GetU8x8(u8g2) );
+    return 1;
+  }
+  
+  if ( u8g2->is_swap_pending )
+  {
+    /* the previous frame is complete, continue with the next frame */
+    u8g2_swap_buffer(u8g2);
+    return 1;
+  }
+  return 0;
+}
+
+#endif /* U8G2_WITH_FRONT_BUFFER */
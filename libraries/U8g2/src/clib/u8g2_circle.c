@@ -38,36 +38,47 @@
 /*==============================================*/
 /* Circle */
 
-static void u8g2_draw_circle_section(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t x0, u8g2_uint_t y0, uint8_t option) U8G2_NOINLINE;
+/*
+  Draws the points xs..xe at distance y of all selected quadrants. The 
+  points are a horizontal run in one octant and a vertical run in the 
+  other octant of each quadrant.
+*/
+static void u8g2_draw_circle_run(u8g2_t *u8g2, u8g2_uint_t xs, u8g2_uint_t xe, u8g2_uint_t y, u8g2_uint_t x0, u8g2_uint_t y0, uint8_t option) U8G2_NOINLINE;
 
-static void u8g2_draw_circle_section(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t x0, u8g2_uint_t y0, uint8_t option)
+static void u8g2_draw_circle_run(u8g2_t *u8g2, u8g2_uint_t xs, u8g2_uint_t xe, u8g2_uint_t y, u8g2_uint_t x0, u8g2_uint_t y0, uint8_t option)
 {
+    u8g2_uint_t len;
+    
+    len = xe;
+    len -= xs;
+    len++;
+  
     /* upper right */
     if ( option & U8G2_DRAW_UPPER_RIGHT )
     {
-      u8g2_DrawPixel(u8g2, x0 + x, y0 - y);
-      u8g2_DrawPixel(u8g2, x0 + y, y0 - x);
+      u8g2_draw_pixel_span(u8g2, x0 + xs, y0 - y, len, 0);
+      u8g2_draw_pixel_span(u8g2, x0 + y, y0 - xe, len, 1);
     }
     
     /* upper left */
     if ( option & U8G2_DRAW_UPPER_LEFT )
     {
-      u8g2_DrawPixel(u8g2, x0 - x, y0 - y);
-      u8g2_DrawPixel(u8g2, x0 - y, y0 - x);
+      u8g2_draw_pixel_span(u8g2, x0 - xe, y0 - y, len, 0);
+      u8g2_draw_pixel_span(u8g2, x0 - y, y0 - xe, len, 1);
     }
     
     /* lower right */
     if ( option & U8G2_DRAW_LOWER_RIGHT )
     {
-      u8g2_DrawPixel(u8g2, x0 + x, y0 + y);
-      u8g2_DrawPixel(u8g2, x0 + y, y0 + x);
+      u8g2_draw_pixel_span(u8g2, x0 + xs, y0 + y, len, 0);
+      u8g2_draw_pixel_span(u8g2, x0 + y, y0 + xs, len, 1);
     }
     
     /* lower left */
     if ( option & U8G2_DRAW_LOWER_LEFT )
     {
-      u8g2_DrawPixel(u8g2, x0 - x, y0 + y);
-      u8g2_DrawPixel(u8g2, x0 - y, y0 + x);
+      u8g2_draw_pixel_span(u8g2, x0 - xe, y0 + y, len, 0);
+      u8g2_draw_pixel_span(u8g2, x0 - y, y0 + xs, len, 1);
     }
 }
 
@@ -78,6 +89,7 @@ static void u8g2_draw_circle(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_
     u8g2_int_t ddF_y;
     u8g2_uint_t x;
     u8g2_uint_t y;
+    u8g2_uint_t xs;
 
     f = 1;
     f -= rad;
@@ -87,13 +99,16 @@ static void u8g2_draw_circle(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_
     ddF_y *= 2;
     x = 0;
     y = rad;
-
-    u8g2_draw_circle_section(u8g2, x, y, x0, y0, option);
+    
+    /* first point of the current run, all points of a run have the same y */
+    xs = 0;
     
     while ( x < y )
     {
       if (f >= 0) 
       {
+	u8g2_draw_circle_run(u8g2, xs, x, y, x0, y0, option);
+	xs = x+1;
         y--;
         ddF_y += 2;
         f += ddF_y;
@@ -101,9 +116,8 @@ static void u8g2_draw_circle(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_
       x++;
       ddF_x += 2;
       f += ddF_x;
-
-      u8g2_draw_circle_section(u8g2, x, y, x0, y0, option);    
     }
+    u8g2_draw_circle_run(u8g2, xs, x, y, x0, y0, option);
 }
 
 void u8g2_DrawCircle(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option)
@@ -0,0 +1,681 @@
+/*
+
+  u8g2_display_list.c
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2026, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+
+  Display list for the page buffer: The draw procedures of a frame are
+  recorded once and replayed for each page.
+
+  Each item starts with the item type and the size of the data part. 
+  A draw item contains the first and the last page on which its bounding 
+  box is visible and the position of the state item with font, color, 
+  font mode, bitmap mode and font direction. A state item is added before
+  a draw item if the state has changed since the previous state item.
+  Draw items which are not visible on any page are not stored.
+
+  A group item (u8g2_BeginGroup()) contains the pages of the group box and
+  the position of the enclosing group item. The pages of the items inside 
+  of the group are limited to the pages of the group.
+
+  The bucket table at the end of buf counts the draw items of each page 
+  during the recording. u8g2_EndDisplayList() adds the buckets behind the 
+  items: the positions of the draw items which are visible on the page.
+  Then the table contains the start of each bucket, the end is the start 
+  of the next bucket. u8g2_DrawDisplayList() draws the items of the bucket
+  for the current page only.
+
+  If the display list is not complete (buf too small, draw procedure 
+  without item), the recording stops: The items so far are drawn into the 
+  current page and all following draw procedures draw directly.
+
+*/
+
+#include "u8g2.h"
+#include <string.h>
+
+#ifdef U8G2_WITH_DISPLAY_LIST
+
+#define U8G2_DL_NO_STATE 0xffff
+#define U8G2_DL_NO_GROUP 0xffff
+
+/* u8g2_setup.c */
+extern void u8g2_update_dimension_r1(u8g2_t *u8g2);
+extern void u8g2_update_dimension_r2(u8g2_t *u8g2);
+extern void u8g2_update_dimension_r3(u8g2_t *u8g2);
+
+typedef struct
+{
+  u8g2_uint_t x0, y0, x1, y1;		/* x1 and y1 are excluded, see u8g2_IsIntersection() */
+} u8g2_dl_bbox_t;
+
+/* first part of all draw items */
+typedef struct
+{
+  uint16_t state;			/* position of the state item */
+  uint8_t first_page;
+  uint8_t last_page;
+} u8g2_dl_head_t;
+
+/* box, frame, line, hline and vline with the arguments of the draw procedure */
+typedef struct
+{
+  u8g2_dl_head_t head;
+  u8g2_uint_t a, b, c, d;
+} u8g2_dl_draw_t;
+
+typedef struct
+{
+  u8g2_dl_head_t head;
+  u8g2_uint_t x, y, w, h;
+  const uint8_t *bitmap;
+} u8g2_dl_bitmap_t;
+
+typedef struct
+{
+  u8g2_dl_head_t head;
+  u8g2_uint_t x, y;
+  uint16_t encoding;
+} u8g2_dl_glyph_t;
+
+typedef struct
+{
+  uint16_t parent;			/* position of the enclosing group item */
+  uint8_t first_page;
+  uint8_t last_page;
+} u8g2_dl_group_t;
+
+typedef struct
+{
+  const uint8_t *font;
+  u8g2_font_calc_vref_fnptr font_calc_vref;
+  uint8_t font_height_mode;
+  int8_t font_ref_ascent;
+  int8_t font_ref_descent;
+  uint8_t draw_color;
+  uint8_t is_transparent;
+  uint8_t bitmap_transparency;
+  uint8_t dir;
+} u8g2_dl_state_t;
+
+typedef union
+{
+  u8g2_dl_head_t head;
+  u8g2_dl_draw_t draw;
+  u8g2_dl_bitmap_t bitmap;
+  u8g2_dl_glyph_t glyph;
+} u8g2_dl_item_t;
+
+static uint16_t u8g2_display_list_get_word(const uint8_t *ptr)
+{
+  uint16_t v;
+  memcpy(&v, ptr, sizeof(uint16_t));
+  return v;
+}
+
+static void u8g2_display_list_set_word(uint8_t *ptr, uint16_t v)
+{
+  memcpy(ptr, &v, sizeof(uint16_t));
+}
+
+static uint8_t u8g2_display_list_get_page_cnt(u8g2_t *u8g2)
+{
+  uint8_t tile_height = u8g2_GetU8x8(u8g2)->display_info->tile_height;
+  return (tile_height + u8g2->tile_buf_height - 1) / u8g2->tile_buf_height;
+}
+
+static void u8g2_display_list_get_state(u8g2_t *u8g2, u8g2_dl_state_t *state)
+{
+  /* clear the padding bytes for memcmp() */
+  memset(state, 0, sizeof(u8g2_dl_state_t));
+  state->font = u8g2->font;
+  state->font_calc_vref = u8g2->font_calc_vref;
+  state->font_height_mode = u8g2->font_height_mode;
+  state->font_ref_ascent = u8g2->font_ref_ascent;
+  state->font_ref_descent = u8g2->font_ref_descent;
+  state->draw_color = u8g2->draw_color;
+  state->is_transparent = u8g2->font_decode.is_transparent;
+  state->bitmap_transparency = u8g2->bitmap_transparency;
+#ifdef U8G2_WITH_FONT_ROTATION
+  state->dir = u8g2->font_decode.dir;
+#endif
+}
+
+static void u8g2_display_list_set_state(u8g2_t *u8g2, const u8g2_dl_state_t *state)
+{
+  if ( state->font != NULL )
+    u8g2_SetFont(u8g2, state->font);
+  u8g2->font_calc_vref = state->font_calc_vref;
+  u8g2->font_height_mode = state->font_height_mode;
+  u8g2->font_ref_ascent = state->font_ref_ascent;
+  u8g2->font_ref_descent = state->font_ref_descent;
+  u8g2->draw_color = state->draw_color;
+  u8g2->font_decode.is_transparent = state->is_transparent;
+  u8g2->bitmap_transparency = state->bitmap_transparency;
+#ifdef U8G2_WITH_FONT_ROTATION
+  u8g2->font_decode.dir = state->dir;
+#endif
+}
+
+/* ptr is the start of a draw item, state is the position of the state item which has been set before */
+static void u8g2_display_list_draw_item(u8g2_t *u8g2, const uint8_t *ptr, uint16_t *state)
+{
+  u8g2_dl_item_t item;
+  u8g2_dl_state_t s;
+  
+  memcpy(&item, ptr + 2, sizeof(u8g2_dl_head_t));
+  if ( item.head.state != *state )
+  {
+    *state = item.head.state;
+    memcpy(&s, u8g2->display_list.buf + *state + 2, sizeof(u8g2_dl_state_t));
+    u8g2_display_list_set_state(u8g2, &s);
+  }
+  
+  switch(ptr[0])
+  {
+    case U8G2_DL_XBM:
+    case U8G2_DL_XBMP:
+      memcpy(&item, ptr + 2, sizeof(u8g2_dl_bitmap_t));
+      break;
+    case U8G2_DL_GLYPH:
+      memcpy(&item, ptr + 2, sizeof(u8g2_dl_glyph_t));
+      break;
+    default:
+      memcpy(&item, ptr + 2, sizeof(u8g2_dl_draw_t));
+      break;
+  }
+  
+  switch(ptr[0])
+  {
+    case U8G2_DL_BOX:
+      u8g2_DrawBox(u8g2, item.draw.a, item.draw.b, item.draw.c, item.draw.d);
+      break;
+    case U8G2_DL_FRAME:
+      u8g2_DrawFrame(u8g2, item.draw.a, item.draw.b, item.draw.c, item.draw.d);
+      break;
+    case U8G2_DL_LINE:
+      u8g2_DrawLine(u8g2, item.draw.a, item.draw.b, item.draw.c, item.draw.d);
+      break;
+    case U8G2_DL_HLINE:
+      u8g2_DrawHLine(u8g2, item.draw.a, item.draw.b, item.draw.c);
+      break;
+    case U8G2_DL_VLINE:
+      u8g2_DrawVLine(u8g2, item.draw.a, item.draw.b, item.draw.c);
+      break;
+    case U8G2_DL_XBM:
+      u8g2_DrawXBM(u8g2, item.bitmap.x, item.bitmap.y, item.bitmap.w, item.bitmap.h, item.bitmap.bitmap);
+      break;
+    case U8G2_DL_XBMP:
+      u8g2_DrawXBMP(u8g2, item.bitmap.x, item.bitmap.y, item.bitmap.w, item.bitmap.h, item.bitmap.bitmap);
+      break;
+    case U8G2_DL_GLYPH:
+      u8g2_DrawGlyph(u8g2, item.glyph.x, item.glyph.y, item.glyph.encoding);
+      break;
+  }
+}
+
+/*===============================================*/
+
+static void u8g2_display_list_stop(u8g2_t *u8g2)
+{
+  if ( u8g2->display_list.is_recording )
+  {
+    u8g2->display_list.is_recording = 0;
+    /* restore the clip box of the current page */
+    u8g2->cb->update(u8g2);
+  }
+}
+
+void u8g2_SetDisplayList(u8g2_t *u8g2, void *buf, uint16_t size)
+{
+  u8g2_display_list_stop(u8g2);
+  u8g2->display_list.buf = (uint8_t *)buf;
+  u8g2->display_list.size = size;
+  u8g2->display_list.used = 0;
+  u8g2->display_list.is_valid = 0;
+}
+
+void u8g2_BeginDisplayList(u8g2_t *u8g2)
+{
+  u8g2_display_list_t *dl = &(u8g2->display_list);
+  uint16_t cnt;
+  
+  dl->used = 0;
+  dl->state_pos = U8G2_DL_NO_STATE;
+  dl->group_pos = U8G2_DL_NO_GROUP;
+  dl->is_valid = 0;
+  if ( dl->buf == NULL )
+    return;
+  cnt = (u8g2_display_list_get_page_cnt(u8g2) + 1) * 2;
+  if ( dl->size < cnt )
+    return;
+  dl->bucket_pos = dl->size - cnt;
+  memset(dl->buf + dl->bucket_pos, 0, cnt);
+  dl->is_valid = 1;
+  dl->is_recording = 1;
+  
+  /* user code must not skip anything because of u8g2_IsIntersection() */
+  u8g2->user_x0 = 0;
+  u8g2->user_y0 = 0;
+  u8g2->user_x1 = u8g2->width;
+  u8g2->user_y1 = u8g2->height;
+}
+
+/*
+  Stop the recording, draw the items so far into the current page. 
+  The caller draws directly after this.
+*/
+void u8g2_display_list_abort(u8g2_t *u8g2)
+{
+  u8g2_display_list_t *dl = &(u8g2->display_list);
+  u8g2_dl_state_t state;
+  u8g2_dl_head_t head;
+  uint16_t pos, state_pos;
+  uint8_t page;
+  uint8_t *ptr;
+  
+  dl->is_valid = 0;
+  u8g2_display_list_stop(u8g2);
+  
+  u8g2_display_list_get_state(u8g2, &state);
+  page = u8g2->tile_curr_row / u8g2->tile_buf_height;
+  state_pos = U8G2_DL_NO_STATE;
+  pos = 0;
+  while( pos < dl->used )
+  {
+    ptr = dl->buf + pos;
+    pos += ptr[1] + 2;
+    if ( ptr[0] == U8G2_DL_STATE || ptr[0] == U8G2_DL_GROUP )
+      continue;
+    memcpy(&head, ptr + 2, sizeof(u8g2_dl_head_t));
+    if ( page >= head.first_page && page <= head.last_page )
+      u8g2_display_list_draw_item(u8g2, ptr, &state_pos);
+  }
+  u8g2_display_list_set_state(u8g2, &state);
+}
+
+/*
+  Sort the draw items into the buckets of their pages (counting sort), 
+  returns 0 if there is not enough space in buf.
+*/
+static uint8_t u8g2_display_list_add_buckets(u8g2_t *u8g2)
+{
+  u8g2_display_list_t *dl = &(u8g2->display_list);
+  u8g2_dl_head_t head;
+  uint16_t pos, cnt, total;
+  uint8_t page_cnt, page;
+  uint8_t *ptr;
+  uint8_t *bucket = dl->buf + dl->bucket_pos;
+  
+  /* start of each bucket */
+  page_cnt = u8g2_display_list_get_page_cnt(u8g2);
+  total = 0;
+  for( page = 0; page < page_cnt; page++ )
+  {
+    cnt = u8g2_display_list_get_word(bucket + page*2);
+    u8g2_display_list_set_word(bucket + page*2, dl->used + total*2);
+    total += cnt;
+  }
+  if ( total > (uint16_t)(dl->bucket_pos - dl->used) / 2 )
+    return 0;
+  
+  /* positions of the items, each bucket start becomes the start of the next bucket */
+  for( pos = 0; pos < dl->used; pos += ptr[1] + 2 )
+  {
+    ptr = dl->buf + pos;
+    if ( ptr[0] == U8G2_DL_STATE || ptr[0] == U8G2_DL_GROUP )
+      continue;
+    memcpy(&head, ptr + 2, sizeof(u8g2_dl_head_t));
+    for( page = head.first_page; page <= head.last_page; page++ )
+    {
+      cnt = u8g2_display_list_get_word(bucket + page*2);
+      u8g2_display_list_set_word(dl->buf + cnt, pos);
+      u8g2_display_list_set_word(bucket + page*2, cnt + 2);
+    }
+  }
+  
+  /* the last entry is the end of the last bucket */
+  for( page = page_cnt; page > 0; page-- )
+    u8g2_display_list_set_word(bucket + page*2, u8g2_display_list_get_word(bucket + (page-1)*2));
+  u8g2_display_list_set_word(bucket, dl->used);
+  return 1;
+}
+
+uint8_t u8g2_EndDisplayList(u8g2_t *u8g2)
+{
+  if ( u8g2->display_list.is_recording )
+  {
+    /* a group without u8g2_EndGroup() is not complete */
+    if ( u8g2->display_list.group_pos != U8G2_DL_NO_GROUP || u8g2_display_list_add_buckets(u8g2) == 0 )
+      u8g2_display_list_abort(u8g2);
+    else
+      u8g2_display_list_stop(u8g2);
+  }
+  return u8g2->display_list.is_valid;
+}
+
+/*===============================================*/
+/* recording */
+
+/* returns a pointer to the data part of the new item or NULL if buf is full */
+static uint8_t *u8g2_display_list_alloc(u8g2_t *u8g2, uint8_t type, uint8_t size)
+{
+  u8g2_display_list_t *dl = &(u8g2->display_list);
+  uint8_t *ptr;
+  
+  if ( (uint16_t)(dl->bucket_pos - dl->used) < (uint16_t)(size + 2) )
+  {
+    u8g2_display_list_abort(u8g2);
+    return NULL;
+  }
+  ptr = dl->buf + dl->used;
+  ptr[0] = type;
+  ptr[1] = size;
+  dl->used += size + 2;
+  return ptr + 2;
+}
+
+/* 
+  Pages of the box, limited to the pages of the enclosing group. 
+  first_page > last_page if the box is not visible on any page.
+*/
+static void u8g2_display_list_get_pages(u8g2_t *u8g2, const u8g2_dl_bbox_t *bbox, uint8_t *first_page, uint8_t *last_page)
+{
+  u8g2_display_list_t *dl = &(u8g2->display_list);
+  u8g2_dl_group_t group;
+  u8g2_uint_t t;
+  uint16_t a, b, h;
+  
+  /* pixel rows a (included) to b (excluded) in the orientation of the buffer */
+  if ( u8g2->cb->update == u8g2_update_dimension_r1 )
+  {
+    a = bbox->x0;
+    b = bbox->x1;
+  }
+  else if ( u8g2->cb->update == u8g2_update_dimension_r2 )
+  {
+    t = u8g2->height - bbox->y1;
+    a = t;
+    t = u8g2->height - bbox->y0;
+    b = t;
+  }
+  else if ( u8g2->cb->update == u8g2_update_dimension_r3 )
+  {
+    t = u8g2->width - bbox->x1;
+    a = t;
+    t = u8g2->width - bbox->x0;
+    b = t;
+  }
+  else
+  {
+    a = bbox->y0;
+    b = bbox->y1;
+  }
+  
+  h = u8g2_GetU8x8(u8g2)->display_info->tile_height;
+  h *= 8;
+  if ( a > b )
+  {
+    /* the box starts at a negative position */
+    if ( a < h )
+      b = h;
+    a = 0;
+  }
+  if ( b > h )
+    b = h;
+  if ( a >= b )
+  {
+    *first_page = 1;
+    *last_page = 0;
+    return;
+  }
+  *first_page = (a / 8) / u8g2->tile_buf_height;
+  *last_page = ((b - 1) / 8) / u8g2->tile_buf_height;
+  
+  if ( dl->group_pos != U8G2_DL_NO_GROUP )
+  {
+    memcpy(&group, dl->buf + dl->group_pos + 2, sizeof(u8g2_dl_group_t));
+    if ( *first_page < group.first_page )
+      *first_page = group.first_page;
+    if ( *last_page > group.last_page )
+      *last_page = group.last_page;
+  }
+}
+
+/* item starts with u8g2_dl_head_t, returns 0 if the recording has stopped */
+static uint8_t u8g2_display_list_store(u8g2_t *u8g2, uint8_t type, void *item, uint8_t size, const u8g2_dl_bbox_t *bbox)
+{
+  u8g2_display_list_t *dl = &(u8g2->display_list);
+  u8g2_dl_head_t *head = (u8g2_dl_head_t *)item;
+  u8g2_dl_state_t state;
+  uint16_t pos;
+  uint8_t page;
+  uint8_t *ptr;
+  uint8_t *bucket;
+  
+  u8g2_display_list_get_pages(u8g2, bbox, &(head->first_page), &(head->last_page));
+  if ( head->first_page > head->last_page )
+    return 1;
+  
+  u8g2_display_list_get_state(u8g2, &state);
+  if ( dl->state_pos == U8G2_DL_NO_STATE || memcmp(dl->buf + dl->state_pos + 2, &state, sizeof(u8g2_dl_state_t)) != 0 )
+  {
+    pos = dl->used;
+    ptr = u8g2_display_list_alloc(u8g2, U8G2_DL_STATE, sizeof(u8g2_dl_state_t));
+    if ( ptr == NULL )
+      return 0;
+    memcpy(ptr, &state, sizeof(u8g2_dl_state_t));
+    dl->state_pos = pos;
+  }
+  head->state = dl->state_pos;
+  
+  ptr = u8g2_display_list_alloc(u8g2, type, size);
+  if ( ptr == NULL )
+    return 0;
+  memcpy(ptr, item, size);
+  
+  /* number of items of each page */
+  bucket = dl->buf + dl->bucket_pos;
+  for( page = head->first_page; page <= head->last_page; page++ )
+    u8g2_display_list_set_word(bucket + page*2, u8g2_display_list_get_word(bucket + page*2) + 1);
+  return 1;
+}
+
+/* type is one of U8G2_DL_BOX, U8G2_DL_FRAME, U8G2_DL_LINE, U8G2_DL_HLINE, U8G2_DL_VLINE */
+uint8_t u8g2_display_list_add(u8g2_t *u8g2, uint8_t type, u8g2_uint_t a, u8g2_uint_t b, u8g2_uint_t c, u8g2_uint_t d)
+{
+  u8g2_dl_draw_t item;
+  u8g2_dl_bbox_t bbox;
+  
+  item.a = a;
+  item.b = b;
+  item.c = c;
+  item.d = d;
+  
+  bbox.x0 = a;
+  bbox.y0 = b;
+  bbox.x1 = a;
+  bbox.y1 = b;
+  switch(type)
+  {
+    case U8G2_DL_LINE:
+      if ( c < a )
+	bbox.x0 = c;
+      else
+	bbox.x1 = c;
+      if ( d < b )
+	bbox.y0 = d;
+      else
+	bbox.y1 = d;
+      bbox.x1++;
+      bbox.y1++;
+      break;
+    case U8G2_DL_HLINE:
+      bbox.x1 += c;
+      bbox.y1++;
+      break;
+    case U8G2_DL_VLINE:
+      bbox.x1++;
+      bbox.y1 += c;
+      break;
+    default:
+      bbox.x1 += c;
+      bbox.y1 += d;
+      break;
+  }
+  return u8g2_display_list_store(u8g2, type, &item, sizeof(item), &bbox);
+}
+
+/* type is one of U8G2_DL_XBM, U8G2_DL_XBMP */
+uint8_t u8g2_display_list_add_bitmap(u8g2_t *u8g2, uint8_t type, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap)
+{
+  u8g2_dl_bitmap_t item;
+  u8g2_dl_bbox_t bbox;
+  
+  item.x = x;
+  item.y = y;
+  item.w = w;
+  item.h = h;
+  item.bitmap = bitmap;
+  bbox.x0 = x;
+  bbox.y0 = y;
+  bbox.x1 = x + w;
+  bbox.y1 = y + h;
+  return u8g2_display_list_store(u8g2, type, &item, sizeof(item), &bbox);
+}
+
+/* x and y are the arguments of u8g2_DrawGlyph() */
+uint8_t u8g2_display_list_add_glyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding)
+{
+  u8g2_dl_glyph_t item;
+  u8g2_dl_bbox_t bbox;
+  u8g2_uint_t vref;
+  u8g2_uint_t m;
+  
+  item.x = x;
+  item.y = y;
+  item.encoding = encoding;
+  
+  vref = u8g2->font_calc_vref(u8g2);
+#ifdef U8G2_WITH_FONT_ROTATION
+  if ( u8g2->font_decode.dir != 0 )
+  {
+    /* square around the reference point which contains the font bounding box for any direction */
+    switch(u8g2->font_decode.dir)
+    {
+      case 1:
+	x -= vref;
+	break;
+      case 2:
+	y -= vref;
+	break;
+      case 3:
+	x += vref;
+	break;
+    }
+    m = u8g2->font_info.max_char_width;
+    m += u8g2->font_info.max_char_height;
+    m += u8g2->font_info.x_offset < 0 ? -u8g2->font_info.x_offset : u8g2->font_info.x_offset;
+    m += u8g2->font_info.y_offset < 0 ? -u8g2->font_info.y_offset : u8g2->font_info.y_offset;
+    bbox.x0 = x - m;
+    bbox.y0 = y - m;
+    bbox.x1 = x + m + 1;
+    bbox.y1 = y + m + 1;
+  }
+  else
+#endif
+  {
+    /* font bounding box at the baseline */
+    y += vref;
+    bbox.x0 = x + u8g2->font_info.x_offset;
+    bbox.x1 = bbox.x0 + u8g2->font_info.max_char_width;
+    bbox.y1 = y - u8g2->font_info.y_offset;
+    bbox.y0 = bbox.y1 - u8g2->font_info.max_char_height;
+  }
+  return u8g2_display_list_store(u8g2, U8G2_DL_GLYPH, &item, sizeof(item), &bbox);
+}
+
+/* returns 0 if the recording has stopped */
+uint8_t u8g2_display_list_begin_group(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  u8g2_display_list_t *dl = &(u8g2->display_list);
+  u8g2_dl_group_t item;
+  u8g2_dl_bbox_t bbox;
+  uint16_t pos;
+  uint8_t *ptr;
+  
+  bbox.x0 = x;
+  bbox.y0 = y;
+  bbox.x1 = x + w;
+  bbox.y1 = y + h;
+  u8g2_display_list_get_pages(u8g2, &bbox, &(item.first_page), &(item.last_page));
+  item.parent = dl->group_pos;
+  pos = dl->used;
+  ptr = u8g2_display_list_alloc(u8g2, U8G2_DL_GROUP, sizeof(item));
+  if ( ptr == NULL )
+    return 0;
+  memcpy(ptr, &item, sizeof(item));
+  dl->group_pos = pos;
+  return 1;
+}
+
+void u8g2_display_list_end_group(u8g2_t *u8g2)
+{
+  u8g2_display_list_t *dl = &(u8g2->display_list);
+  u8g2_dl_group_t item;
+  
+  if ( dl->group_pos == U8G2_DL_NO_GROUP )
+    return;
+  memcpy(&item, dl->buf + dl->group_pos + 2, sizeof(item));
+  dl->group_pos = item.parent;
+}
+
+/*===============================================*/
+/* replay */
+
+void u8g2_DrawDisplayList(u8g2_t *u8g2)
+{
+  u8g2_display_list_t *dl = &(u8g2->display_list);
+  uint16_t pos, end, state;
+  uint8_t *bucket;
+  
+  if ( dl->buf == NULL || dl->is_recording || dl->is_valid == 0 )
+    return;
+  
+  bucket = dl->buf + dl->bucket_pos + (u8g2->tile_curr_row / u8g2->tile_buf_height) * 2;
+  pos = u8g2_display_list_get_word(bucket);
+  end = u8g2_display_list_get_word(bucket + 2);
+  state = U8G2_DL_NO_STATE;
+  for( ; pos < end; pos += 2 )
+    u8g2_display_list_draw_item(u8g2, dl->buf + u8g2_display_list_get_word(dl->buf + pos), &state);
+}
+
+#endif /* U8G2_WITH_DISPLAY_LIST */
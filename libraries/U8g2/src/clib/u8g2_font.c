@@ -34,6 +34,7 @@
 */
 
 #include "u8g2.h"
+#include <string.h>
 
 /* size of the font data structure, there is no struct or class... */
 /* this is the size for the new font format */
@@ -396,8 +397,16 @@ void u8g2_font_decode_len(u8g2_t *u8g2, uint8_t len, uint8_t is_foreground)
 
     /* apply rotation */
 #ifdef U8G2_WITH_FONT_ROTATION
-    x = u8g2_add_vector_x(x, lx, ly, decode->dir);
-    y = u8g2_add_vector_y(y, lx, ly, decode->dir);
+    if ( decode->dir == 0 )
+    {
+      x += lx;
+      y += ly;
+    }
+    else
+    {
+      x = u8g2_add_vector_x(x, lx, ly, decode->dir);
+      y = u8g2_add_vector_y(y, lx, ly, decode->dir);
+    }
 #else
     x += lx;
     y += ly;
@@ -586,11 +595,153 @@ int8_t u8g2_font_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
   Return:
     Address of the glyph data or NULL, if the encoding is not avialable in the font.
 */
+#ifdef U8G2_WITH_GLYPH_INDEX
+
+/* fill the glyph position table for the current font, positions are offsets from the start of the font */
+static void u8g2_font_build_glyph_index(u8g2_t *u8g2)
+{
+  u8g2_glyph_index_t *index = &(u8g2->glyph_index);
+  const uint8_t *font = u8g2->font;
+  uint16_t i;
+  uint16_t pos;
+#ifdef U8G2_WITH_UNICODE
+  const uint8_t *glyph;
+  uint16_t *table;
+  uint16_t glyph_cnt;
+  uint16_t capacity;
+  uint16_t step;
+#endif
+  
+  index->font = NULL;
+  index->unicode_cnt = 0;
+  index->unicode_step = 0;
+  if ( index->buf == NULL || index->cnt < U8G2_GLYPH_INDEX_8BIT_CNT || font == NULL )
+    return;
+  
+  for( i = 0; i < U8G2_GLYPH_INDEX_8BIT_CNT; i++ )
+    index->buf[i] = 0;
+  
+  pos = U8G2_FONT_DATA_STRUCT_SIZE;
+  for(;;)
+  {
+    if ( u8x8_pgm_read( font + pos + 1 ) == 0 )
+      break;
+    index->buf[u8x8_pgm_read( font + pos )] = pos;
+    pos += u8x8_pgm_read( font + pos + 1 );
+  }
+  
+#ifdef U8G2_WITH_UNICODE
+  /* count the unicode glyphs, the unicode part is not indexed if a position exceeds 16 bit */
+  glyph_cnt = 0;
+  glyph = font + U8G2_FONT_DATA_STRUCT_SIZE + u8g2->font_info.start_pos_unicode;
+  while( u8x8_pgm_read( glyph ) != 0 || u8x8_pgm_read( glyph + 1 ) != 0 )
+  {
+    if ( (size_t)(glyph - font) > 0x0ffff )
+    {
+      glyph_cnt = 0;
+      break;
+    }
+    glyph_cnt++;
+    glyph += u8x8_pgm_read( glyph + 2 );
+  }
+  
+  capacity = (index->cnt - U8G2_GLYPH_INDEX_8BIT_CNT) / 2;
+  if ( glyph_cnt > 0 && capacity > 0 )
+  {
+    step = (glyph_cnt + capacity - 1) / capacity;
+    if ( step <= 255 )
+    {
+      /* store encoding and position of every step-th glyph */
+      table = index->buf + U8G2_GLYPH_INDEX_8BIT_CNT;
+      glyph = font + U8G2_FONT_DATA_STRUCT_SIZE + u8g2->font_info.start_pos_unicode;
+      for( i = 0; i < glyph_cnt; i++ )
+      {
+	if ( i % step == 0 )
+	{
+	  *table++ = (u8x8_pgm_read( glyph ) << 8) | u8x8_pgm_read( glyph + 1 );
+	  *table++ = glyph - font;
+	  index->unicode_cnt++;
+	}
+	glyph += u8x8_pgm_read( glyph + 2 );
+      }
+      index->unicode_step = step;
+    }
+  }
+#endif /* U8G2_WITH_UNICODE */
+  
+  index->font = font;
+}
+
+void u8g2_SetGlyphIndex(u8g2_t *u8g2, uint16_t *buf, uint16_t cnt)
+{
+  u8g2->glyph_index.buf = buf;
+  u8g2->glyph_index.cnt = cnt;
+  u8g2_font_build_glyph_index(u8g2);
+}
+
+/* same as u8g2_font_get_glyph_data(), requires a valid index */
+static const uint8_t *u8g2_font_get_indexed_glyph_data(u8g2_t *u8g2, uint16_t encoding)
+{
+  u8g2_glyph_index_t *index = &(u8g2->glyph_index);
+  const uint8_t *font = u8g2->font;
+  
+  if ( encoding <= 255 )
+  {
+    if ( index->buf[encoding] == 0 )
+      return NULL;
+    return font + index->buf[encoding] + 2;	/* skip encoding and glyph size */
+  }
+#ifdef U8G2_WITH_UNICODE
+  else
+  {
+    const uint16_t *table = index->buf + U8G2_GLYPH_INDEX_8BIT_CNT;
+    uint16_t lower = 0;
+    uint16_t upper = index->unicode_cnt;
+    uint16_t mid;
+    uint16_t e;
+    uint8_t i;
+    
+    /* find the last table entry with an encoding less or equal to the requested encoding */
+    while( lower < upper )
+    {
+      mid = (lower + upper) / 2;
+      if ( table[mid*2] <= encoding )
+	lower = mid+1;
+      else
+	upper = mid;
+    }
+    if ( lower == 0 )
+      return NULL;
+    
+    /* glyphs are sorted, search the glyphs up to the next table entry */
+    font += table[lower*2-1];
+    for( i = index->unicode_step; i > 0; i-- )
+    {
+      e = u8x8_pgm_read( font );
+      e <<= 8;
+      e |= u8x8_pgm_read( font + 1 );
+      if ( e == encoding )
+	return font+3;	/* skip encoding and glyph size */
+      if ( e == 0 || e > encoding )
+	break;
+      font += u8x8_pgm_read( font + 2 );
+    }
+  }
+#endif /* U8G2_WITH_UNICODE */
+  return NULL;
+}
+
+#endif /* U8G2_WITH_GLYPH_INDEX */
+
 const uint8_t *u8g2_font_get_glyph_data(u8g2_t *u8g2, uint16_t encoding)
 {
   const uint8_t *font = u8g2->font;
   font += U8G2_FONT_DATA_STRUCT_SIZE;
 
+#ifdef U8G2_WITH_GLYPH_INDEX
+  if ( u8g2->glyph_index.font == u8g2->font && (encoding <= 255 || u8g2->glyph_index.unicode_step != 0) )
+    return u8g2_font_get_indexed_glyph_data(u8g2, encoding);
+#endif /* U8G2_WITH_GLYPH_INDEX */
   
   if ( encoding <= 255 )
   {
@@ -660,6 +811,406 @@ const uint8_t *u8g2_font_get_glyph_data(u8g2_t *u8g2, uint16_t encoding)
   return NULL;
 }
 
+/*========================================================================*/
+/* glyph cache */
+
+#ifdef U8G2_WITH_GLYPH_CACHE
+
+/* 
+  A cache entry is followed by the glyph bitmap: glyph height rows 
+  with (width+7)/8 bytes each, the msb is the left most pixel.
+  Entries are stored without gaps, starting at glyph_cache.buf.
+*/
+struct _u8g2_glyph_cache_entry_t
+{
+  const uint8_t *font;
+  uint16_t encoding;
+  uint16_t size;		/* size of the entry including the bitmap */
+  uint16_t last_use;		/* glyph_cache.tick of the last lookup */
+  uint8_t width;
+  uint8_t height;
+  int8_t x;
+  int8_t y;
+  int8_t delta;
+};
+typedef struct _u8g2_glyph_cache_entry_t u8g2_glyph_cache_entry_t;
+
+/* entries start at multiples of the pointer size */
+#define U8G2_GLYPH_CACHE_ALIGN(n) (((n) + sizeof(void *) - 1) & ~(sizeof(void *) - 1))
+
+void u8g2_SetGlyphCache(u8g2_t *u8g2, void *buf, uint16_t size)
+{
+  uint8_t *ptr = (uint8_t *)buf;
+  uint8_t skip = 0;
+  
+  while( ((size_t)ptr & (sizeof(void *) - 1)) != 0 && skip < size )
+  {
+    ptr++;
+    skip++;
+  }
+  
+  u8g2->glyph_cache.buf = buf == NULL ? NULL : ptr;
+  u8g2->glyph_cache.size = size - skip;
+  u8g2->glyph_cache.used = 0;
+  u8g2->glyph_cache.tick = 0;
+  u8g2->glyph_cache.hit_cnt = 0;
+  u8g2->glyph_cache.miss_cnt = 0;
+}
+
+/* remove the least recently used entry, the following entries are moved down */
+static void u8g2_glyph_cache_remove_lru(u8g2_glyph_cache_t *cache)
+{
+  uint16_t pos = 0;
+  uint16_t lru_pos = 0;
+  uint16_t lru_age = 0;
+  uint16_t age;
+  u8g2_glyph_cache_entry_t *entry;
+  
+  while( pos < cache->used )
+  {
+    entry = (u8g2_glyph_cache_entry_t *)(cache->buf + pos);
+    age = cache->tick - entry->last_use;
+    if ( age >= lru_age )
+    {
+      lru_age = age;
+      lru_pos = pos;
+    }
+    pos += entry->size;
+  }
+  
+  entry = (u8g2_glyph_cache_entry_t *)(cache->buf + lru_pos);
+  pos = lru_pos + entry->size;
+  memmove(cache->buf + lru_pos, cache->buf + pos, cache->used - pos);
+  cache->used -= pos - lru_pos;
+}
+
+/* decode the run-length encoded glyph into the bitmap, the bitmap must be cleared */
+static void u8g2_glyph_cache_decode(u8g2_t *u8g2, uint8_t *bitmap, uint8_t w, uint8_t h)
+{
+  uint8_t a, b, cnt;
+  uint16_t lx = 0;		/* lx + a exceeds 255 for wide glyphs */
+  uint8_t ly = 0;
+  uint8_t stride = (w+7)>>3;
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  
+  for(;;)
+  {
+    a = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_0);
+    b = u8g2_font_decode_get_unsigned_bits(decode, u8g2->font_info.bits_per_1);
+    do
+    {
+      /* background pixel are already cleared */
+      lx += a;
+      while( lx >= w )
+      {
+	lx -= w;
+	ly++;
+      }
+      for( cnt = b; cnt > 0 && ly < h; cnt-- )
+      {
+	bitmap[ly*stride + (lx>>3)] |= 128 >> (lx&7);
+	lx++;
+	if ( lx >= w )
+	{
+	  lx = 0;
+	  ly++;
+	}
+      }
+    } while( u8g2_font_decode_get_unsigned_bits(decode, 1) != 0 );
+    
+    if ( ly >= h )
+      break;
+  }
+}
+
+/* returns NULL if the glyph does not exist or is larger than the cache */
+static u8g2_glyph_cache_entry_t *u8g2_glyph_cache_get(u8g2_t *u8g2, uint16_t encoding)
+{
+  u8g2_glyph_cache_t *cache = &(u8g2->glyph_cache);
+  u8g2_glyph_cache_entry_t *entry;
+  const uint8_t *glyph_data;
+  uint16_t pos;
+  uint16_t size;
+  uint8_t w, h;
+  
+  cache->tick++;
+  
+  for( pos = 0; pos < cache->used; pos += entry->size )
+  {
+    entry = (u8g2_glyph_cache_entry_t *)(cache->buf + pos);
+    if ( entry->encoding == encoding && entry->font == u8g2->font )
+    {
+      entry->last_use = cache->tick;
+      cache->hit_cnt++;
+      return entry;
+    }
+  }
+  
+  cache->miss_cnt++;
+  glyph_data = u8g2_font_get_glyph_data(u8g2, encoding);
+  if ( glyph_data == NULL )
+    return NULL;
+  
+  u8g2_font_setup_decode(u8g2, glyph_data);
+  w = u8g2->font_decode.glyph_width;
+  h = u8g2->font_decode.glyph_height;
+  size = U8G2_GLYPH_CACHE_ALIGN(sizeof(u8g2_glyph_cache_entry_t) + h*((w+7)>>3));
+  if ( size > cache->size )
+    return NULL;
+  
+  while( cache->size - cache->used < size )
+    u8g2_glyph_cache_remove_lru(cache);
+  
+  entry = (u8g2_glyph_cache_entry_t *)(cache->buf + cache->used);
+  cache->used += size;
+  
+  entry->font = u8g2->font;
+  entry->encoding = encoding;
+  entry->size = size;
+  entry->last_use = cache->tick;
+  entry->width = w;
+  entry->height = h;
+  entry->x = u8g2_font_decode_get_signed_bits(&(u8g2->font_decode), u8g2->font_info.bits_per_char_x);
+  entry->y = u8g2_font_decode_get_signed_bits(&(u8g2->font_decode), u8g2->font_info.bits_per_char_y);
+  entry->delta = u8g2_font_decode_get_signed_bits(&(u8g2->font_decode), u8g2->font_info.bits_per_delta_x);
+  
+  memset(entry+1, 0, size - sizeof(u8g2_glyph_cache_entry_t));
+  if ( w > 0 )
+    u8g2_glyph_cache_decode(u8g2, (uint8_t *)(entry+1), w, h);
+  return entry;
+}
+
+/* apply foreground and background mask to a byte of the tile buffer, see u8g2_ll_hvline.c */
+static void u8g2_glyph_cache_put(u8g2_t *u8g2, uint8_t *ptr, uint8_t fg_mask, uint8_t bg_mask)
+{
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  
+  if ( decode->fg_color <= 1 )
+    *ptr |= fg_mask;
+  if ( decode->fg_color != 1 )
+    *ptr ^= fg_mask;
+  if ( decode->is_transparent == 0 )
+  {
+    /* bg_color is 0 or 1 */
+    *ptr |= bg_mask;
+    if ( decode->bg_color == 0 )
+      *ptr ^= bg_mask;
+  }
+}
+
+/* u8g2_ll_hvline_horizontal_right_lsb: one glyph row, x is the bit position within the first byte */
+static void u8g2_glyph_cache_row_horizontal(u8g2_t *u8g2, uint8_t *ptr, uint8_t x, const uint8_t *src, uint8_t w)
+{
+  uint8_t fg, bg, valid;
+  
+  while( w > 0 )
+  {
+    valid = 0xff;
+    if ( w < 8 )
+      valid <<= 8-w;
+    fg = *src++;
+    bg = ~fg & valid;
+    
+    u8g2_glyph_cache_put(u8g2, ptr, fg >> x, bg >> x);
+    ptr++;
+    if ( x != 0 && (valid << (8-x)) & 0xff )
+      u8g2_glyph_cache_put(u8g2, ptr, fg << (8-x), bg << (8-x));
+    
+    if ( w < 8 )
+      break;
+    w -= 8;
+  }
+}
+
+/* u8g2_ll_hvline_vertical_top_lsb: one glyph row, mask is the bit of the row */
+static void u8g2_glyph_cache_row_vertical(u8g2_t *u8g2, uint8_t *ptr, uint8_t mask, const uint8_t *src, uint8_t w)
+{
+  uint8_t i;
+  
+  for( i = 0; i < w; i++ )
+  {
+    if ( src[i>>3] & (128 >> (i&7)) )
+      u8g2_glyph_cache_put(u8g2, ptr, mask, 0);
+    else
+      u8g2_glyph_cache_put(u8g2, ptr, 0, mask);
+    ptr++;
+  }
+}
+
+/* draw the bitmap with u8g2_DrawHVLine(), one line for each run of equal pixels */
+static void u8g2_glyph_cache_draw_lines(u8g2_t *u8g2, const u8g2_glyph_cache_entry_t *entry)
+{
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  const uint8_t *src = (const uint8_t *)(entry+1);
+  uint8_t stride = (entry->width+7)>>3;
+  uint8_t lx, ly, len, is_foreground;
+  u8g2_uint_t x, y;
+  
+  for( ly = 0; ly < entry->height; ly++ )
+  {
+    lx = 0;
+    while( lx < entry->width )
+    {
+      is_foreground = (src[lx>>3] >> (7-(lx&7))) & 1;
+      len = 1;
+      while( lx+len < entry->width && ((src[(lx+len)>>3] >> (7-((lx+len)&7))) & 1) == is_foreground )
+	len++;
+      
+      if ( is_foreground || decode->is_transparent == 0 )
+      {
+	x = decode->target_x;
+	y = decode->target_y;
+#ifdef U8G2_WITH_FONT_ROTATION
+	x = u8g2_add_vector_x(x, lx, ly, decode->dir);
+	y = u8g2_add_vector_y(y, lx, ly, decode->dir);
+	u8g2->draw_color = is_foreground ? decode->fg_color : decode->bg_color;
+	u8g2_DrawHVLine(u8g2, x, y, len, decode->dir);
+#else
+	x += lx;
+	y += ly;
+	u8g2->draw_color = is_foreground ? decode->fg_color : decode->bg_color;
+	u8g2_DrawHVLine(u8g2, x, y, len, 0);
+#endif
+      }
+      lx += len;
+    }
+    src += stride;
+  }
+}
+
+/*
+  Description:
+    Draw a glyph from the cache, same as u8g2_font_decode_glyph().
+  Return:
+    Width (delta x advance) of the glyph.
+*/
+static int8_t u8g2_glyph_cache_draw(u8g2_t *u8g2, const u8g2_glyph_cache_entry_t *entry)
+{
+  u8g2_font_decode_t *decode = &(u8g2->font_decode);
+  const uint8_t *src = (const uint8_t *)(entry+1);
+  uint8_t stride = (entry->width+7)>>3;
+  uint8_t tile_width = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  int8_t h = entry->height;
+  uint8_t ly;
+  u8g2_uint_t x, y;
+  uint16_t offset;
+  
+  if ( entry->width == 0 )
+    return entry->delta;
+  
+  decode->fg_color = u8g2->draw_color;
+  decode->bg_color = (decode->fg_color == 0 ? 1 : 0);
+  
+#ifdef U8G2_WITH_FONT_ROTATION
+  decode->target_x = u8g2_add_vector_x(decode->target_x, entry->x, -(h+entry->y), decode->dir);
+  decode->target_y = u8g2_add_vector_y(decode->target_y, entry->x, -(h+entry->y), decode->dir);
+#else
+  decode->target_x += entry->x;
+  decode->target_y -= h+entry->y;
+#endif
+
+#ifdef U8G2_WITH_INTERSECTION
+  {
+    u8g2_uint_t x0, x1, y0, y1;
+    x0 = decode->target_x;
+    y0 = decode->target_y;
+    x1 = x0;
+    y1 = y0;
+    
+#ifdef U8G2_WITH_FONT_ROTATION
+    switch(decode->dir)
+    {
+      case 0:
+	  x1 += entry->width;
+	  y1 += h;
+	  break;
+      case 1:
+	  x0 -= h;
+	  x0++;	/* shift down, because of assymetric boundaries for the interseciton test */
+	  x1++;
+	  y1 += entry->width;
+	  break;
+      case 2:
+	  x0 -= entry->width;
+	  x0++;	/* shift down, because of assymetric boundaries for the interseciton test */
+	  x1++;
+	  y0 -= h;
+	  y0++;	/* shift down, because of assymetric boundaries for the interseciton test */
+	  y1++;
+	  break;	  
+      case 3:
+	  x1 += h;
+	  y0 -= entry->width;
+	  y0++;	/* shift down, because of assymetric boundaries for the interseciton test */
+	  y1++;
+	  break;	  
+    }
+#else /* U8G2_WITH_FONT_ROTATION */
+    x1 += entry->width;
+    y1 += h;      
+#endif
+    
+    if ( u8g2_IsIntersection(u8g2, x0, y0, x1, y1) == 0 ) 
+      return entry->delta;
+  }
+#endif /* U8G2_WITH_INTERSECTION */
+
+  x = decode->target_x;
+  
+  /* copy the bitmap directly into the tile buffer, if the glyph is not */
+  /* rotated and fits horizontally into the buffer */
+  if ( u8g2->cb == U8G2_R0
+#ifdef U8G2_WITH_FONT_ROTATION
+    && decode->dir == 0
+#endif
+    && x < u8g2->pixel_buf_width
+    && (uint16_t)x + entry->width <= u8g2->pixel_buf_width )
+  {
+    if ( u8g2->ll_hvline == u8g2_ll_hvline_horizontal_right_lsb )
+    {
+      for( ly = 0; ly < h; ly++ )
+      {
+	y = decode->target_y + ly;
+	y -= u8g2->tile_curr_row*8;
+	if ( y < u8g2->pixel_buf_height )
+	{
+	  offset = y;
+	  offset *= tile_width;
+	  offset += x>>3;
+	  u8g2_glyph_cache_row_horizontal(u8g2, u8g2->tile_buf_ptr + offset, x&7, src, entry->width);
+	}
+	src += stride;
+      }
+      return entry->delta;
+    }
+    if ( u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb )
+    {
+      for( ly = 0; ly < h; ly++ )
+      {
+	y = decode->target_y + ly;
+	y -= u8g2->tile_curr_row*8;
+	if ( y < u8g2->pixel_buf_height )
+	{
+	  offset = y;
+	  offset &= ~7;
+	  offset *= tile_width;
+	  offset += x;
+	  u8g2_glyph_cache_row_vertical(u8g2, u8g2->tile_buf_ptr + offset, 1 << (y&7), src, entry->width);
+	}
+	src += stride;
+      }
+      return entry->delta;
+    }
+  }
+  
+  u8g2_glyph_cache_draw_lines(u8g2, entry);
+  /* restore the u8g2 draw color, because this is modified by u8g2_glyph_cache_draw_lines() */
+  u8g2->draw_color = decode->fg_color;
+  return entry->delta;
+}
+
+#endif /* U8G2_WITH_GLYPH_CACHE */
+
 static u8g2_uint_t u8g2_font_draw_glyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding)
 {
   u8g2_uint_t dx = 0;
@@ -667,6 +1218,14 @@ static u8g2_uint_t u8g2_font_draw_glyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t
   u8g2->font_decode.target_y = y;
   //u8g2->font_decode.is_transparent = is_transparent; this is already set
   //u8g2->font_decode.dir = dir;
+#ifdef U8G2_WITH_GLYPH_CACHE
+  if ( u8g2->glyph_cache.buf != NULL )
+  {
+    const u8g2_glyph_cache_entry_t *entry = u8g2_glyph_cache_get(u8g2, encoding);
+    if ( entry != NULL )
+      return u8g2_glyph_cache_draw(u8g2, entry);
+  }
+#endif /* U8G2_WITH_GLYPH_CACHE */
   const uint8_t *glyph_data = u8g2_font_get_glyph_data(u8g2, encoding);
   if ( glyph_data != NULL )
   {
@@ -716,6 +1275,11 @@ void u8g2_SetFontMode(u8g2_t *u8g2, uint8_t is_transparent)
 
 u8g2_uint_t u8g2_DrawGlyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding)
 {
+#ifdef U8G2_WITH_DISPLAY_LIST
+  /* the width is required for strings */
+  if ( u8g2_IsRecording(u8g2) && u8g2_display_list_add_glyph(u8g2, x, y, encoding) )
+    return u8g2_GetGlyphWidth(u8g2, encoding);
+#endif /* U8G2_WITH_DISPLAY_LIST */
 #ifdef U8G2_WITH_FONT_ROTATION
   switch(u8g2->font_decode.dir)
   {
@@ -1013,6 +1577,13 @@ void u8g2_SetFont(u8g2_t *u8g2, const uint8_t  *font)
 #endif 
     u8g2->font = font;
     u8g2_read_font_info(&(u8g2->font_info), font);
+#ifdef U8G2_WITH_GLYPH_INDEX
+    u8g2_font_build_glyph_index(u8g2);
+#endif /* U8G2_WITH_GLYPH_INDEX */
+#ifdef U8G2_WITH_STR_WIDTH_CACHE
+    u8g2->str_width_cache.used = 0;
+    u8g2->str_width_cache.next = 0;
+#endif /* U8G2_WITH_STR_WIDTH_CACHE */
     u8g2_UpdateRefHeight(u8g2);
     /* u8g2_SetFontPosBaseline(u8g2); */ /* removed with issue 195 */
   }
@@ -1159,16 +1730,102 @@ static u8g2_uint_t u8g2_calculate_exact_string_width(u8g2_t *u8g2, const char *s
 
 
 
+#ifdef U8G2_WITH_STR_WIDTH_CACHE
+
+void u8g2_SetStrWidthCache(u8g2_t *u8g2, u8g2_str_width_entry_t *buf, uint8_t cnt)
+{
+  u8g2->str_width_cache.buf = buf;
+  u8g2->str_width_cache.cnt = cnt;
+  u8g2->str_width_cache.used = 0;
+  u8g2->str_width_cache.next = 0;
+  u8g2->str_width_cache.hit_cnt = 0;
+  u8g2->str_width_cache.miss_cnt = 0;
+}
+
+/* hash of the bytes up to the end of the string ('\0' or '\n', see u8x8_utf8_next()) */
+static uint16_t u8g2_str_width_hash(const char *str)
+{
+  uint16_t hash = 5381;
+  uint8_t b;
+  for(;;)
+  {
+    b = (uint8_t)*str++;
+    if ( b == 0 || b == '\n' )
+      break;
+    hash = (hash << 5) + hash;
+    hash ^= b;
+  }
+  return hash;
+}
+
+/* returns the width from the cache or measures the string, next_cb must be assigned */
+static u8g2_uint_t u8g2_str_width_cache_get(u8g2_t *u8g2, const char *str, uint8_t kind)
+{
+  u8g2_str_width_cache_t *cache = &(u8g2->str_width_cache);
+  u8g2_str_width_entry_t *entry;
+  uint16_t hash;
+  uint8_t i;
+  u8g2_uint_t w;
+  
+  if ( cache->buf == NULL || cache->cnt == 0 )
+  {
+    if ( kind == U8G2_STR_WIDTH_EXACT )
+      return u8g2_calculate_exact_string_width(u8g2, str);
+    return u8g2_string_width(u8g2, str);
+  }
+  
+  hash = u8g2_str_width_hash(str);
+  entry = cache->buf;
+  for( i = 0; i < cache->used; i++ )
+  {
+    if ( entry->str == str && entry->hash == hash && entry->kind == kind )
+    {
+      cache->hit_cnt++;
+      return entry->width;
+    }
+    entry++;
+  }
+  
+  cache->miss_cnt++;
+  if ( kind == U8G2_STR_WIDTH_EXACT )
+    w = u8g2_calculate_exact_string_width(u8g2, str);
+  else
+    w = u8g2_string_width(u8g2, str);
+  
+  /* replace the oldest entry */
+  entry = cache->buf + cache->next;
+  entry->str = str;
+  entry->hash = hash;
+  entry->width = w;
+  entry->kind = kind;
+  cache->next++;
+  if ( cache->next >= cache->cnt )
+    cache->next = 0;
+  if ( cache->used < cache->cnt )
+    cache->used++;
+  return w;
+}
+
+#endif /* U8G2_WITH_STR_WIDTH_CACHE */
+
 u8g2_uint_t u8g2_GetStrWidth(u8g2_t *u8g2, const char *s)
 {
   u8g2->u8x8.next_cb = u8x8_ascii_next;
+#ifdef U8G2_WITH_STR_WIDTH_CACHE
+  return u8g2_str_width_cache_get(u8g2, s, U8G2_STR_WIDTH_ASCII);
+#else
   return u8g2_string_width(u8g2, s);
+#endif /* U8G2_WITH_STR_WIDTH_CACHE */
 }
 
 u8g2_uint_t u8g2_GetExactStrWidth(u8g2_t *u8g2, const char *s)
 {
   u8g2->u8x8.next_cb = u8x8_ascii_next;
+#ifdef U8G2_WITH_STR_WIDTH_CACHE
+  return u8g2_str_width_cache_get(u8g2, s, U8G2_STR_WIDTH_EXACT);
+#else
   return u8g2_calculate_exact_string_width(u8g2, s);
+#endif /* U8G2_WITH_STR_WIDTH_CACHE */
 }
 
 /*
@@ -1184,7 +1841,11 @@ Bits	from 		to			bytes	Byte 1 		Byte 2 		Byte 3 		Byte 4 		Byte 5 		Byte 6
 u8g2_uint_t u8g2_GetUTF8Width(u8g2_t *u8g2, const char *str)
 {
   u8g2->u8x8.next_cb = u8x8_utf8_next;
+#ifdef U8G2_WITH_STR_WIDTH_CACHE
+  return u8g2_str_width_cache_get(u8g2, str, U8G2_STR_WIDTH_UTF8);
+#else
   return u8g2_string_width(u8g2, str);
+#endif /* U8G2_WITH_STR_WIDTH_CACHE */
 }
 
 
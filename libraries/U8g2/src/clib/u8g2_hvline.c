@@ -61,7 +61,7 @@
   optimized clipping: c is set to 0
 */
 //static uint8_t u8g2_clip_intersection(u8g2_uint_t *ap, u8g2_uint_t *bp, u8g2_uint_t c, u8g2_uint_t d)
-static uint8_t u8g2_clip_intersection(u8g2_uint_t *ap, u8g2_uint_t *bp, u8g2_uint_t d)
+uint8_t u8g2_clip_intersection(u8g2_uint_t *ap, u8g2_uint_t *bp, u8g2_uint_t d)
 {
   u8g2_uint_t a = *ap;
   u8g2_uint_t b = *bp;
@@ -148,7 +148,11 @@ static void u8g2_draw_hv_line_2dir(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u
     len -= y;
   }
   
-  u8g2->ll_hvline(u8g2, x, y, len, dir);
+  /* direct call for the ST7920 buffer layout, avoids the second indirect call */
+  if ( u8g2->ll_hvline == u8g2_ll_hvline_horizontal_right_lsb )
+    u8g2_ll_hvline_horizontal_right_lsb(u8g2, x, y, len, dir);
+  else
+    u8g2->ll_hvline(u8g2, x, y, len, dir);
   //u8g2_draw_low_level_hv_line(u8g2, x, y, len, dir);
 }
 
@@ -209,17 +213,31 @@ void u8g2_draw_hv_line_4dir(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uin
 */
 void u8g2_DrawHVLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
 {
-  
+#ifdef U8G2_WITH_DISPLAY_LIST
+  /* no display list item: stop the recording and draw directly */
+  if ( u8g2_IsRecording(u8g2) )
+    u8g2_display_list_abort(u8g2);
+#endif /* U8G2_WITH_DISPLAY_LIST */
   
   /* Make a call to the callback function (e.g. u8g2_draw_l90_r0). */
   /* The callback may rotate the hv line */
   /* after rotation this will call u8g2_draw_hv_line_4dir() */
+  /* U8G2_R0 does not rotate, call u8g2_draw_hv_line_4dir() directly, so that it can be inlined */
   if ( len != 0 )
-    u8g2->cb->draw_l90(u8g2, x, y, len, dir);
+  {
+    if ( u8g2->cb == U8G2_R0 )
+      u8g2_draw_hv_line_4dir(u8g2, x, y, len, dir);
+    else
+      u8g2->cb->draw_l90(u8g2, x, y, len, dir);
+  }
 }
 
 void u8g2_DrawHLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len)
 {
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2_IsRecording(u8g2) && u8g2_display_list_add(u8g2, U8G2_DL_HLINE, x, y, len, 0) )
+    return;
+#endif /* U8G2_WITH_DISPLAY_LIST */
 #ifdef U8G2_WITH_INTERSECTION
   if ( u8g2_IsIntersection(u8g2, x, y, x+len, y+1) == 0 ) 
     return;
@@ -229,6 +247,10 @@ void u8g2_DrawHLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len)
 
 void u8g2_DrawVLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len)
 {
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2_IsRecording(u8g2) && u8g2_display_list_add(u8g2, U8G2_DL_VLINE, x, y, len, 0) )
+    return;
+#endif /* U8G2_WITH_DISPLAY_LIST */
 #ifdef U8G2_WITH_INTERSECTION
   if ( u8g2_IsIntersection(u8g2, x, y, x+1, y+len) == 0 ) 
     return;
@@ -251,6 +273,72 @@ void u8g2_DrawPixel(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y)
   u8g2_DrawHVLine(u8g2, x, y, 1, 0);
 }
 
+#ifdef U8G2_WITH_INTERSECTION
+/* draw the part of a..e (both included) which is inside c..d (d excluded) */
+static void u8g2_draw_pixel_span_part(u8g2_t *u8g2, u8g2_uint_t a, u8g2_uint_t e, u8g2_uint_t c, u8g2_uint_t d, u8g2_uint_t v, uint8_t dir)
+{
+  if ( a < c )
+    a = c;
+  if ( a >= d )
+    return;
+  if ( e >= d )
+    e = d-1;
+  if ( a > e )
+    return;
+  e -= a;
+  e++;
+  if ( dir == 0 )
+    u8g2_DrawHVLine(u8g2, a, v, e, 0);
+  else
+    u8g2_DrawHVLine(u8g2, v, a, e, 1);
+}
+#endif /* U8G2_WITH_INTERSECTION */
+
+/*
+  Draws the same pixels as len calls of u8g2_DrawPixel(): a horizontal 
+  (dir = 0) or vertical (dir = 1) line, clipped against the user window.
+  The line may start left or above of the window (x or y wrapped around).
+  Used by the line and circle procedures to draw a run of pixels at once.
+  len must not be 0.
+*/
+void u8g2_draw_pixel_span(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+#ifdef U8G2_WITH_INTERSECTION
+  u8g2_uint_t a, e, v, c, d;
+  
+  if ( dir == 0 )
+  {
+    if ( y < u8g2->user_y0 || y >= u8g2->user_y1 )
+      return;
+    a = x;
+    v = y;
+    c = u8g2->user_x0;
+    d = u8g2->user_x1;
+  }
+  else
+  {
+    if ( x < u8g2->user_x0 || x >= u8g2->user_x1 )
+      return;
+    a = y;
+    v = x;
+    c = u8g2->user_y0;
+    d = u8g2->user_y1;
+  }
+  e = a;
+  e += len;
+  e--;
+  if ( e < a )
+  {
+    /* wrapped around: a..max and 0..e */
+    u8g2_draw_pixel_span_part(u8g2, 0, e, c, d, v, dir);
+    e = (u8g2_uint_t)-1;
+  }
+  u8g2_draw_pixel_span_part(u8g2, a, e, c, d, v, dir);
+#else
+  u8g2_DrawHVLine(u8g2, x, y, len, dir);
+#endif /* U8G2_WITH_INTERSECTION */
+}
+
 /*
   Assign the draw color for all drawing functions.
   color may be 0 or 1. The actual color is defined by the display.
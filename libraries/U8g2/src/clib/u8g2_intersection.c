@@ -174,3 +174,28 @@ uint8_t u8g2_IsIntersection(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_u
 
 #endif /* U8G2_WITH_INTERSECTION */
 
+
+/*
+  Begin a group of draw procedures inside of the box x, y, w, h. 
+  Returns 0 if the group can be skipped, u8g2_EndGroup() is then not called.
+*/
+uint8_t u8g2_BeginGroup(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2_IsRecording(u8g2) && u8g2_display_list_begin_group(u8g2, x, y, w, h) )
+    return 1;
+#endif /* U8G2_WITH_DISPLAY_LIST */
+#ifdef U8G2_WITH_INTERSECTION
+  return u8g2_IsIntersection(u8g2, x, y, x+w, y+h);
+#else
+  return 1;
+#endif /* U8G2_WITH_INTERSECTION */
+}
+
+void u8g2_EndGroup(u8g2_t *u8g2)
+{
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2_IsRecording(u8g2) )
+    u8g2_display_list_end_group(u8g2);
+#endif /* U8G2_WITH_DISPLAY_LIST */
+}
@@ -43,6 +43,111 @@ uint8_t u8g2_GetNullKerning(u8g2_t *u8g2, uint16_t e1, uint16_t e2)
 }
 */
 
+#ifdef U8G2_WITH_KERNING_INDEX
+
+/* add a pair to the index, returns 0 if buf is full */
+static uint8_t u8g2_kerning_index_add(u8g2_kerning_index_t *index, uint16_t e1, uint16_t e2, uint16_t value)
+{
+  uint16_t *p;
+  if ( index->pair_cnt >= index->cnt / 3 )
+    return 0;
+  p = index->buf + index->pair_cnt*3;
+  p[0] = e1;
+  p[1] = e2;
+  p[2] = value;
+  index->pair_cnt++;
+  return 1;
+}
+
+/* sort the pairs by e1 and e2, pairs with the same encodings keep their order */
+static void u8g2_kerning_index_sort(u8g2_kerning_index_t *index)
+{
+  uint16_t *buf = index->buf;
+  uint16_t i, j;
+  uint16_t e1, e2, value;
+  
+  /* insertion sort: tables from the font converter are already sorted */
+  for( i = 1; i < index->pair_cnt; i++ )
+  {
+    e1 = buf[i*3];
+    e2 = buf[i*3+1];
+    value = buf[i*3+2];
+    j = i;
+    while( j > 0 && (buf[j*3-3] > e1 || (buf[j*3-3] == e1 && buf[j*3-2] > e2)) )
+    {
+      buf[j*3] = buf[j*3-3];
+      buf[j*3+1] = buf[j*3-2];
+      buf[j*3+2] = buf[j*3-1];
+      j--;
+    }
+    buf[j*3] = e1;
+    buf[j*3+1] = e2;
+    buf[j*3+2] = value;
+  }
+}
+
+static void u8g2_kerning_index_build_table(u8g2_kerning_index_t *index, const uint16_t *kt)
+{
+  while( kt[0] != 0x0ffff )
+  {
+    if ( u8g2_kerning_index_add(index, kt[0], kt[1], kt[2]) == 0 )
+      return;
+    kt += 3;
+  }
+  index->is_valid = 1;
+}
+
+/* returns the index for the pair list kt, rebuilds the index if required */
+static u8g2_kerning_index_t *u8g2_get_kerning_index(u8g2_t *u8g2, const uint16_t *kt)
+{
+  u8g2_kerning_index_t *index = &(u8g2->kerning_index);
+  
+  if ( index->buf == NULL )
+    return NULL;
+  if ( index->table != kt )
+  {
+    index->table = kt;
+    index->pair_cnt = 0;
+    index->is_valid = 0;
+    u8g2_kerning_index_build_table(index, kt);
+    if ( index->is_valid )
+      u8g2_kerning_index_sort(index);
+  }
+  if ( index->is_valid == 0 )
+    return NULL;
+  return index;
+}
+
+/* binary search for the first pair e1/e2 */
+static uint8_t u8g2_kerning_index_find(u8g2_kerning_index_t *index, uint16_t e1, uint16_t e2)
+{
+  const uint16_t *buf = index->buf;
+  uint16_t lower = 0;
+  uint16_t upper = index->pair_cnt;
+  uint16_t mid;
+  
+  while( lower < upper )
+  {
+    mid = (lower + upper) / 2;
+    if ( buf[mid*3] < e1 || (buf[mid*3] == e1 && buf[mid*3+1] < e2) )
+      lower = mid+1;
+    else
+      upper = mid;
+  }
+  if ( lower < index->pair_cnt && buf[lower*3] == e1 && buf[lower*3+1] == e2 )
+    return buf[lower*3+2];
+  return 0;
+}
+
+void u8g2_SetKerningIndex(u8g2_t *u8g2, uint16_t *buf, uint16_t cnt)
+{
+  u8g2->kerning_index.buf = buf;
+  u8g2->kerning_index.cnt = cnt;
+  u8g2->kerning_index.table = NULL;
+}
+
+#endif /* U8G2_WITH_KERNING_INDEX */
+
 /* this function is used as "u8g2_get_kerning_cb" */
 uint8_t u8g2_GetKerning(U8X8_UNUSED u8g2_t *u8g2, u8g2_kerning_t *kerning, uint16_t e1, uint16_t e2)
 {
@@ -75,12 +180,20 @@ uint8_t u8g2_GetKerning(U8X8_UNUSED u8g2_t *u8g2, u8g2_kerning_t *kerning, uint1
   return kerning->kerning_values[i2];
 }
 
-uint8_t u8g2_GetKerningByTable(U8X8_UNUSED u8g2_t *u8g2, const uint16_t *kt, uint16_t e1, uint16_t e2)
+uint8_t u8g2_GetKerningByTable(u8g2_t *u8g2, const uint16_t *kt, uint16_t e1, uint16_t e2)
 {
   uint16_t i;
+#ifdef U8G2_WITH_KERNING_INDEX
+  u8g2_kerning_index_t *index;
+#endif /* U8G2_WITH_KERNING_INDEX */
   i = 0;
   if ( kt == NULL )
     return 0;
+#ifdef U8G2_WITH_KERNING_INDEX
+  index = u8g2_get_kerning_index(u8g2, kt);
+  if ( index != NULL )
+    return u8g2_kerning_index_find(index, e1, e2);
+#endif /* U8G2_WITH_KERNING_INDEX */
   for(;;)
   {
     if ( kt[i] == 0x0ffff )
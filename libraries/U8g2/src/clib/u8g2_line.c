@@ -36,17 +36,29 @@
 #include "u8g2.h"
 
 
+/*
+  Bresenham line, drawn as runs: a shallow line is a sequence of horizontal 
+  runs, a steep line a sequence of vertical runs. Each run is clipped and 
+  drawn with one call to u8g2_draw_pixel_span().
+*/
 void u8g2_DrawLine(u8g2_t *u8g2, u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2, u8g2_uint_t y2)
 {
   u8g2_uint_t tmp;
   u8g2_uint_t x,y;
   u8g2_uint_t dx, dy;
+  u8g2_uint_t xs;
+#ifdef U8G2_WITH_INTERSECTION
+  u8g2_uint_t ya, yb;
+#endif
   u8g2_int_t err;
   u8g2_int_t ystep;
 
   uint8_t swapxy = 0;
   
-  /* no intersection check at the moment, should be added... */
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2_IsRecording(u8g2) && u8g2_display_list_add(u8g2, U8G2_DL_LINE, x1, y1, x2, y2) )
+    return;
+#endif /* U8G2_WITH_DISPLAY_LIST */
 
   if ( x1 > x2 ) dx = x1-x2; else dx = x2-x1;
   if ( y1 > y2 ) dy = y1-y2; else dy = y2-y1;
@@ -63,6 +75,33 @@ void u8g2_DrawLine(u8g2_t *u8g2, u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2,
     tmp = x1; x1 =x2; x2 = tmp;
     tmp = y1; y1 =y2; y2 = tmp;
   }
+  
+#ifdef U8G2_WITH_INTERSECTION
+  /* 
+    the line is inside the box of the end points, check it once. 
+    This is not true if dx does not fit into err (dx >= 128 in 8 bit mode, 
+    e.g. a line which starts left of the display): err overflows and the 
+    line leaves the box, so it is drawn and clipped like before.
+  */
+  if ( dx <= (((u8g2_uint_t)-1) >> 1) )
+  {
+    if ( y1 > y2 ) { ya = y2; yb = y1; } else { ya = y1; yb = y2; }
+    yb++;
+    tmp = x2;
+    tmp++;
+    if ( swapxy == 0 )
+    {
+      if ( u8g2_IsIntersection(u8g2, x1, ya, tmp, yb) == 0 ) 
+	return;
+    }
+    else
+    {
+      if ( u8g2_IsIntersection(u8g2, ya, x1, yb, tmp) == 0 ) 
+	return;
+    }
+  }
+#endif /* U8G2_WITH_INTERSECTION */
+  
   err = dx >> 1;
   if ( y2 > y1 ) ystep = 1; else ystep = -1;
   y = y1;
@@ -75,13 +114,22 @@ void u8g2_DrawLine(u8g2_t *u8g2, u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2,
     x2--;
 #endif
 
+  xs = x1;
   for( x = x1; x <= x2; x++ )
   {
-    if ( swapxy == 0 ) 
-      u8g2_DrawPixel(u8g2, x, y); 
-    else 
-      u8g2_DrawPixel(u8g2, y, x); 
     err -= (uint8_t)dy;
+    if ( err < 0 || x == x2 ) 
+    {
+      /* end of the run xs..x at y */
+      tmp = x;
+      tmp -= xs;
+      tmp++;
+      if ( swapxy == 0 )
+	u8g2_draw_pixel_span(u8g2, xs, y, tmp, 0);
+      else 
+	u8g2_draw_pixel_span(u8g2, y, xs, tmp, 1);
+      xs = x+1;
+    }
     if ( err < 0 ) 
     {
       y += (u8g2_uint_t)ystep;
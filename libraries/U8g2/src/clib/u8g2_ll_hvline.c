@@ -58,6 +58,77 @@
     UC1701    
 */
 
+#ifdef U8G2_WITH_WORD_SPAN
+/* the tile buffer is accessed as uint8_t and as uint32_t */
+typedef uint32_t __attribute__((__may_alias__)) u8g2_span_word_t;
+#endif
+
+/*
+  x,y		Left position of the span within the local buffer (not the display!)
+  len		number of bytes, len must not be 0
+  mask		bits of the bytes, which should be modified, bit 0 is the top line of the tile row
+  asumption: 
+    all clipping done
+*/
+void u8g2_ll_span_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t mask)
+{
+  uint16_t offset;
+  uint8_t *ptr;
+  uint8_t or_mask, xor_mask;
+
+  or_mask = 0;
+  xor_mask = 0;
+  if ( u8g2->draw_color <= 1 )
+    or_mask  = mask;
+  if ( u8g2->draw_color != 1 )
+    xor_mask = mask;
+
+  offset = y;		/* y might be 8 or 16 bit, but we need 16 bit, so use a 16 bit variable */
+  offset &= ~7;
+  offset *= u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  ptr = u8g2->tile_buf_ptr;
+  ptr += offset;
+  ptr += x;
+  
+#ifdef U8G2_WITH_WORD_SPAN
+  /* head bytes up to the next word boundary, then four bytes per access */
+  if ( len >= 2*sizeof(u8g2_span_word_t) )
+  {
+    u8g2_span_word_t *wptr;
+    u8g2_span_word_t or_word, xor_word;
+    
+    while( ((size_t)ptr & (sizeof(u8g2_span_word_t)-1)) != 0 )
+    {
+      *ptr |= or_mask;
+      *ptr ^= xor_mask;
+      ptr++;
+      len--;
+    }
+    
+    or_word = or_mask * (u8g2_span_word_t)0x01010101UL;
+    xor_word = xor_mask * (u8g2_span_word_t)0x01010101UL;
+    wptr = (u8g2_span_word_t *)ptr;
+    do
+    {
+      *wptr |= or_word;
+      *wptr ^= xor_word;
+      wptr++;
+      len -= sizeof(u8g2_span_word_t);
+    } while( len >= sizeof(u8g2_span_word_t) );
+    ptr = (uint8_t *)wptr;
+  }
+#endif /* U8G2_WITH_WORD_SPAN */
+  
+  /* tail bytes */
+  while( len != 0 )
+  {
+    *ptr |= or_mask;
+    *ptr ^= xor_mask;
+    ptr++;
+    len--;
+  }
+}
+
 
 #ifdef U8G2_HVLINE_SPEED_OPTIMIZATION
 
@@ -104,6 +175,13 @@ void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
   
   if ( dir == 0 )
   {
+#ifdef U8G2_WITH_WORD_SPAN
+    if ( len >= 2*sizeof(u8g2_span_word_t) )
+    {
+      u8g2_ll_span_vertical_top_lsb(u8g2, x, y, len, mask);
+      return;
+    }
+#endif /* U8G2_WITH_WORD_SPAN */
       do
       {
 	*ptr |= or_mask;
@@ -252,25 +330,33 @@ void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_
   
   if ( dir == 0 )
   {
-      
-    do
+    /* one access for all pixels of the line within a byte */
+    mask = 0xff;
+    mask >>= bit_pos;
+    for(;;)
     {
-
+      if ( len < 8 - bit_pos )
+      {
+	/* remove the pixels right of the line */
+	mask &= (uint8_t)(0xff << (8 - bit_pos - len));
+	len = 0;
+      }
+      else
+      {
+	len -= 8 - bit_pos;
+      }
+      
       if ( u8g2->draw_color <= 1 )
 	*ptr |= mask;
       if ( u8g2->draw_color != 1 )
 	*ptr ^= mask;
       
-      mask >>= 1;
-      if ( mask == 0 )
-      {
-	mask = 128;
-        ptr++;
-      }
-      
-      //x++;
-      len--;
-    } while( len != 0 );
+      if ( len == 0 )
+	break;
+      ptr++;
+      bit_pos = 0;
+      mask = 0xff;
+    }
   }
   else
   {
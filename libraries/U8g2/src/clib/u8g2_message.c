@@ -95,28 +95,31 @@ uint8_t u8g2_draw_button_line(u8g2_t *u8g2, u8g2_uint_t y, u8g2_uint_t w, uint8_
     u8g2_SetFontDirection(u8g2, 0);
     u8g2_SetFontPosBaseline(u8g2);
 */
-
-uint8_t u8g2_UserInterfaceMessage(u8g2_t *u8g2, const char *title1, const char *title2, const char *title3, const char *buttons)
+void u8g2_UserInterfaceMessageStart(u8g2_t *u8g2, u8g2_ui_message_t *ui, const char *title1, const char *title2, const char *title3, const char *buttons)
 {
   uint8_t height;
-  uint8_t line_height;
   u8g2_uint_t pixel_height;
-  u8g2_uint_t y, yy;
-	
-  uint8_t cursor = 0;
-  uint8_t button_cnt;
-  uint8_t event;
+  u8g2_uint_t y;
 	
+  ui->title1 = title1;
+  ui->title2 = title2;
+  ui->title3 = title3;
+  ui->buttons = buttons;
+  ui->button_cnt = u8x8_GetStringLineCnt(buttons);
+  ui->cursor = 0;
+  ui->drawn_cursor = 255;
+  ui->is_done = 0;
+  ui->result = 0;
+  
   /* only horizontal strings are supported, so force this here */
   u8g2_SetFontDirection(u8g2, 0);
 
   /* force baseline position */
   u8g2_SetFontPosBaseline(u8g2);
 	
-	
   /* calculate line height */
-  line_height = u8g2_GetAscent(u8g2);
-  line_height -= u8g2_GetDescent(u8g2);
+  ui->line_height = u8g2_GetAscent(u8g2);
+  ui->line_height -= u8g2_GetDescent(u8g2);
 
   /* calculate overall height of the message box in lines*/
   height = 1;	/* button line */
@@ -127,7 +130,7 @@ uint8_t u8g2_UserInterfaceMessage(u8g2_t *u8g2, const char *title1, const char *
   
   /* calculate the height in pixel */
   pixel_height = height;
-  pixel_height *= line_height;
+  pixel_height *= ui->line_height;
   
   /* ... and add the space between the text and the buttons */
   pixel_height +=SPACE_BETWEEN_TEXT_AND_BUTTONS_IN_PIXEL;
@@ -141,57 +144,138 @@ uint8_t u8g2_UserInterfaceMessage(u8g2_t *u8g2, const char *title1, const char *
     y /= 2;
   }
   y += u8g2_GetAscent(u8g2);
+  ui->y = y;
+  
+  /* the button line follows the text lines */
+  height--;
+  y += height * ui->line_height;
+  y += SPACE_BETWEEN_TEXT_AND_BUTTONS_IN_PIXEL;
+  ui->button_y = y;
+}
+
+/* returns 1 if the event has changed the message box */
+uint8_t u8g2_UserInterfaceMessageEvent(U8X8_UNUSED u8g2_t *u8g2, u8g2_ui_message_t *ui, uint8_t event)
+{
+  if ( ui->is_done )
+    return 0;
+  if ( event == U8X8_MSG_GPIO_MENU_SELECT )
+  {
+    ui->result = ui->cursor+1;
+    ui->is_done = 1;
+  }
+  else if ( event == U8X8_MSG_GPIO_MENU_HOME )
+  {
+    ui->result = 0;
+    ui->is_done = 1;
+  }
+  else if ( event == U8X8_MSG_GPIO_MENU_NEXT || event == U8X8_MSG_GPIO_MENU_DOWN )
+  {
+    ui->cursor++;
+    if ( ui->cursor >= ui->button_cnt )
+      ui->cursor = 0;
+  }
+  else if ( event == U8X8_MSG_GPIO_MENU_PREV || event == U8X8_MSG_GPIO_MENU_UP )
+  {
+    if ( ui->cursor == 0 )
+      ui->cursor = ui->button_cnt;
+    ui->cursor--;
+  }
+  else
+  {
+    return 0;
+  }
+  return 1;
+}
 
+void u8g2_DrawUserInterfaceMessage(u8g2_t *u8g2, u8g2_ui_message_t *ui)
+{
+  u8g2_uint_t yy;
+  
+  u8g2_SetFontDirection(u8g2, 0);
+  u8g2_SetFontPosBaseline(u8g2);
+  
+  yy = ui->y;
+  /* draw message box */
+  
+  yy += u8g2_DrawUTF8Lines(u8g2, 0, yy, u8g2_GetDisplayWidth(u8g2), ui->line_height, ui->title1);
+  if ( ui->title2 != NULL )
+  {
+    u8g2_DrawUTF8Line(u8g2, 0, yy, u8g2_GetDisplayWidth(u8g2), ui->title2, 0, 0);
+    yy+=ui->line_height;
+  }
+  u8g2_DrawUTF8Lines(u8g2, 0, yy, u8g2_GetDisplayWidth(u8g2), ui->line_height, ui->title3);
+
+  u8g2_draw_button_line(u8g2, ui->button_y, u8g2_GetDisplayWidth(u8g2), ui->cursor, ui->buttons);
+  ui->drawn_cursor = ui->cursor;
+}
+
+/* 
+  clear h rows for the button line with baseline y, starting with the button border above the text
+  the top row is limited to the upper display border
+*/
+static void u8g2_clear_button_line(u8g2_t *u8g2, u8g2_uint_t y, u8g2_uint_t h)
+{
+  u8g2_uint_t top = u8g2_GetAscent(u8g2) + 1;
+  
+  if ( y > top )
+  {
+    top = y - top;
+  }
+  else
+  {
+    h -= top - y;
+    top = 0;
+  }
+  u8g2_SetDrawColor(u8g2, 0);
+  u8g2_DrawBox(u8g2, 0, top, u8g2_GetDisplayWidth(u8g2), h);
+  u8g2_SetDrawColor(u8g2, 1);
+}
+
+/* full buffer only: redraw the button line if the cursor has changed, returns 0 if nothing has changed */
+uint8_t u8g2_UpdateUserInterfaceMessage(u8g2_t *u8g2, u8g2_ui_message_t *ui)
+{
+  if ( ui->drawn_cursor == 255 )
+  {
+    u8g2_ClearBuffer(u8g2);
+    u8g2_DrawUserInterfaceMessage(u8g2, ui);
+    return 1;
+  }
+  if ( ui->drawn_cursor == ui->cursor )
+    return 0;
+  
+  u8g2_SetFontDirection(u8g2, 0);
+  u8g2_SetFontPosBaseline(u8g2);
+  /* buttons have a border of one pixel */
+  u8g2_clear_button_line(u8g2, ui->button_y, ui->line_height+2);
+  u8g2_draw_button_line(u8g2, ui->button_y, u8g2_GetDisplayWidth(u8g2), ui->cursor, ui->buttons);
+  ui->drawn_cursor = ui->cursor;
+  return 1;
+}
+
+uint8_t u8g2_UserInterfaceMessage(u8g2_t *u8g2, const char *title1, const char *title2, const char *title3, const char *buttons)
+{
+  u8g2_ui_message_t ui;
+  
+  u8g2_UserInterfaceMessageStart(u8g2, &ui, title1, title2, title3, buttons);
   
   for(;;)
   {
       u8g2_FirstPage(u8g2);
       do
       {
-	  yy = y;
-	  /* draw message box */
-	  
-	  yy += u8g2_DrawUTF8Lines(u8g2, 0, yy, u8g2_GetDisplayWidth(u8g2), line_height, title1);
-	  if ( title2 != NULL )
-	  {
-	    u8g2_DrawUTF8Line(u8g2, 0, yy, u8g2_GetDisplayWidth(u8g2), title2, 0, 0);
-	    yy+=line_height;
-	  }
-	  yy += u8g2_DrawUTF8Lines(u8g2, 0, yy, u8g2_GetDisplayWidth(u8g2), line_height, title3);
-	  yy += SPACE_BETWEEN_TEXT_AND_BUTTONS_IN_PIXEL;
-
-	  button_cnt = u8g2_draw_button_line(u8g2, yy, u8g2_GetDisplayWidth(u8g2), cursor, buttons);
-	  
+	  u8g2_DrawUserInterfaceMessage(u8g2, &ui);
       } while( u8g2_NextPage(u8g2) );
 
 #ifdef U8G2_REF_MAN_PIC
       return 0;
 #endif
 	  
-      for(;;)
-      {
-	    event = u8x8_GetMenuEvent(u8g2_GetU8x8(u8g2));
-	    if ( event == U8X8_MSG_GPIO_MENU_SELECT )
-	      return cursor+1;
-	    else if ( event == U8X8_MSG_GPIO_MENU_HOME )
-	      return 0;
-	    else if ( event == U8X8_MSG_GPIO_MENU_NEXT || event == U8X8_MSG_GPIO_MENU_DOWN )
-	    {
-	      cursor++;
-	      if ( cursor >= button_cnt )
-		cursor = 0;
-	      break;
-	    }
-	    else if ( event == U8X8_MSG_GPIO_MENU_PREV || event == U8X8_MSG_GPIO_MENU_UP )
-	    {
-	      if ( cursor == 0 )
-		cursor = button_cnt;
-	      cursor--;
-	      break;
-	    }    
-      }
+      /* wait for an event which changes the message box */
+      while( u8g2_UserInterfaceMessageEvent(u8g2, &ui, u8x8_GetMenuEvent(u8g2_GetU8x8(u8g2))) == 0 )
+	;
+      if ( u8g2_IsUserInterfaceDone(&ui) )
+	return u8g2_GetUserInterfaceResult(&ui);
   }
   /* never reached */
   //return 0;
 }
-
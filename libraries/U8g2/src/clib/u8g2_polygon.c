@@ -13,207 +13,208 @@
 /*===========================================*/
 /* local definitions */
 
-typedef int16_t pg_word_t;
-
-
-struct pg_point_struct
-{
-  pg_word_t x;
-  pg_word_t y;
-};
-
-typedef struct _pg_struct pg_struct;	/* forward declaration */
-
-struct pg_edge_struct
-{
-  pg_word_t x_direction;	/* 1, if x2 is greater than x1, -1 otherwise */
-  pg_word_t height;
-  pg_word_t current_x_offset;
-  pg_word_t error_offset;
-  
-  /* --- line loop --- */
-  pg_word_t current_y;
-  pg_word_t max_y;
-  pg_word_t current_x;
-  pg_word_t error;
-
-  /* --- outer loop --- */
-  uint8_t (*next_idx_fn)(pg_struct *pg, uint8_t i);
-  uint8_t curr_idx;
-};
-
-/* maximum number of points in the polygon */
-/* can be redefined, but highest possible value is 254 */
-#define PG_MAX_POINTS 6
-
-/* index numbers for the pge structures below */
+/* index numbers for the sides of the polygon */
 #define PG_LEFT 0
 #define PG_RIGHT 1
 
 
-struct _pg_struct
-{
-  struct pg_point_struct list[PG_MAX_POINTS];
-  uint8_t cnt;
-  uint8_t is_min_y_not_flat;
-  pg_word_t total_scan_line_cnt;
-  struct pg_edge_struct pge[2];	/* left and right line draw structures */
-};
-
-
 /*===========================================*/
 /* procedures, which should not be inlined (save as much flash ROM as possible */
 
 #define PG_NOINLINE U8G2_NOINLINE
 
-static uint8_t pge_Next(struct pg_edge_struct *pge) PG_NOINLINE;
-static uint8_t pg_inc(pg_struct *pg, uint8_t i) PG_NOINLINE;
-static uint8_t pg_dec(pg_struct *pg, uint8_t i) PG_NOINLINE;
-static void pg_expand_min_y(pg_struct *pg, pg_word_t min_y, uint8_t pge_idx) PG_NOINLINE;
-static void pg_line_init(pg_struct * const pg, uint8_t pge_index) PG_NOINLINE;
+static uint8_t pg_next_idx(u8g2_polygon_t *pg, uint8_t i, uint8_t side) PG_NOINLINE;
+static void pg_side_seek(u8g2_polygon_t *pg, uint8_t side, int16_t y) PG_NOINLINE;
+static void pg_side_next(u8g2_polygon_t *pg, uint8_t side, int16_t y) PG_NOINLINE;
 
 /*===========================================*/
-/* line draw algorithm */
+/* edge table */
 
-static uint8_t pge_Next(struct pg_edge_struct *pge)
+/* the left side goes backward through the points, the right side forward */
+static uint8_t pg_next_idx(u8g2_polygon_t *pg, uint8_t i, uint8_t side)
 {
-  if ( pge->current_y >= pge->max_y )
-    return 0;
-  
-  pge->current_x += pge->current_x_offset;
-  pge->error += pge->error_offset;
-  if ( pge->error > 0 )
+  if ( side == PG_LEFT )
   {
-    pge->current_x += pge->x_direction;
-    pge->error -= pge->height;
-  }  
-  
-  pge->current_y++;
-  return 1;
+    i--;
+    if ( i >= pg->cnt )
+      i = pg->cnt-1;
+  }
+  else
+  {
+    i++;
+    if ( i >= pg->cnt )
+      i = 0;
+  }
+  return i;
 }
 
 /* assumes y2 > y1 */
-static void pge_Init(struct pg_edge_struct *pge, pg_word_t x1, pg_word_t y1, pg_word_t x2, pg_word_t y2)
+static void pg_edge_init(u8g2_polygon_edge_t *edge, int16_t x1, int16_t y1, int16_t x2, int16_t y2)
 {
-  pg_word_t dx = x2 - x1;
-  pg_word_t width;
+  int16_t dx = x2 - x1;
+  int16_t width;
 
-  pge->height = y2 - y1;
-  pge->max_y = y2;
-  pge->current_y = y1;
-  pge->current_x = x1;
+  edge->x1 = x1;
+  edge->y1 = y1;
+  edge->y2 = y2;
+  edge->height = y2 - y1;
 
   if ( dx >= 0 )
   {
-    pge->x_direction = 1;
+    edge->x_direction = 1;
     width = dx;
-    pge->error = 0;
+    edge->error_start = 0;
   }
   else
   {
-    pge->x_direction = -1;
+    edge->x_direction = -1;
     width = -dx;
-    pge->error = 1 - pge->height;
+    edge->error_start = 1 - edge->height;
   }
   
-  pge->current_x_offset = dx / pge->height;
-  pge->error_offset = width % pge->height;
-}
-
-/*===========================================*/
-/* convex polygon algorithm */
-
-static uint8_t pg_inc(pg_struct *pg, uint8_t i)
-{
-    i++;
-    if ( i >= pg->cnt )
-      i = 0;
-    return i;
-}
-
-static uint8_t pg_dec(pg_struct *pg, uint8_t i)
-{
-    i--;
-    if ( i >= pg->cnt )
-      i = pg->cnt-1;
-    return i;
+  edge->x_offset = dx / edge->height;
+  edge->error_offset = width % edge->height;
 }
 
-static void pg_expand_min_y(pg_struct *pg, pg_word_t min_y, uint8_t pge_idx)
+/* add the edges from the upper point idx down to the lowest point of the side */
+static uint8_t pg_add_side(u8g2_polygon_t *pg, uint8_t idx, uint8_t side, uint8_t edge_cnt)
 {
-  uint8_t i = pg->pge[pge_idx].curr_idx;
-  for(;;)
+  uint8_t i, next;
+  
+  for( i = 1; i < pg->cnt; i++ )
   {
-    i = pg->pge[pge_idx].next_idx_fn(pg, i);
-    if ( pg->list[i].y != min_y )
-      break;	
-    pg->pge[pge_idx].curr_idx = i;
+    next = pg_next_idx(pg, idx, side);
+    if ( pg->y[next] < pg->y[idx] )
+      break;		/* lowest point reached */
+    /* horizontal edges do not have a scan line */
+    if ( pg->y[next] > pg->y[idx] )
+    {
+      if ( edge_cnt >= U8G2_POLYGON_MAX_POINTS )
+	break;
+      pg_edge_init(pg->edge+edge_cnt, pg->x[idx], pg->y[idx], pg->x[next], pg->y[next]);
+      edge_cnt++;
+    }
+    idx = next;
   }
+  return edge_cnt;
 }
 
-static uint8_t pg_prepare(pg_struct *pg)
+static void pg_prepare(u8g2_polygon_t *pg)
 {
-  pg_word_t max_y;
-  pg_word_t min_y;
-  uint8_t i;
-
-  /* setup the next index procedures */
-  pg->pge[PG_RIGHT].next_idx_fn = pg_inc;
-  pg->pge[PG_LEFT].next_idx_fn = pg_dec;
+  int16_t max_y;
+  int16_t min_y;
+  uint8_t i, left, right;
+
+  pg->is_prepared = 1;
+  pg->edge_end[PG_LEFT] = 0;
+  pg->edge_end[PG_RIGHT] = 0;
+  if ( pg->cnt == 0 )
+    return;
   
   /* search for highest and lowest point */
-  max_y = pg->list[0].y;
-  min_y = pg->list[0].y;
-  pg->pge[PG_LEFT].curr_idx = 0;
+  max_y = pg->y[0];
+  min_y = pg->y[0];
+  left = 0;
   for( i = 1; i < pg->cnt; i++ )
   {
-    if ( max_y < pg->list[i].y )
+    if ( max_y < pg->y[i] )
     {
-      max_y = pg->list[i].y;
+      max_y = pg->y[i];
     }
-    if ( min_y > pg->list[i].y )
+    if ( min_y > pg->y[i] )
     {
-      pg->pge[PG_LEFT].curr_idx = i;
-      min_y = pg->list[i].y;
+      left = i;
+      min_y = pg->y[i];
     }
   }
-
-  /* calculate total number of scan lines */
-  pg->total_scan_line_cnt = max_y;
-  pg->total_scan_line_cnt -= min_y;
   
   /* exit if polygon height is zero */
-  if ( pg->total_scan_line_cnt == 0 )
-    return 0;
-  
-  /* if the minimum y side is flat, try to find the lowest and highest x points */
-  pg->pge[PG_RIGHT].curr_idx = pg->pge[PG_LEFT].curr_idx;  
-  pg_expand_min_y(pg, min_y, PG_RIGHT);
-  pg_expand_min_y(pg, min_y, PG_LEFT);
+  if ( max_y == min_y )
+    return;
   
-  /* check if the min side is really flat (depends on the x values) */
-  pg->is_min_y_not_flat = 1;
-  if ( pg->list[pg->pge[PG_LEFT].curr_idx].x != pg->list[pg->pge[PG_RIGHT].curr_idx].x )
+  /* if the minimum y side is flat, find the lowest and highest x points */
+  right = left;
+  for(;;)
   {
-    pg->is_min_y_not_flat = 0;
+    i = pg_next_idx(pg, right, PG_RIGHT);
+    if ( pg->y[i] != min_y )
+      break;
+    right = i;
   }
-  else
+  for(;;)
   {
-    pg->total_scan_line_cnt--;
-    if ( pg->total_scan_line_cnt == 0 )
-      return 0;
+    i = pg_next_idx(pg, left, PG_LEFT);
+    if ( pg->y[i] != min_y )
+      break;
+    left = i;
   }
+  
+  /* the first line is skipped if the min y side is a single point, the last line is never drawn */
+  pg->y_first = min_y;
+  if ( pg->x[left] == pg->x[right] )
+    pg->y_first++;
+  pg->y_last = max_y - 1;
+  pg->next_y = pg->y_first - 1;
+  
+  pg->edge_end[PG_LEFT] = pg_add_side(pg, left, PG_LEFT, 0);
+  pg->edge_end[PG_RIGHT] = pg_add_side(pg, right, PG_RIGHT, pg->edge_end[PG_LEFT]);
+}
+
+/*===========================================*/
+/* scan line position of the left and right side */
 
-  return 1;
+/* calculate the x position of line y on one side directly from the edge table */
+static void pg_side_seek(u8g2_polygon_t *pg, uint8_t side, int16_t y)
+{
+  const u8g2_polygon_edge_t *edge;
+  uint8_t e, end;
+  int32_t k, t, n;
+  
+  e = 0;
+  if ( side == PG_RIGHT )
+    e = pg->edge_end[PG_LEFT];
+  end = pg->edge_end[side];
+  while( e+1 < end && pg->edge[e].y2 < y )
+    e++;
+  edge = pg->edge+e;
+  
+  /* k steps of pg_side_next(): the error overflows n times */
+  k = y - edge->y1;
+  t = edge->error_start + k * edge->error_offset;
+  n = 0;
+  if ( t > 0 )
+    n = (t + edge->height - 1) / edge->height;
+  
+  pg->curr_edge[side] = e;
+  pg->curr_x[side] = edge->x1 + k * edge->x_offset + n * edge->x_direction;
+  pg->curr_error[side] = t - n * edge->height;
 }
 
-static void pg_hline(pg_struct *pg, u8g2_t *u8g2)
+/* step one side to line y (the line after the current line) */
+static void pg_side_next(u8g2_polygon_t *pg, uint8_t side, int16_t y)
 {
-  pg_word_t x1, x2, y;
-  x1 = pg->pge[PG_LEFT].current_x;
-  x2 = pg->pge[PG_RIGHT].current_x;
-  y = pg->pge[PG_RIGHT].current_y;
+  const u8g2_polygon_edge_t *edge = pg->edge + pg->curr_edge[side];
+  
+  if ( y > edge->y2 && pg->curr_edge[side]+1 < pg->edge_end[side] )
+  {
+    /* continue with the next edge at its upper end */
+    pg->curr_edge[side]++;
+    edge++;
+    pg->curr_x[side] = edge->x1;
+    pg->curr_error[side] = edge->error_start;
+  }
   
+  pg->curr_x[side] += edge->x_offset;
+  pg->curr_error[side] += edge->error_offset;
+  if ( pg->curr_error[side] > 0 )
+  {
+    pg->curr_x[side] += edge->x_direction;
+    pg->curr_error[side] -= edge->height;
+  }
+}
+
+static void pg_hline(u8g2_t *u8g2, int16_t x1, int16_t x2, int16_t y)
+{
   if ( y < 0 )
     return;
   if ( y >= u8g2_GetDisplayHeight(u8g2) )  // does not work for 256x64 display???
@@ -244,95 +245,84 @@ static void pg_hline(pg_struct *pg, u8g2_t *u8g2)
   }
 }
 
-static void pg_line_init(pg_struct * const pg, uint8_t pge_index)
-{
-  struct pg_edge_struct  *pge = pg->pge+pge_index;
-  uint8_t idx;  
-  pg_word_t x1;
-  pg_word_t y1;
-  pg_word_t x2;
-  pg_word_t y2;
-
-  idx = pge->curr_idx;  
-  y1 = pg->list[idx].y;
-  x1 = pg->list[idx].x;
-  idx = pge->next_idx_fn(pg, idx);
-  y2 = pg->list[idx].y;
-  x2 = pg->list[idx].x; 
-  pge->curr_idx = idx;
-  
-  pge_Init(pge, x1, y1, x2, y2);
-}
-
-static void pg_exec(pg_struct *pg, u8g2_t *u8g2)
-{
-  pg_word_t i = pg->total_scan_line_cnt;
-
-  /* first line is skipped if the min y line is not flat */
-  pg_line_init(pg, PG_LEFT);		
-  pg_line_init(pg, PG_RIGHT);
-  
-  if ( pg->is_min_y_not_flat != 0 )
-  {
-    pge_Next(&(pg->pge[PG_LEFT])); 
-    pge_Next(&(pg->pge[PG_RIGHT]));
-  }
-
-  do
-  {
-    pg_hline(pg, u8g2);
-    while ( pge_Next(&(pg->pge[PG_LEFT])) == 0 )
-    {
-      pg_line_init(pg, PG_LEFT);
-    }
-    while ( pge_Next(&(pg->pge[PG_RIGHT])) == 0 )
-    {
-      pg_line_init(pg, PG_RIGHT);
-    }
-    i--;
-  } while( i > 0 );
-}
-
 /*===========================================*/
 /* API procedures */
 
-void pg_ClearPolygonXY(pg_struct *pg)
+void u8g2_ClearPolygon(u8g2_polygon_t *pg)
 {
   pg->cnt = 0;
+  pg->is_prepared = 0;
 }
 
-void pg_AddPolygonXY(pg_struct *pg, int16_t x, int16_t y)
+void u8g2_AddPolygonPoint(u8g2_polygon_t *pg, int16_t x, int16_t y)
 {
-  if ( pg->cnt < PG_MAX_POINTS )
+  if ( pg->cnt < U8G2_POLYGON_MAX_POINTS )
   {
-    pg->list[pg->cnt].x = x;
-    pg->list[pg->cnt].y = y;
+    pg->x[pg->cnt] = x;
+    pg->y[pg->cnt] = y;
     pg->cnt++;
+    pg->is_prepared = 0;
   }
 }
 
-void pg_DrawPolygon(pg_struct *pg, u8g2_t *u8g2)
+void u8g2_DrawStoredPolygon(u8g2_t *u8g2, u8g2_polygon_t *pg)
 {
-  if ( pg_prepare(pg) == 0 )
+  int16_t y, y_last;
+  
+  if ( pg->is_prepared == 0 )
+    pg_prepare(pg);
+  if ( pg->edge_end[PG_LEFT] == 0 || pg->edge_end[PG_RIGHT] == pg->edge_end[PG_LEFT] )
+    return;
+  
+  y = pg->y_first;
+  y_last = pg->y_last;
+#ifdef U8G2_WITH_INTERSECTION
+  /* lines outside the user window (the current page) are not visited */
+  if ( y < (int16_t)u8g2->user_y0 )
+    y = u8g2->user_y0;
+  if ( y_last >= (int16_t)u8g2->user_y1 )
+    y_last = (int16_t)u8g2->user_y1 - 1;
+#endif /* U8G2_WITH_INTERSECTION */
+  if ( y > y_last )
     return;
-  pg_exec(pg, u8g2);
+  
+  /* continue with the position of the previous page or search the start in the edge table */
+  if ( y != pg->next_y )
+  {
+    pg_side_seek(pg, PG_LEFT, y);
+    pg_side_seek(pg, PG_RIGHT, y);
+  }
+  
+  for(;;)
+  {
+    pg_hline(u8g2, pg->curr_x[PG_LEFT], pg->curr_x[PG_RIGHT], y);
+    y++;
+    pg_side_next(pg, PG_LEFT, y);
+    pg_side_next(pg, PG_RIGHT, y);
+    if ( y > y_last )
+      break;
+  }
+  pg->next_y = y;
 }
 
-pg_struct u8g2_pg;
+/*===========================================*/
+/* single polygon */
+
+static u8g2_polygon_t u8g2_pg;
 
 void u8g2_ClearPolygonXY(void)
 {
-  pg_ClearPolygonXY(&u8g2_pg);
+  u8g2_ClearPolygon(&u8g2_pg);
 }
 
 void u8g2_AddPolygonXY(U8X8_UNUSED u8g2_t *u8g2, int16_t x, int16_t y)
 {
-  pg_AddPolygonXY(&u8g2_pg, x, y);
+  u8g2_AddPolygonPoint(&u8g2_pg, x, y);
 }
 
 void u8g2_DrawPolygon(u8g2_t *u8g2)
 {
-  pg_DrawPolygon(&u8g2_pg, u8g2);
+  u8g2_DrawStoredPolygon(u8g2, &u8g2_pg);
 }
 
 void u8g2_DrawTriangle(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2)
@@ -53,12 +53,30 @@ void u8g2_DrawUTF8Line(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w
 {
   u8g2_uint_t d, str_width;
   u8g2_uint_t fx, fy, fw, fh;
+  int16_t above, below, vref;
 
   /* only horizontal strings are supported, so force this here */
   u8g2_SetFontDirection(u8g2, 0);
+  u8g2_SetDrawColor(u8g2, 1);
 
   /* revert y position back to baseline ref */
-  y += u8g2->font_calc_vref(u8g2);   
+  vref = (int8_t)u8g2->font_calc_vref(u8g2);
+  y += vref;   
+
+  /* 
+    rows above and below y with the frame and the font bounding box of 
+    the text: u8g2_DrawUTF8() below adds vref to y a second time 
+  */
+  above = u8g2_GetAscent(u8g2) + border_size;
+  if ( above < u8g2->font_info.max_char_height + u8g2->font_info.y_offset - vref )
+    above = u8g2->font_info.max_char_height + u8g2->font_info.y_offset - vref;
+  below = border_size - u8g2_GetDescent(u8g2);
+  if ( below < vref - u8g2->font_info.y_offset )
+    below = vref - u8g2->font_info.y_offset;
+  
+  /* skip the width calculation on pages without this line */
+  if ( u8g2_BeginGroup(u8g2, 0, y - above, u8g2_GetDisplayWidth(u8g2), above + below) == 0 )
+    return;
 
   /* calculate the width of the string in pixel */
   str_width = u8g2_GetUTF8Width(u8g2, s);
@@ -83,7 +101,6 @@ void u8g2_DrawUTF8Line(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w
   fh = u8g2_GetAscent(u8g2) - u8g2_GetDescent(u8g2) ;
 
   /* draw the box, if inverted */
-  u8g2_SetDrawColor(u8g2, 1);
   if ( is_invert )
   {
     u8g2_DrawBox(u8g2, fx, fy, fw, fh);
@@ -114,7 +131,8 @@ void u8g2_DrawUTF8Line(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w
 
   /* revert draw color */
   u8g2_SetDrawColor(u8g2, 1);
-
+  
+  u8g2_EndGroup(u8g2);
 }
 
 
@@ -189,96 +207,199 @@ void u8g2_DrawSelectionList(u8g2_t *u8g2, u8sl_t *u8sl, u8g2_uint_t y, const cha
 }
 
 
+/* 
+  clear h rows for a list line or button line with baseline y, starting with the border above the text
+  the top row is limited to the upper display border
+*/
+static void u8g2_clear_text_line(u8g2_t *u8g2, u8g2_uint_t y, u8g2_uint_t h)
+{
+  u8g2_uint_t top = u8g2_GetAscent(u8g2) + MY_BORDER_SIZE;
+  
+  if ( y > top )
+  {
+    top = y - top;
+  }
+  else
+  {
+    h -= top - y;
+    top = 0;
+  }
+  u8g2_SetDrawColor(u8g2, 0);
+  u8g2_DrawBox(u8g2, 0, top, u8g2_GetDisplayWidth(u8g2), h);
+  u8g2_SetDrawColor(u8g2, 1);
+}
+
 /*
   title: 		NULL for no title, valid str for title line. Can contain mutliple lines, separated by '\n'
   start_pos: 	default position for the cursor, first line is 1.
   sl:			string list (list of strings separated by \n)
-  returns 0 if user has pressed the home key
-  returns the selected line if user has pressed the select key
   side effects:
-    u8g2_SetFontDirection(u8g2, 0);
     u8g2_SetFontPosBaseline(u8g2);
-	
 */
-uint8_t u8g2_UserInterfaceSelectionList(u8g2_t *u8g2, const char *title, uint8_t start_pos, const char *sl)
+void u8g2_UserInterfaceSelectionListStart(u8g2_t *u8g2, u8g2_ui_selection_list_t *ui, const char *title, uint8_t start_pos, const char *sl)
 {
-  u8sl_t u8sl;
-  u8g2_uint_t yy;
-
-  uint8_t event;
-
   u8g2_uint_t line_height = u8g2_GetAscent(u8g2) - u8g2_GetDescent(u8g2)+MY_BORDER_SIZE;
-
-  uint8_t title_lines = u8x8_GetStringLineCnt(title);
   uint8_t display_lines;
 
+  ui->title = title;
+  ui->sl = sl;
+  ui->title_lines = u8x8_GetStringLineCnt(title);
+  ui->drawn_pos = 255;
+  ui->is_done = 0;
+  ui->result = 0;
   
   if ( start_pos > 0 )	/* issue 112 */
     start_pos--;		/* issue 112 */
 
-
-  if ( title_lines > 0 )
+  if ( ui->title_lines > 0 )
   {
 	display_lines = (u8g2_GetDisplayHeight(u8g2)-3) / line_height;
-	u8sl.visible = display_lines;
-	u8sl.visible -= title_lines;
+	ui->u8sl.visible = display_lines;
+	ui->u8sl.visible -= ui->title_lines;
   }
   else
   {
 	display_lines = u8g2_GetDisplayHeight(u8g2) / line_height;
-	u8sl.visible = display_lines;
+	ui->u8sl.visible = display_lines;
+  }
+
+  ui->u8sl.total = u8x8_GetStringLineCnt(sl);
+  ui->u8sl.first_pos = 0;
+  ui->u8sl.current_pos = start_pos;
+
+  if ( ui->u8sl.current_pos >= ui->u8sl.total )
+    ui->u8sl.current_pos = ui->u8sl.total-1;
+  if ( ui->u8sl.first_pos+ui->u8sl.visible <= ui->u8sl.current_pos )
+    ui->u8sl.first_pos = ui->u8sl.current_pos-ui->u8sl.visible+1;
+
+  u8g2_SetFontPosBaseline(u8g2);
+  
+  /* the list starts below the title and the separator line */
+  ui->list_y = u8g2_GetAscent(u8g2);
+  if ( ui->title_lines > 0 )
+  {
+    ui->list_y += ui->title_lines * line_height;
+    ui->list_y += 3;
+  }
+}
+
+/* returns 1 if the event has changed the list */
+uint8_t u8g2_UserInterfaceSelectionListEvent(U8X8_UNUSED u8g2_t *u8g2, u8g2_ui_selection_list_t *ui, uint8_t event)
+{
+  if ( ui->is_done )
+    return 0;
+  if ( event == U8X8_MSG_GPIO_MENU_SELECT )
+  {
+    ui->result = ui->u8sl.current_pos+1;		/* +1, issue 112 */
+    ui->is_done = 1;
   }
+  else if ( event == U8X8_MSG_GPIO_MENU_HOME )
+  {
+    ui->result = 0;				/* issue 112: return 0 instead of start_pos */
+    ui->is_done = 1;
+  }
+  else if ( event == U8X8_MSG_GPIO_MENU_NEXT || event == U8X8_MSG_GPIO_MENU_DOWN )
+    u8sl_Next(&(ui->u8sl));
+  else if ( event == U8X8_MSG_GPIO_MENU_PREV || event == U8X8_MSG_GPIO_MENU_UP )
+    u8sl_Prev(&(ui->u8sl));
+  else
+    return 0;
+  return 1;
+}
 
-  u8sl.total = u8x8_GetStringLineCnt(sl);
-  u8sl.first_pos = 0;
-  u8sl.current_pos = start_pos;
+void u8g2_DrawUserInterfaceSelectionList(u8g2_t *u8g2, u8g2_ui_selection_list_t *ui)
+{
+  u8g2_uint_t yy;
+  u8g2_uint_t line_height = u8g2_GetAscent(u8g2) - u8g2_GetDescent(u8g2)+MY_BORDER_SIZE;
 
-  if ( u8sl.current_pos >= u8sl.total )
-    u8sl.current_pos = u8sl.total-1;
-  if ( u8sl.first_pos+u8sl.visible <= u8sl.current_pos )
-    u8sl.first_pos = u8sl.current_pos-u8sl.visible+1;
+  u8g2_SetFontPosBaseline(u8g2);
+  if ( ui->title_lines > 0 )
+  {
+    yy = u8g2_GetAscent(u8g2);
+    yy += u8g2_DrawUTF8Lines(u8g2, 0, yy, u8g2_GetDisplayWidth(u8g2), line_height, ui->title);
+    u8g2_DrawHLine(u8g2, 0, yy-line_height- u8g2_GetDescent(u8g2) + 1, u8g2_GetDisplayWidth(u8g2));
+  }
+  u8g2_DrawSelectionList(u8g2, &(ui->u8sl), ui->list_y, ui->sl);
+  ui->drawn_pos = ui->u8sl.current_pos;
+  ui->drawn_first = ui->u8sl.first_pos;
+}
 
+/* clear and draw line idx of the list, idx must be visible */
+static void u8g2_update_selection_list_line(u8g2_t *u8g2, u8g2_ui_selection_list_t *ui, uint8_t idx)
+{
+  u8g2_uint_t line_height = u8g2_GetAscent(u8g2) - u8g2_GetDescent(u8g2)+MY_BORDER_SIZE;
+  u8g2_uint_t y = idx - ui->u8sl.first_pos;
+  
+  y *= line_height;
+  y += ui->list_y;
+  u8g2_clear_text_line(u8g2, y, line_height+MY_BORDER_SIZE);
+  u8g2_draw_selection_list_line(u8g2, &(ui->u8sl), y, idx, ui->sl);
+}
+
+/* full buffer only: redraw the changed lines, returns 0 if nothing has changed */
+uint8_t u8g2_UpdateUserInterfaceSelectionList(u8g2_t *u8g2, u8g2_ui_selection_list_t *ui)
+{
   u8g2_SetFontPosBaseline(u8g2);
+  if ( ui->drawn_pos == 255 )
+  {
+    /* first output */
+    u8g2_ClearBuffer(u8g2);
+    u8g2_DrawUserInterfaceSelectionList(u8g2, ui);
+  }
+  else if ( ui->drawn_first != ui->u8sl.first_pos )
+  {
+    /* scrolled: all visible lines have changed */
+    u8g2_clear_text_line(u8g2, ui->list_y, u8g2_GetDisplayHeight(u8g2));
+    u8g2_DrawSelectionList(u8g2, &(ui->u8sl), ui->list_y, ui->sl);
+  }
+  else if ( ui->drawn_pos != ui->u8sl.current_pos )
+  {
+    /* cursor moved: previous and new cursor line */
+    u8g2_update_selection_list_line(u8g2, ui, ui->drawn_pos);
+    u8g2_update_selection_list_line(u8g2, ui, ui->u8sl.current_pos);
+  }
+  else
+  {
+    return 0;
+  }
+  ui->drawn_pos = ui->u8sl.current_pos;
+  ui->drawn_first = ui->u8sl.first_pos;
+  return 1;
+}
+
+/*
+  title: 		NULL for no title, valid str for title line. Can contain mutliple lines, separated by '\n'
+  start_pos: 	default position for the cursor, first line is 1.
+  sl:			string list (list of strings separated by \n)
+  returns 0 if user has pressed the home key
+  returns the selected line if user has pressed the select key
+  side effects:
+    u8g2_SetFontDirection(u8g2, 0);
+    u8g2_SetFontPosBaseline(u8g2);
+	
+*/
+uint8_t u8g2_UserInterfaceSelectionList(u8g2_t *u8g2, const char *title, uint8_t start_pos, const char *sl)
+{
+  u8g2_ui_selection_list_t ui;
+
+  u8g2_UserInterfaceSelectionListStart(u8g2, &ui, title, start_pos, sl);
   
   for(;;)
   {
       u8g2_FirstPage(u8g2);
       do
       {
-        yy = u8g2_GetAscent(u8g2);
-        if ( title_lines > 0 )
-        {
-          yy += u8g2_DrawUTF8Lines(u8g2, 0, yy, u8g2_GetDisplayWidth(u8g2), line_height, title);
-		
-	  u8g2_DrawHLine(u8g2, 0, yy-line_height- u8g2_GetDescent(u8g2) + 1, u8g2_GetDisplayWidth(u8g2));
-		
-	  yy += 3;
-        }
-        u8g2_DrawSelectionList(u8g2, &u8sl, yy, sl);
+        u8g2_DrawUserInterfaceSelectionList(u8g2, &ui);
       } while( u8g2_NextPage(u8g2) );
       
 #ifdef U8G2_REF_MAN_PIC
       return 0;
 #endif
 
-
-      for(;;)
-      {
-        event = u8x8_GetMenuEvent(u8g2_GetU8x8(u8g2));
-        if ( event == U8X8_MSG_GPIO_MENU_SELECT )
-          return u8sl.current_pos+1;		/* +1, issue 112 */
-        else if ( event == U8X8_MSG_GPIO_MENU_HOME )
-          return 0;				/* issue 112: return 0 instead of start_pos */
-        else if ( event == U8X8_MSG_GPIO_MENU_NEXT || event == U8X8_MSG_GPIO_MENU_DOWN )
-        {
-          u8sl_Next(&u8sl);
-          break;
-        }
-        else if ( event == U8X8_MSG_GPIO_MENU_PREV || event == U8X8_MSG_GPIO_MENU_UP )
-        {
-          u8sl_Prev(&u8sl);
-          break;
-        }
-      }
+      /* wait for an event which changes the list */
+      while( u8g2_UserInterfaceSelectionListEvent(u8g2, &ui, u8x8_GetMenuEvent(u8g2_GetU8x8(u8g2))) == 0 )
+        ;
+      if ( u8g2_IsUserInterfaceDone(&ui) )
+        return u8g2_GetUserInterfaceResult(&ui);
   }
 }
@@ -56,6 +56,11 @@ void u8g2_SetupBuffer(u8g2_t *u8g2, uint8_t *buf, uint8_t tile_buf_height, u8g2_
   u8g2->tile_curr_row = 0;
   u8g2->draw_color = 1;
   u8g2->is_auto_page_clear = 1;
+  u8g2->render_cb = NULL;
+#ifdef U8G2_WITH_FRONT_BUFFER
+  u8g2->front_buf_ptr = NULL;
+  u8g2->is_swap_pending = 0;
+#endif /* U8G2_WITH_FRONT_BUFFER */
   
   u8g2->cb = u8g2_cb;
   u8g2->cb->update(u8g2);
@@ -65,6 +70,31 @@ void u8g2_SetupBuffer(u8g2_t *u8g2, uint8_t *buf, uint8_t tile_buf_height, u8g2_
 #ifdef U8G2_WITH_FONT_ROTATION  
   u8g2->font_decode.dir = 0;
 #endif
+
+#ifdef U8G2_WITH_GLYPH_CACHE
+  u8g2->glyph_cache.buf = NULL;
+#endif /* U8G2_WITH_GLYPH_CACHE */
+
+#ifdef U8G2_WITH_GLYPH_INDEX
+  u8g2->glyph_index.buf = NULL;
+  u8g2->glyph_index.font = NULL;
+#endif /* U8G2_WITH_GLYPH_INDEX */
+
+#ifdef U8G2_WITH_KERNING_INDEX
+  u8g2->kerning_index.buf = NULL;
+  u8g2->kerning_index.table = NULL;
+#endif /* U8G2_WITH_KERNING_INDEX */
+
+#ifdef U8G2_WITH_STR_WIDTH_CACHE
+  u8g2->str_width_cache.buf = NULL;
+#endif /* U8G2_WITH_STR_WIDTH_CACHE */
+
+#ifdef U8G2_WITH_DISPLAY_LIST
+  u8g2->display_list.buf = NULL;
+  u8g2->display_list.used = 0;
+  u8g2->display_list.is_recording = 0;
+  u8g2->display_list.is_valid = 0;
+#endif /* U8G2_WITH_DISPLAY_LIST */
 }
 
 /*
@@ -207,13 +237,16 @@ void u8g2_draw_l90_mirrorr_r0(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_u
   u8g2_uint_t xx;
   xx = u8g2->width;
   xx -= x;
-  if ( (dir & 1) == 0 )
+  if ( dir == 0 )
   {
     xx -= len;
   }
   else
   {
     xx--;
+    /* a line to the left (dir 2) starts at the mirrored x and goes to the right */
+    if ( dir == 2 )
+      dir = 0;
   }
   u8g2_draw_hv_line_4dir(u8g2, xx, y, len, dir);
 }
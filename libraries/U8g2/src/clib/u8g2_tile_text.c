@@ -0,0 +1,270 @@
+/*
+
+  u8g2_tile_text.c
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2026, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification,
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list
+    of conditions and the following disclaimer.
+
+  * Redistributions in binary form must reproduce the above copyright notice, this
+    list of conditions and the following disclaimer in the documentation and/or other
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+  Tile text: u8x8 font glyphs (8x8 or 16x16 pixel) at tile positions,
+  written into the u8g2 buffer and sent to the display immediately.
+  There is no font decoding and no transfer of complete tile rows, so this
+  is the fast path for numbers which change often, the rest of the screen
+  is drawn with the usual u8g2 procedures.
+
+  The glyphs are also stored in the front buffer (u8g2_SetFrontBuffer()),
+  so a later transfer of the same tile row sends the same content.
+
+  ST7920 (horizontal buffer): The graphics RAM is written in 16 bit words,
+  so each transfer starts and ends at an even tile. All glyphs of a tile
+  row are sent with one u8x8_DrawTile(), two neighbour 8x8 glyphs share
+  one word, a 16x16 glyph is one word. The other half of a word at the
+  start or the end is taken from the buffer.
+
+*/
+
+#include "u8g2.h"
+#include <string.h>
+
+/* tiles per u8x8_DrawTile() for the horizontal buffer, one ST7920 row of 128 pixel */
+#define U8G2_TILE_TEXT_BLOCK_TILES 16
+
+static uint8_t u8g2_tile_text_is_horizontal(u8g2_t *u8g2)
+{
+  return u8g2->ll_hvline == u8g2_ll_hvline_horizontal_right_lsb;
+}
+
+/* first byte of the tile row in the tile buffer, NULL if the tile row is not in the current buffer */
+static uint8_t *u8g2_tile_text_row(u8g2_t *u8g2, uint8_t ty)
+{
+  uint16_t offset;
+
+  if ( ty < u8g2->tile_curr_row || ty >= u8g2->tile_curr_row + u8g2->tile_buf_height )
+    return NULL;
+  offset = ty - u8g2->tile_curr_row;
+  offset *= u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  offset *= 8;
+  return u8g2->tile_buf_ptr + offset;
+}
+
+/*
+  8x8 bit matrix transpose (Hacker's Delight, transpose8): u8x8 tile with 
+  one byte per column (lsb on top) to one byte per pixel row (msb left)
+*/
+static void u8g2_tile_text_transpose(const uint8_t *tile, uint8_t *rows)
+{
+  uint32_t x, y, t;
+  
+  x = ((uint32_t)tile[0] << 24) | ((uint32_t)tile[1] << 16) | ((uint32_t)tile[2] << 8) | tile[3];
+  y = ((uint32_t)tile[4] << 24) | ((uint32_t)tile[5] << 16) | ((uint32_t)tile[6] << 8) | tile[7];
+  
+  t = (x ^ (x >> 7)) & 0x00AA00AAUL;  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00AA00AAUL;  y = y ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCCUL;  x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000CCCCUL;  y = y ^ t ^ (t << 14);
+  t = (x & 0xF0F0F0F0UL) | ((y >> 4) & 0x0F0F0F0FUL);
+  y = ((x << 4) & 0xF0F0F0F0UL) | (y & 0x0F0F0F0FUL);
+  x = t;
+  
+  /* the lsb of a column is the top row */
+  rows[0] = y; rows[1] = y >> 8; rows[2] = y >> 16; rows[3] = y >> 24;
+  rows[4] = x; rows[5] = x >> 8; rows[6] = x >> 16; rows[7] = x >> 24;
+}
+
+/* store the glyph (size 1: 8x8, size 2: 16x16 pixel) at tile column tx, row is the first byte of the tile row */
+static void u8g2_tile_text_put(u8g2_t *u8g2, uint8_t *row, uint8_t tx, uint8_t size, const uint8_t *tile)
+{
+  uint8_t tile_width = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  uint8_t buf[16];
+  uint8_t *dest;
+  uint8_t i;
+  uint16_t t;
+
+  if ( u8g2_tile_text_is_horizontal(u8g2) )
+  {
+    /* one byte per pixel row, msb is the left pixel */
+    u8g2_tile_text_transpose(tile, buf);
+    dest = row + tx;
+    for( i = 0; i < 8; i++ )
+    {
+      if ( size == 1 )
+      {
+	*dest = buf[i];
+	dest += tile_width;
+      }
+      else
+      {
+	t = u8x8_upscale_byte(buf[i]);
+	dest[0] = t >> 8;
+	dest[1] = t & 255;
+	dest += tile_width;
+	dest[0] = t >> 8;
+	dest[1] = t & 255;
+	dest += tile_width;
+      }
+    }
+  }
+  else
+  {
+    /* one byte per column of a tile, same scaling as u8x8_Draw2x2Glyph() */
+    dest = row + tx*8;
+    if ( size == 1 )
+    {
+      memcpy(dest, tile, 8);
+    }
+    else
+    {
+      for( i = 0; i < 8; i++ )
+      {
+	t = u8x8_upscale_byte(tile[i]);
+	dest[i*2] = t & 255;
+	dest[i*2+1] = t & 255;
+	buf[i*2] = t >> 8;
+	buf[i*2+1] = t >> 8;
+      }
+      memcpy(dest + tile_width*8, buf, 16);
+    }
+  }
+}
+
+static void u8g2_tile_text_store(u8g2_t *u8g2, uint8_t tx, uint8_t ty, uint8_t size, const uint8_t *tile)
+{
+#ifdef U8G2_WITH_FRONT_BUFFER
+  uint16_t offset;
+#endif /* U8G2_WITH_FRONT_BUFFER */
+
+  u8g2_tile_text_put(u8g2, u8g2_tile_text_row(u8g2, ty), tx, size, tile);
+#ifdef U8G2_WITH_FRONT_BUFFER
+  if ( u8g2->front_buf_ptr != NULL )
+  {
+    offset = ty;
+    offset *= u8g2_GetU8x8(u8g2)->display_info->tile_width;
+    offset *= 8;
+    u8g2_tile_text_put(u8g2, u8g2->front_buf_ptr + offset, tx, size, tile);
+  }
+#endif /* U8G2_WITH_FRONT_BUFFER */
+}
+
+/* send the tiles tx..tx+cnt-1 of a tile row to the display */
+static void u8g2_tile_text_send(u8g2_t *u8g2, uint8_t tx, uint8_t ty, uint8_t cnt)
+{
+  uint8_t block[U8G2_TILE_TEXT_BLOCK_TILES*8];
+  uint8_t tile_width = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  uint8_t *row;
+  uint8_t x0, x1, n, y;
+#ifdef U8G2_WITH_FRONT_BUFFER
+  uint16_t offset;
+
+  /* the front buffer has the content of the display, the tile buffer is only used without double buffer */
+  if ( u8g2->front_buf_ptr != NULL )
+  {
+    offset = ty;
+    offset *= tile_width;
+    offset *= 8;
+    row = u8g2->front_buf_ptr + offset;
+  }
+  else
+#endif /* U8G2_WITH_FRONT_BUFFER */
+  {
+    row = u8g2_tile_text_row(u8g2, ty);
+  }
+
+  if ( u8g2_tile_text_is_horizontal(u8g2) == 0 )
+  {
+    /* the tiles of a tile row are stored in sequence */
+    u8x8_DrawTile(u8g2_GetU8x8(u8g2), tx, ty, cnt, row + tx*8);
+    return;
+  }
+
+  /* complete 16 bit words, u8x8_DrawTile() expects cnt bytes for each of the 8 pixel rows */
+  x0 = tx & 0x0fe;
+  x1 = tx + cnt;
+  if ( x1 & 1 )
+    x1++;
+  while( x0 < x1 )
+  {
+    n = x1 - x0;
+    if ( n > U8G2_TILE_TEXT_BLOCK_TILES )
+      n = U8G2_TILE_TEXT_BLOCK_TILES;
+    for( y = 0; y < 8; y++ )
+      memcpy(block + y*n, row + y*tile_width + x0, n);
+    u8x8_DrawTile(u8g2_GetU8x8(u8g2), x0, ty, n, block);
+    x0 += n;
+  }
+}
+
+/* returns the number of glyphs which fit into the display */
+static uint8_t u8g2_tile_text_prepare(u8g2_t *u8g2, uint8_t tx, uint8_t ty, uint8_t size, const char *s)
+{
+  uint8_t tile_width = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  uint8_t cnt;
+  uint8_t i;
+
+  if ( u8g2->cb != U8G2_R0 || u8g2_GetU8x8(u8g2)->font == NULL )
+    return 0;
+  if ( u8g2_tile_text_is_horizontal(u8g2) == 0 && u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb )
+    return 0;
+  for( i = 0; i < size; i++ )
+    if ( u8g2_tile_text_row(u8g2, ty+i) == NULL )
+      return 0;
+  if ( tx >= tile_width )
+    return 0;
+
+  cnt = strlen(s);
+  if ( cnt > (tile_width - tx) / size )
+    cnt = (tile_width - tx) / size;
+  return cnt;
+}
+
+static uint8_t u8g2_draw_tile_string(u8g2_t *u8g2, uint8_t tx, uint8_t ty, uint8_t size, const char *s)
+{
+  uint8_t buf[8];
+  uint8_t cnt, i;
+
+  cnt = u8g2_tile_text_prepare(u8g2, tx, ty, size, s);
+  if ( cnt == 0 )
+    return 0;
+  for( i = 0; i < cnt; i++ )
+  {
+    u8x8_get_glyph_data(u8g2_GetU8x8(u8g2), (uint8_t)s[i], buf);
+    u8g2_tile_text_store(u8g2, tx+i*size, ty, size, buf);
+  }
+  for( i = 0; i < size; i++ )
+    u8g2_tile_text_send(u8g2, tx, ty+i, cnt*size);
+  return cnt;
+}
+
+uint8_t u8g2_DrawTileString(u8g2_t *u8g2, uint8_t tx, uint8_t ty, const char *s)
+{
+  return u8g2_draw_tile_string(u8g2, tx, ty, 1, s);
+}
+
+uint8_t u8g2_Draw2x2TileString(u8g2_t *u8g2, uint8_t tx, uint8_t ty, const char *s)
+{
+  return u8g2_draw_tile_string(u8g2, tx, ty, 2, s);
+}
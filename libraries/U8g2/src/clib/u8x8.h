@@ -94,6 +94,12 @@
 /* Define this for an additional user pointer inside the u8x8 data struct */
 //#define U8X8_WITH_USER_PTR
 
+/*
+  Count the calls to the GPIO and delay procedure in u8x8->gpio_cnt.
+  Internal performance test for the byte procedures, should not be defined for production code
+*/
+//#define U8X8_WITH_GPIO_COUNT
+
 
 /* Undefine this to remove u8x8_SetFlipMode function */
 /* 26 May 2016: Obsolete */
@@ -336,9 +342,15 @@ struct u8x8_struct
   uint8_t debounce_last_pin_state;
   uint8_t debounce_state;
   uint8_t debounce_result_msg;	/* result msg or event after debounce */
+  uint8_t init_state;		/* next step of u8x8_InitDisplayStep() */
+  uint8_t const *init_seq;	/* rest of the init sequence, NULL if not supported by the display */
+  uint8_t *display_shadow;	/* copy of the display RAM for dirty row tracking, NULL if not used, see u8x8_SetDisplayShadow() */
 #ifdef U8X8_WITH_USER_PTR
   void *user_ptr;
 #endif
+#ifdef U8X8_WITH_GPIO_COUNT
+  unsigned long gpio_cnt;
+#endif /* U8X8_WITH_GPIO_COUNT */
 #ifdef U8X8_USE_PINS 
   uint8_t pins[U8X8_PIN_CNT];	/* defines a pinlist: Mainly a list of pins for the Arduino Envionment, use U8X8_PIN_xxx to access */
 #endif
@@ -475,6 +487,21 @@ void u8x8_d_helper_display_init(u8x8_t *u8g2);
 */
 #define U8X8_MSG_DISPLAY_REFRESH 16
 
+/*
+  Name: 	U8X8_MSG_DISPLAY_GET_INIT_SEQUENCE
+  Args:	
+    arg_int: -
+    arg_ptr: pointer to "uint8_t const *"
+  
+  Optional message for u8x8_InitDisplayStep(). Only possible for displays
+  whose U8X8_MSG_DISPLAY_INIT is u8x8_d_helper_display_init() followed by
+  one u8x8_cad_SendSequence(): Store the address of the init sequence in
+  *arg_ptr, but do not call the helper and do not send the sequence, this
+  is done by u8x8_InitDisplayStep(). Return 0 if not supported, the 
+  display is then initialized with U8X8_MSG_DISPLAY_INIT.
+*/
+#define U8X8_MSG_DISPLAY_GET_INIT_SEQUENCE 17
+
 /*==========================================*/
 /* u8x8_setup.c */
 
@@ -507,6 +534,20 @@ void u8x8_SetupMemory(u8x8_t *u8x8);
   Usually this command must be followed by u8x8_SetPowerSave() 
 */
 void u8x8_InitDisplay(u8x8_t *u8x8);
+/*
+  Same as u8x8_InitDisplay(), but the delays of the reset and of the init 
+  sequence are not executed: u8x8_InitDisplayStep() returns at each delay
+  with the delay in milliseconds, the caller does other work and calls 
+  u8x8_InitDisplayStep() again after this time. A return value of 0 means
+  that the init is complete. 
+    u8x8_InitDisplayStart(u8x8);
+    while( (ms = u8x8_InitDisplayStep(u8x8)) != 0 )
+      delay(ms);
+  is the same as u8x8_InitDisplay(). 
+*/
+void u8x8_InitDisplayStart(u8x8_t *u8x8);
+uint8_t u8x8_InitDisplayStep(u8x8_t *u8x8);
+#define u8x8_IsInitDisplayPending(u8x8) ((u8x8)->init_state != 0)
 /* wake up display from power save mode */
 void u8x8_SetPowerSave(u8x8_t *u8x8, uint8_t is_enable);
 void u8x8_SetFlipMode(u8x8_t *u8x8, uint8_t mode);
@@ -583,6 +624,7 @@ uint8_t u8x8_cad_EndTransfer(u8x8_t *u8x8) U8X8_NOINLINE;
 #define U8X8_END()			(0xff)
 
 void u8x8_cad_SendSequence(u8x8_t *u8x8, uint8_t const *data);
+uint8_t const *u8x8_cad_SendSequencePart(u8x8_t *u8x8, uint8_t const *data, uint8_t *delay_ms);
 uint8_t u8x8_cad_empty(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8x8_cad_110(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8x8_cad_001(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
@@ -626,6 +668,20 @@ uint8_t u8x8_byte_ssd13xx_sw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, voi
 uint8_t u8x8_byte_sw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8x8_byte_sed1520(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 
+/* buffered byte procedure for DMA capable interfaces, see u8x8_byte.c */
+typedef struct u8x8_dma_struct u8x8_dma_t;
+struct u8x8_dma_struct
+{
+  uint8_t *buf[2];		/* one buffer is filled while the other one is transmitted */
+  uint16_t size;		/* size of each buffer */
+  void (*start)(const uint8_t *data, uint16_t cnt);	/* start the transmission of a buffer */
+  uint8_t (*is_busy)(void);	/* returns 0 once the last byte has been sent */
+  uint16_t len;			/* number of bytes in the buffer which is filled */
+  uint8_t fill;			/* index of the buffer which is filled */
+  uint8_t is_cs_active;		/* chip select is released with the next transfer */
+};
+uint8_t u8x8_byte_dma(u8x8_t *u8x8, u8x8_dma_t *dma, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
 
 /*==========================================*/
 /* GPIO Interface */
@@ -756,6 +812,13 @@ uint8_t u8x8_d_sh1106_128x64_noname(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
 uint8_t u8x8_d_sh1106_128x64_vcomh0(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8x8_d_st7920_192x32(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8x8_d_st7920_128x64(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+uint8_t u8x8_d_st7920_128x64_dirty(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+/*
+  Shadow buffer of u8x8_d_st7920_128x64_dirty() with U8X8_ST7920_128X64_SHADOW_SIZE 
+  bytes, one buffer for each display. NULL: all rows are transmitted.
+*/
+#define U8X8_ST7920_128X64_SHADOW_SIZE (8+1024)
+void u8x8_SetDisplayShadow(u8x8_t *u8x8, uint8_t *buf);
 uint8_t u8x8_d_ssd1306_128x32_univision(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8x8_d_ssd1306_64x48_er(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 uint8_t u8x8_d_ssd1306_64x32_noname(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
@@ -817,6 +880,9 @@ uint8_t u8x8_d_max7219_32x8(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 /* u8x8_8x8.c */
 
 uint16_t u8x8_upscale_byte(uint8_t x) U8X8_NOINLINE;
+uint32_t u8x8_upscale_byte_n(uint8_t x, uint8_t scale);
+/* 8 bytes of the glyph in the u8x8 font, also used by u8g2_DrawTileString() */
+void u8x8_get_glyph_data(u8x8_t *u8x8, uint8_t encoding, uint8_t *buf) U8X8_NOINLINE;
 
 
 void u8x8_utf8_init(u8x8_t *u8x8);
@@ -829,10 +895,14 @@ uint16_t u8x8_utf8_next(u8x8_t *u8x8, uint8_t b);
 void u8x8_SetFont(u8x8_t *u8x8, const uint8_t *font_8x8);
 void u8x8_DrawGlyph(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t encoding);
 void u8x8_Draw2x2Glyph(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t encoding);
+void u8x8_Draw3x3Glyph(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t encoding);
+void u8x8_Draw4x4Glyph(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t encoding);
 uint8_t u8x8_DrawString(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s);
 uint8_t u8x8_DrawUTF8(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s);	/* return number of glyps */
 uint8_t u8x8_Draw2x2String(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s);
 uint8_t u8x8_Draw2x2UTF8(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s);
+uint8_t u8x8_Draw3x3String(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s);
+uint8_t u8x8_Draw4x4String(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s);
 uint8_t u8x8_GetUTF8Len(u8x8_t *u8x8, const char *s);
 #define u8x8_SetInverseFont(u8x8, b) (u8x8)->is_font_inverse_mode = (b)
 
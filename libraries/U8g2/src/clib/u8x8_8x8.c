@@ -58,8 +58,7 @@ void u8x8_SetFont(u8x8_t *u8x8, const uint8_t *font_8x8)
    encoding: glyph for which the data is requested (must be between 0 and 255)
    buf: pointer to 8 bytes
 */
-static void u8x8_get_glyph_data(u8x8_t *u8x8, uint8_t encoding, uint8_t *buf) U8X8_NOINLINE;
-static void u8x8_get_glyph_data(u8x8_t *u8x8, uint8_t encoding, uint8_t *buf) 
+void u8x8_get_glyph_data(u8x8_t *u8x8, uint8_t encoding, uint8_t *buf) 
 {
   uint8_t first, last, i;
   uint16_t offset;
@@ -107,41 +106,75 @@ void u8x8_DrawGlyph(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t encoding)
 
 
 /*
-  Source: http://graphics.stanford.edu/~seander/bithacks.html
-	Section: Interleave bits by Binary Magic Numbers 
-   Original codes is here:
-		static const unsigned int B[] = {0x55555555, 0x33333333, 0x0F0F0F0F, 0x00FF00FF};
-		static const unsigned int S[] = {1, 2, 4, 8};
-
-		unsigned int x; // Interleave lower 16 bits of x and y, so the bits of x
-		unsigned int y; // are in the even positions and bits from y in the odd;
-		unsigned int z; // z gets the resulting 32-bit Morton Number.  
-				// x and y must initially be less than 65536.
-
-		x = (x | (x << S[3])) & B[3];
-		x = (x | (x << S[2])) & B[2];
-		x = (x | (x << S[1])) & B[1];
-		x = (x | (x << S[0])) & B[0];
-
-		y = (y | (y << S[3])) & B[3];
-		y = (y | (y << S[2])) & B[2];
-		y = (y | (y << S[1])) & B[1];
-		y = (y | (y << S[0])) & B[0];
-
-		z = x | (y << 1);
+  Upscale lookup tables: each bit of a nibble is repeated 2, 3 or 4 times,
+  bit 0 of the nibble becomes the lowest bits of the result. The lsb is 
+  the top pixel of a tile column and the left pixel of a XBM row, so the
+  same tables scale u8x8 tiles and u8g2 XBM bitmaps.
+  The 12 and 16 bit entries are stored as low and high byte.
+  One lookup replaces the shift and mask steps for each bit.
 */
+static const uint8_t u8x8_upscale_2x[16] U8X8_PROGMEM = 
+{
+  0x00, 0x03, 0x0c, 0x0f, 0x30, 0x33, 0x3c, 0x3f, 
+  0xc0, 0xc3, 0xcc, 0xcf, 0xf0, 0xf3, 0xfc, 0xff
+};
+
+static const uint8_t u8x8_upscale_3x[32] U8X8_PROGMEM = 
+{
+  0x00, 0x00, 0x07, 0x00, 0x38, 0x00, 0x3f, 0x00, 
+  0xc0, 0x01, 0xc7, 0x01, 0xf8, 0x01, 0xff, 0x01, 
+  0x00, 0x0e, 0x07, 0x0e, 0x38, 0x0e, 0x3f, 0x0e, 
+  0xc0, 0x0f, 0xc7, 0x0f, 0xf8, 0x0f, 0xff, 0x0f
+};
+
+static const uint8_t u8x8_upscale_4x[32] U8X8_PROGMEM = 
+{
+  0x00, 0x00, 0x0f, 0x00, 0xf0, 0x00, 0xff, 0x00, 
+  0x00, 0x0f, 0x0f, 0x0f, 0xf0, 0x0f, 0xff, 0x0f, 
+  0x00, 0xf0, 0x0f, 0xf0, 0xf0, 0xf0, 0xff, 0xf0, 
+  0x00, 0xff, 0x0f, 0xff, 0xf0, 0xff, 0xff, 0xff
+};
+
+static uint16_t u8x8_upscale_nibble16(const uint8_t *table, uint8_t nibble)
+{
+  uint16_t v;
+  table += nibble*2;
+  v = u8x8_pgm_read(table+1);
+  v <<= 8;
+  v |= u8x8_pgm_read(table);
+  return v;
+}
+
+/* each bit of x is doubled: bit 0 becomes bit 0 and 1 */
 uint16_t u8x8_upscale_byte(uint8_t x) 
 {
-	uint16_t y = x;
-	y |= (y << 4);		// x = (x | (x << S[2])) & B[2];
-	y &= 0x0f0f;
-	y |= (y << 2);		// x = (x | (x << S[1])) & B[1];
-	y &= 0x3333;
-	y |= (y << 1);		// x = (x | (x << S[0])) & B[0];
-	y &= 0x5555;
-  
-	y |= (y << 1);		// z = x | (y << 1);
-	return y;
+  uint16_t y;
+  y = u8x8_pgm_read(u8x8_upscale_2x + (x >> 4));
+  y <<= 8;
+  y |= u8x8_pgm_read(u8x8_upscale_2x + (x & 15));
+  return y;
+}
+
+/* each bit of x is repeated scale times (1..4) */
+uint32_t u8x8_upscale_byte_n(uint8_t x, uint8_t scale)
+{
+  uint32_t y;
+  switch( scale )
+  {
+    case 2:
+      return u8x8_upscale_byte(x);
+    case 3:
+      y = u8x8_upscale_nibble16(u8x8_upscale_3x, x >> 4);
+      y <<= 12;
+      y |= u8x8_upscale_nibble16(u8x8_upscale_3x, x & 15);
+      return y;
+    case 4:
+      y = u8x8_upscale_nibble16(u8x8_upscale_4x, x >> 4);
+      y <<= 16;
+      y |= u8x8_upscale_nibble16(u8x8_upscale_4x, x & 15);
+      return y;
+  }
+  return x;
 }
 
 static void u8x8_upscale_buf(uint8_t *src, uint8_t *dest) U8X8_NOINLINE;
@@ -183,6 +216,37 @@ void u8x8_Draw2x2Glyph(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t encoding)
   u8x8_DrawTile(u8x8, x+1, y+1, 1, buf);  
 }
 
+/* glyph with scale x scale tiles, each row of tiles is sent with one u8x8_DrawTile() */
+static void u8x8_draw_nxn_glyph(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t scale, uint8_t encoding) U8X8_NOINLINE;
+static void u8x8_draw_nxn_glyph(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t scale, uint8_t encoding)
+{
+  uint8_t buf[8];
+  uint32_t column[8];
+  uint8_t tiles[4*8];
+  uint8_t i, j;
+  
+  u8x8_get_glyph_data(u8x8, encoding, buf);
+  for( i = 0; i < 8; i++ )
+    column[i] = u8x8_upscale_byte_n(buf[i], scale);
+  for( j = 0; j < scale; j++ )
+  {
+    /* each column of the glyph is repeated scale times */
+    for( i = 0; i < scale*8; i++ )
+      tiles[i] = column[i/scale] >> (j*8);
+    u8x8_DrawTile(u8x8, x, y+j, scale, tiles);
+  }
+}
+
+void u8x8_Draw3x3Glyph(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t encoding)
+{
+  u8x8_draw_nxn_glyph(u8x8, x, y, 3, encoding);
+}
+
+void u8x8_Draw4x4Glyph(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t encoding)
+{
+  u8x8_draw_nxn_glyph(u8x8, x, y, 4, encoding);
+}
+
 
 /*
 source: https://en.wikipedia.org/wiki/UTF-8
@@ -343,6 +407,40 @@ uint8_t u8x8_Draw2x2UTF8(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s)
   return u8x8_draw_2x2_string(u8x8, x, y, s);
 }
 
+static uint8_t u8x8_draw_nxn_string(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t scale, const char *s) U8X8_NOINLINE;
+static uint8_t u8x8_draw_nxn_string(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t scale, const char *s)
+{
+  uint16_t e;
+  uint8_t cnt = 0;
+  u8x8_utf8_init(u8x8);
+  for(;;)
+  {
+    e = u8x8->next_cb(u8x8, (uint8_t)*s);
+    if ( e == 0x0ffff )
+      break;
+    s++;
+    if ( e != 0x0fffe )
+    {
+      u8x8_draw_nxn_glyph(u8x8, x, y, scale, e);
+      x+=scale;
+      cnt++;
+    }
+  }
+  return cnt;
+}
+
+uint8_t u8x8_Draw3x3String(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s)
+{
+  u8x8->next_cb = u8x8_ascii_next;
+  return u8x8_draw_nxn_string(u8x8, x, y, 3, s);
+}
+
+uint8_t u8x8_Draw4x4String(u8x8_t *u8x8, uint8_t x, uint8_t y, const char *s)
+{
+  u8x8->next_cb = u8x8_ascii_next;
+  return u8x8_draw_nxn_string(u8x8, x, y, 4, s);
+}
+
 
 
 uint8_t u8x8_GetUTF8Len(u8x8_t *u8x8, const char *s)
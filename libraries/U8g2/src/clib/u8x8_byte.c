@@ -35,6 +35,7 @@
 */
 
 #include "u8x8.h"
+#include <string.h>
 
 uint8_t u8x8_byte_SetDC(u8x8_t *u8x8, uint8_t dc)
 {
@@ -307,6 +308,94 @@ uint8_t u8x8_byte_3wire_sw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void
   return 1;
 }
 
+/*=========================================*/
+/*
+  Buffered byte procedure for interfaces with DMA.
+  The platform specific byte procedure forwards all messages to
+  u8x8_byte_dma(). Bytes are collected in one of two buffers, which is
+  handed over to dma->start() at END_TRANSFER or if it is full. The caller
+  can continue immediately and fills the other buffer meanwhile.
+  Chip select is released at the beginning of the next transfer, after
+  dma->is_busy() reports that the previous transmission has finished.
+*/
+
+static void u8x8_byte_dma_wait(u8x8_dma_t *dma)
+{
+  while( dma->is_busy() != 0 )
+    ;
+}
+
+static void u8x8_byte_dma_flush(u8x8_dma_t *dma)
+{
+  if ( dma->len == 0 )
+    return;
+  /* the other buffer is still transmitted */
+  u8x8_byte_dma_wait(dma);
+  dma->start(dma->buf[dma->fill], dma->len);
+  dma->fill ^= 1;
+  dma->len = 0;
+}
+
+static void u8x8_byte_dma_release_cs(u8x8_t *u8x8, u8x8_dma_t *dma)
+{
+  u8x8_byte_dma_wait(dma);
+  if ( dma->is_cs_active != 0 )
+  {
+    u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_NANO, u8x8->display_info->pre_chip_disable_wait_ns, NULL);
+    u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_disable_level);
+    dma->is_cs_active = 0;
+  }
+}
+
+uint8_t u8x8_byte_dma(u8x8_t *u8x8, u8x8_dma_t *dma, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  uint8_t *data;
+  uint16_t cnt;
+ 
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_SEND:
+      data = (uint8_t *)arg_ptr;
+      while( arg_int > 0 )
+      {
+	if ( dma->len >= dma->size )
+	  u8x8_byte_dma_flush(dma);
+	cnt = dma->size - dma->len;
+	if ( cnt > arg_int )
+	  cnt = arg_int;
+	memcpy(dma->buf[dma->fill] + dma->len, data, cnt);
+	dma->len += cnt;
+	data += cnt;
+	arg_int -= cnt;
+      }
+      break;
+    case U8X8_MSG_BYTE_INIT:
+      dma->len = 0;
+      dma->fill = 0;
+      dma->is_cs_active = 1;
+      u8x8_byte_dma_release_cs(u8x8, dma);
+      break;
+    case U8X8_MSG_BYTE_SET_DC:
+      /* all pending bytes belong to the previous DC level */
+      u8x8_byte_dma_flush(dma);
+      u8x8_byte_dma_wait(dma);
+      u8x8_gpio_SetDC(u8x8, arg_int);
+      break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      u8x8_byte_dma_release_cs(u8x8, dma);
+      u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_enable_level);  
+      u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_NANO, u8x8->display_info->post_chip_enable_wait_ns, NULL);
+      dma->is_cs_active = 1;
+      break;
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      u8x8_byte_dma_flush(dma);
+      break;
+    default:
+      return 0;
+  }
+  return 1;
+}
+
 /*=========================================*/
 
 void u8x8_byte_set_ks0108_cs(u8x8_t *u8x8, uint8_t arg)
@@ -130,7 +130,12 @@ uint8_t u8x8_cad_EndTransfer(u8x8_t *u8x8)
   255		end of sequence
 */
 
-void u8x8_cad_SendSequence(u8x8_t *u8x8, uint8_t const *data)
+/*
+  Send the sequence until the next delay or the end of the sequence.
+  Returns the position after the delay and stores the delay in *delay_ms,
+  returns NULL at the end of the sequence.
+*/
+uint8_t const *u8x8_cad_SendSequencePart(u8x8_t *u8x8, uint8_t const *data, uint8_t *delay_ms)
 {
   uint8_t cmd;
   uint8_t v;
@@ -157,16 +162,28 @@ void u8x8_cad_SendSequence(u8x8_t *u8x8, uint8_t const *data)
 	  u8x8->cad_cb(u8x8, cmd, 0, NULL);
 	  break;
       case 0x0fe:
-	  v = *data;
-	  u8x8_gpio_Delay(u8x8, U8X8_MSG_DELAY_MILLI, v);	    
+	  *delay_ms = *data;
 	  data++;
-	  break;
+	  return data;
       default:
-	return;
+	return NULL;
     }
   }
 }
 
+void u8x8_cad_SendSequence(u8x8_t *u8x8, uint8_t const *data)
+{
+  uint8_t delay_ms;
+
+  for(;;)
+  {
+    data = u8x8_cad_SendSequencePart(u8x8, data, &delay_ms);
+    if ( data == NULL )
+      return;
+    u8x8_gpio_Delay(u8x8, U8X8_MSG_DELAY_MILLI, delay_ms);
+  }
+}
+
 
 uint8_t u8x8_cad_empty(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
@@ -321,13 +338,74 @@ uint8_t u8x8_cad_011(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 
 /* cad procedure for the ST7920 in SPI mode */
 /* u8x8_byte_SetDC is not used */
+/* data bytes per u8x8_byte_SendBytes(), each data byte is sent as two bytes (high nibble first) */
+#define U8X8_ST7920_SPI_CHUNK 16
+
+/*
+  Each data byte b is sent as b & 0xf0 and b << 4. Outside of AVR, both bytes
+  are taken from a table in RAM (512 bytes) with one 16 bit access. The 
+  table is built by U8X8_MSG_CAD_INIT, the entries are stored in memory 
+  order, so the table does not depend on the byte order of the controller.
+*/
+#ifndef __AVR__
+#define U8X8_ST7920_EXPAND_TABLE
+#endif
+
+#ifdef U8X8_ST7920_EXPAND_TABLE
+
+static uint16_t u8x8_cad_st7920_table[256];
+
+static void u8x8_cad_st7920_init_table(void)
+{
+  uint16_t b;
+  uint8_t *e;
+  
+  if ( u8x8_cad_st7920_table[1] != 0 )
+    return;	/* already done */
+  for( b = 0; b < 256; b++ )
+  {
+    e = (uint8_t *)(u8x8_cad_st7920_table + b);
+    e[0] = b & 0x0f0;
+    e[1] = b << 4;
+  }
+}
+
+static uint16_t *u8x8_cad_st7920_expand(uint16_t *dest, const uint8_t *src, uint8_t cnt)
+{
+  while( cnt > 0 )
+  {
+    *dest++ = u8x8_cad_st7920_table[*src++];
+    cnt--;
+  }
+  return dest;
+}
+
+#else /* U8X8_ST7920_EXPAND_TABLE */
+
+static uint16_t *u8x8_cad_st7920_expand(uint16_t *dest, const uint8_t *src, uint8_t cnt)
+{
+  uint8_t *d = (uint8_t *)dest;
+  uint8_t b;
+  
+  while( cnt > 0 )
+  {
+    b = *src++;
+    d[0] = b & 0x0f0;
+    d[1] = b << 4;
+    d += 2;
+    cnt--;
+  }
+  return (uint16_t *)d;
+}
+
+#endif /* U8X8_ST7920_EXPAND_TABLE */
+
 uint8_t u8x8_cad_st7920_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
   uint8_t *data;
-  uint8_t b;
-  uint8_t i;
-  static uint8_t buf[16];
-  uint8_t *ptr;
+  uint8_t cnt;
+  static uint16_t buf[U8X8_ST7920_SPI_CHUNK];
+  uint16_t *ptr;
   
   switch(msg)
   {
@@ -345,43 +423,28 @@ uint8_t u8x8_cad_st7920_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
       u8x8_byte_SendByte(u8x8, arg_int << 4);
       break;
     case U8X8_MSG_CAD_SEND_DATA:
-    
       u8x8_byte_SendByte(u8x8, 0x0fa);
       u8x8_gpio_Delay(u8x8, U8X8_MSG_DELAY_NANO, 1);
-
-      /* this loop should be optimized: multiple bytes should be sent */
-      /* u8x8_byte_SendBytes(u8x8, arg_int, arg_ptr); */
-      data = (uint8_t *)arg_ptr;
-    
-      /* the following loop increases speed by 20% */
-      while( arg_int >= 8 )
-      {
-	i = 8;
-	ptr = buf;
-	do
-	{
-	  b = *data++;
-	  *ptr++= b & 0x0f0;
-	  b <<= 4;
-	  *ptr++= b;
-	  i--;
-	} while( i > 0 );
-	arg_int -= 8;
-	u8x8_byte_SendBytes(u8x8, 16, buf); 
-      }
       
-    
+      data = (uint8_t *)arg_ptr;
       while( arg_int > 0 )
       {
-	b = *data;
-	u8x8_byte_SendByte(u8x8, b & 0x0f0);
-	u8x8_byte_SendByte(u8x8, b << 4);
-	data++;
-	arg_int--;
+	cnt = arg_int;
+	if ( cnt > U8X8_ST7920_SPI_CHUNK )
+	  cnt = U8X8_ST7920_SPI_CHUNK;
+	ptr = u8x8_cad_st7920_expand(buf, data, cnt);
+	u8x8_byte_SendBytes(u8x8, (ptr-buf)*2, (uint8_t *)buf);
+	data += cnt;
+	arg_int -= cnt;
       }
+      
       u8x8_gpio_Delay(u8x8, U8X8_MSG_DELAY_NANO, 1);
       break;
     case U8X8_MSG_CAD_INIT:
+#ifdef U8X8_ST7920_EXPAND_TABLE
+      u8x8_cad_st7920_init_table();
+#endif
+      return u8x8->byte_cb(u8x8, msg, arg_int, arg_ptr);
     case U8X8_MSG_CAD_START_TRANSFER:
     case U8X8_MSG_CAD_END_TRANSFER:
       return u8x8->byte_cb(u8x8, msg, arg_int, arg_ptr);
@@ -38,6 +38,7 @@
   
 */
 #include "u8x8.h"
+#include <string.h>
 
 
 
@@ -91,6 +92,9 @@ uint8_t u8x8_d_st7920_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
       u8x8_d_helper_display_init(u8x8);
       u8x8_cad_SendSequence(u8x8, u8x8_d_st7920_init_seq);
       break;
+    case U8X8_MSG_DISPLAY_GET_INIT_SEQUENCE:
+      *(uint8_t const **)arg_ptr = u8x8_d_st7920_init_seq;
+      break;
     case U8X8_MSG_DISPLAY_SET_POWER_SAVE:
       if ( arg_int == 0 )
 	u8x8_cad_SendSequence(u8x8, u8x8_d_st7920_powersave0_seq);
@@ -148,6 +152,122 @@ uint8_t u8x8_d_st7920_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
   return 1;
 }
 
+/*
+  Dirty row tracking
+
+  The shadow buffer keeps a copy of the ST7920 graphics RAM. Each pixel row
+  of a tile row is compared against the shadow and only the changed 16 bit
+  words of a changed row are transmitted, together with the address commands
+  for that row. Rows which are still unknown after display init are always sent.
+  The shadow buffer is provided by the application with u8x8_SetDisplayShadow(),
+  one buffer for each display. Without shadow buffer, all rows are sent.
+  
+  Shadow buffer: one bit per pixel row (1: row is known), followed by the 
+  copy of the graphics RAM with tile_width bytes per pixel row.
+*/
+
+#define U8X8_ST7920_SHADOW_ROWS 64
+#define U8X8_ST7920_SHADOW_VALID (U8X8_ST7920_SHADOW_ROWS/8)
+
+void u8x8_SetDisplayShadow(u8x8_t *u8x8, uint8_t *buf)
+{
+  u8x8->display_shadow = buf;
+  /* content of the graphics RAM is unknown */
+  if ( buf != NULL )
+    memset(buf, 0, U8X8_ST7920_SHADOW_VALID);
+}
+
+static void u8x8_d_st7920_dirty_draw_tile(u8x8_t *u8x8, u8x8_tile_t *tile)
+{
+  uint8_t row, x, y, i, cnt;
+  uint8_t first, last;
+  uint8_t is_started = 0;
+  uint8_t *ptr;
+  uint8_t *valid;
+  uint8_t *shadow;
+  
+  cnt = tile->cnt;
+  ptr = tile->tile_ptr;
+  row = tile->y_pos;
+  row *= 8;
+  valid = u8x8->display_shadow;
+  for( i = 0; i < 8; i++ )
+  {
+    shadow = valid + U8X8_ST7920_SHADOW_VALID + (uint16_t)row * u8x8->display_info->tile_width + tile->x_pos;
+    
+    /* find the first and last changed byte of this row */
+    first = 0;
+    last = cnt;
+    if ( valid[row>>3] & (1<<(row&7)) )
+    {
+      while( first < cnt && ptr[first] == shadow[first] )
+	first++;
+      if ( first < cnt )
+	while( ptr[last-1] == shadow[last-1] )
+	  last--;
+    }
+    
+    if ( first < cnt )
+    {
+      /* the ST7920 is written in words (16 pixel), extend to the word boundaries within the tile row */
+      if ( ((tile->x_pos + first) & 1) != 0 && first > 0 )
+	first--;
+      if ( ((tile->x_pos + last) & 1) != 0 && last < cnt )
+	last++;
+      
+      if ( is_started == 0 )
+      {
+	u8x8_cad_StartTransfer(u8x8);
+	u8x8_cad_SendCmd(u8x8, 0x03e );	/* enable extended mode, see u8x8_d_st7920_common() */
+	is_started = 1;
+      }
+      
+      y = row;
+      x = tile->x_pos;
+      x += first;
+      x /= 2;
+      if ( y >= 32 )	/* this is the adjustment for 128x64 displays */
+      {
+	y-=32;
+	x+=8;
+      }
+      u8x8_cad_SendCmd(u8x8, 0x080 | y );      /* y pos  */
+      u8x8_cad_SendCmd(u8x8, 0x080 | x );      /* set x pos */
+      u8x8_cad_SendData(u8x8, last-first, ptr+first);
+      
+      memcpy(shadow+first, ptr+first, last-first);
+      valid[row>>3] |= 1<<(row&7);
+    }
+    
+    ptr += cnt;
+    row++;
+  }
+  
+  if ( is_started != 0 )
+    u8x8_cad_EndTransfer(u8x8);
+}
+
+static uint8_t u8x8_d_st7920_dirty(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  switch(msg)
+  {
+    case U8X8_MSG_DISPLAY_INIT:
+    case U8X8_MSG_DISPLAY_GET_INIT_SEQUENCE:
+      /* content of the graphics RAM is unknown after init */
+      if ( u8x8->display_shadow != NULL )
+	memset(u8x8->display_shadow, 0, U8X8_ST7920_SHADOW_VALID);
+      return u8x8_d_st7920_common(u8x8, msg, arg_int, arg_ptr);
+    case U8X8_MSG_DISPLAY_DRAW_TILE:
+      if ( u8x8->display_shadow == NULL )
+	return u8x8_d_st7920_common(u8x8, msg, arg_int, arg_ptr);
+      u8x8_d_st7920_dirty_draw_tile(u8x8, (u8x8_tile_t *)arg_ptr);
+      break;
+    default:
+      return u8x8_d_st7920_common(u8x8, msg, arg_int, arg_ptr);
+  }
+  return 1;
+}
+
 static const u8x8_display_info_t u8x8_st7920_192x32_display_info =
 {
   /* chip_enable_level = */ 1,
@@ -229,4 +349,18 @@ uint8_t u8x8_d_st7920_128x64(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *a
 
   
 
-  
\ No newline at end of file
+  
+
+/* same as u8x8_d_st7920_128x64, but only changed rows are transmitted */
+uint8_t u8x8_d_st7920_128x64_dirty(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  switch(msg)
+  {
+    case U8X8_MSG_DISPLAY_SETUP_MEMORY:
+      u8x8_d_helper_display_setup_memory(u8x8, &u8x8_st7920_128x64_display_info);
+      break;
+    default:
+      return u8x8_d_st7920_dirty(u8x8, msg, arg_int, arg_ptr);
+  }
+  return 1;
+}
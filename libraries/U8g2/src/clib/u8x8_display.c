@@ -100,6 +100,58 @@ void u8x8_InitDisplay(u8x8_t *u8x8)
   u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_INIT, 0, NULL);  
 }
 
+void u8x8_InitDisplayStart(u8x8_t *u8x8)
+{
+  u8x8->init_seq = NULL;
+  u8x8->init_state = 1;
+}
+
+/* same steps as U8X8_MSG_DISPLAY_INIT with u8x8_d_helper_display_init(), but returns at each delay */
+uint8_t u8x8_InitDisplayStep(u8x8_t *u8x8)
+{
+  uint8_t delay_ms = 0;
+  
+  while( delay_ms == 0 && u8x8->init_state != 0 )
+  {
+    switch( u8x8->init_state )
+    {
+      case 1:
+	if ( u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_GET_INIT_SEQUENCE, 0, (void *)&(u8x8->init_seq)) == 0 || u8x8->init_seq == NULL )
+	{
+	  /* not supported by the display */
+	  u8x8_InitDisplay(u8x8);
+	  u8x8->init_state = 0;
+	  break;
+	}
+	u8x8_gpio_Init(u8x8);
+	u8x8_cad_Init(u8x8);
+	u8x8_gpio_SetReset(u8x8, 1);
+	delay_ms = u8x8->display_info->reset_pulse_width_ms;
+	u8x8->init_state = 2;
+	break;
+      case 2:
+	u8x8_gpio_SetReset(u8x8, 0);
+	delay_ms = u8x8->display_info->reset_pulse_width_ms;
+	u8x8->init_state = 3;
+	break;
+      case 3:
+	u8x8_gpio_SetReset(u8x8, 1);
+	delay_ms = u8x8->display_info->post_reset_wait_ms;
+	u8x8->init_state = 4;
+	break;
+      default:
+	u8x8->init_seq = u8x8_cad_SendSequencePart(u8x8, u8x8->init_seq, &delay_ms);
+	if ( u8x8->init_seq == NULL )
+	{
+	  delay_ms = 0;
+	  u8x8->init_state = 0;
+	}
+	break;
+    }
+  }
+  return delay_ms;
+}
+
 void u8x8_SetPowerSave(u8x8_t *u8x8, uint8_t is_enable)
 {
   u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_SET_POWER_SAVE, is_enable, NULL);  
@@ -39,6 +39,9 @@
 
 void u8x8_gpio_call(u8x8_t *u8x8, uint8_t msg, uint8_t arg)
 {
+#ifdef U8X8_WITH_GPIO_COUNT
+  u8x8->gpio_cnt++;
+#endif /* U8X8_WITH_GPIO_COUNT */
   u8x8->gpio_and_delay_cb(u8x8, msg, arg, NULL);
 }
 
@@ -52,6 +52,7 @@ uint8_t u8x8_dummy_cb(U8X8_UNUSED u8x8_t *u8x8, U8X8_UNUSED uint8_t msg, U8X8_UN
 void u8x8_SetupDefaults(u8x8_t *u8x8)
 {
     u8x8->display_info = NULL;
+    u8x8->font = NULL;
     u8x8->display_cb = u8x8_dummy_cb;
     u8x8->cad_cb = u8x8_dummy_cb;
     u8x8->byte_cb = u8x8_dummy_cb;
@@ -61,6 +62,11 @@ void u8x8_SetupDefaults(u8x8_t *u8x8)
     u8x8->utf8_state = 0;		/* also reset by u8x8_utf8_init */
     u8x8->i2c_address = 255;
     u8x8->debounce_default_pin_state = 255;	/* assume all low active buttons */
+    u8x8->init_state = 0;
+    u8x8->display_shadow = NULL;
+#ifdef U8X8_WITH_GPIO_COUNT
+    u8x8->gpio_cnt = 0;
+#endif /* U8X8_WITH_GPIO_COUNT */
   
 #ifdef U8X8_USE_PINS 
   {